@@ -0,0 +1,58 @@
+/*
+ * Module to run all the program modules, so the main loop and host programs
+ * run them the same way.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "app.h"
+#include "peripherals/led.h"
+#include "calculator.h"
+#include "input.h"
+#include "output.h"
+#include "macro.h"
+#include "recorder.h"
+#include "profile.h"
+
+void App_Init(void)
+{
+	// Initialize the LED peripheral
+	LED_Init();
+	// Initialize the input module
+	Input_Init();
+	// Initialize the output module
+	Output_Init();
+	// Initialize the calculator module
+	Calculator_Init();
+	// Initialize the macro module
+	Macro_Init();
+	// Initialize the recorder module
+	Recorder_Init();
+}
+
+void App_Process(void)
+{
+	PROFILE_START(ProbeApp);
+	// Process inputs
+	PROFILE_START(ProbeInput);
+	Input_Process();
+	PROFILE_END(ProbeInput);
+	// Record the input sample for replaying on a PC
+	PROFILE_START(ProbeRecorder);
+	Recorder_Process();
+	PROFILE_END(ProbeRecorder);
+	// Record the inputs into a macro, or replay one
+	PROFILE_START(ProbeMacro);
+	Macro_Process();
+	PROFILE_END(ProbeMacro);
+	// Process the calculator
+	PROFILE_START(ProbeCalculator);
+	Calculator_Process();
+	PROFILE_END(ProbeCalculator);
+	// Process outputs
+	PROFILE_START(ProbeOutput);
+	Output_Process();
+	PROFILE_END(ProbeOutput);
+	PROFILE_END(ProbeApp);
+}
@@ -0,0 +1,18 @@
+/*
+ * Module to run all the program modules, so the main loop and host programs
+ * run them the same way.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+/**
+ * Function to initialize all the program modules. Call this once on reset.
+ */
+void App_Init(void);
+/**
+ * Function to process all the program modules. Call this in a loop, every 1 ms.
+ */
+void App_Process(void);
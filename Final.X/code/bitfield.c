@@ -0,0 +1,67 @@
+/*
+ * Module of bit-field layouts that split a word into named fields.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "bitfield.h"
+#include "bitops.h"
+
+// A field of bits hi down to lo, shown in a radix; the compiler works out the mask
+#define FIELD(hi, lo, base, name) {(uint32_t)(0xFFFFFFFF >> (31 - ((hi) - (lo)))), (lo), (base), name}
+
+static struct BitLayout const layouts[] = {
+	// a packet header: type, id, and length
+	{"pkt", 3, {FIELD(31, 28, 16, "typ"), FIELD(27, 16, 16, "id"), FIELD(15, 0, 10, "len")}},
+	// the bytes of a word
+	{"bytes", 4, {FIELD(31, 24, 16, "b3"), FIELD(23, 16, 16, "b2"), FIELD(15, 8, 16, "b1"), FIELD(7, 0, 16, "b0")}},
+	// an IPv4 address
+	{"ipv4", 4, {FIELD(31, 24, 10, "a"), FIELD(23, 16, 10, "b"), FIELD(15, 8, 10, "c"), FIELD(7, 0, 10, "d")}},
+	// a 16-bit color
+	{"rgb565", 3, {FIELD(15, 11, 10, "r"), FIELD(10, 5, 10, "g"), FIELD(4, 0, 10, "b")}},
+	// a MIPS register instruction, whose opcode is 0
+	{"mips r", 5, {FIELD(25, 21, 10, "rs"), FIELD(20, 16, 10, "rt"), FIELD(15, 11, 10, "rd"), FIELD(10, 6, 10, "sa"),
+		FIELD(5, 0, 16, "fn")}},
+	// a MIPS immediate instruction
+	{"mips i", 4, {FIELD(31, 26, 16, "op"), FIELD(25, 21, 10, "rs"), FIELD(20, 16, 10, "rt"), FIELD(15, 0, 16, "imm")}},
+	// a FAT directory entry date, years since 1980
+	{"date", 3, {FIELD(15, 9, 10, "y"), FIELD(8, 5, 10, "m"), FIELD(4, 0, 10, "d")}}
+};
+
+uint8_t Bitfield_GetLayoutCount(void)
+{
+	return sizeof(layouts) / sizeof(*layouts);
+}
+
+struct BitLayout const *Bitfield_GetLayout(uint8_t idx)
+{
+	return &layouts[idx];
+}
+
+uint8_t Bitfield_GetWidth(struct BitLayout const *layout)
+{
+	uint32_t bits = 0;
+	for (uint8_t i = 0; i < layout->count; ++i) {
+		bits |= layout->fields[i].mask << layout->fields[i].shift;
+	}
+	return 32 - Bits_Clz(bits, 32);
+}
+
+uint32_t Bitfield_Get(struct BitField const *field, uint32_t word)
+{
+	return (word >> field->shift) & field->mask;
+}
+
+void Bitfield_Decode(struct BitLayout const *layout, uint32_t word, uint32_t *values)
+{
+	struct BitField const *field = layout->fields;
+	for (uint8_t i = 0; i < layout->count; ++i, ++field) {
+		values[i] = (word >> field->shift) & field->mask;
+	}
+}
+
+uint32_t Bitfield_Pack(struct BitField const *field, uint32_t word, uint32_t value)
+{
+	return (word & ~(field->mask << field->shift)) | ((value & field->mask) << field->shift);
+}
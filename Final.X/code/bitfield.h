@@ -0,0 +1,60 @@
+/*
+ * Module of bit-field layouts that split a word into named fields,
+ * such as the fields of a status register or an instruction.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Most fields in a layout
+#define BITFIELD_MAX_FIELDS 5
+// Longest name of a field or layout, without the terminator
+#define BITFIELD_NAME_LEN 3
+#define BITFIELD_LAYOUT_NAME_LEN 6
+
+/** A field of a word, with its mask and shift precomputed. */
+struct BitField {
+	// mask of the field's value, applied after the shift
+	uint32_t mask;
+	// position of the field's lowest bit
+	uint8_t shift;
+	// radix the field is shown in
+	uint8_t base;
+	char name[BITFIELD_NAME_LEN + 1];
+};
+
+/** A layout of fields, from the most significant field. */
+struct BitLayout {
+	char name[BITFIELD_LAYOUT_NAME_LEN + 1];
+	uint8_t count;
+	struct BitField fields[BITFIELD_MAX_FIELDS];
+};
+
+/**
+ * Returns the number of preset layouts.
+ */
+uint8_t Bitfield_GetLayoutCount(void);
+/**
+ * Returns a preset layout.
+ */
+struct BitLayout const *Bitfield_GetLayout(uint8_t idx);
+/**
+ * Returns the number of bits a word needs to hold every field of a layout.
+ */
+uint8_t Bitfield_GetWidth(struct BitLayout const *layout);
+/**
+ * Returns the value of a field of a word.
+ */
+uint32_t Bitfield_Get(struct BitField const *field, uint32_t word);
+/**
+ * Splits a word into the values of each field of a layout.
+ */
+void Bitfield_Decode(struct BitLayout const *layout, uint32_t word, uint32_t *values);
+/**
+ * Returns a word with one field replaced by a value, truncated to the field.
+ */
+uint32_t Bitfield_Pack(struct BitField const *field, uint32_t word, uint32_t value);
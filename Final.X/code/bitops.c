@@ -0,0 +1,126 @@
+/*
+ * Module of bit manipulation functions.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "bitops.h"
+
+// Byte values with their bits reversed, built up 2 bits at a time
+#define REV2(n) (n), (n) + 2 * 64, (n) + 1 * 64, (n) + 3 * 64
+#define REV4(n) REV2(n), REV2((n) + 2 * 16), REV2((n) + 1 * 16), REV2((n) + 3 * 16)
+#define REV6(n) REV4(n), REV4((n) + 2 * 4), REV4((n) + 1 * 4), REV4((n) + 3 * 4)
+static uint8_t const reversed_bytes[256] = {
+	REV6(0), REV6(2), REV6(1), REV6(3)
+};
+
+/** Returns the number of leading zeros in a 32-bit value, 32 if it is 0. */
+static uint8_t Clz32(uint32_t x)
+{
+#if defined(__mips__)
+	// MIPS32 has a native count leading zeros instruction
+	uint32_t n;
+	asm("clz %0, %1" : "=r"(n) : "r"(x));
+	return n;
+#elif defined(__GNUC__)
+	// lets the compiler use the host's native instruction
+	return x ? __builtin_clz(x) : 32;
+#else
+	if (!x) {
+		return 32;
+	}
+	// binary search for the highest set bit
+	uint8_t n = 0;
+	for (uint8_t shift = 16; shift; shift >>= 1) {
+		if (!(x >> (32 - shift))) {
+			n += shift;
+			x <<= shift;
+		}
+	}
+	return n;
+#endif
+}
+
+/** Returns the number of leading ones in a 32-bit value, 32 if all bits are set. */
+static uint8_t Clo32(uint32_t x)
+{
+#if defined(__mips__)
+	// MIPS32 has a native count leading ones instruction
+	uint32_t n;
+	asm("clo %0, %1" : "=r"(n) : "r"(x));
+	return n;
+#else
+	return Clz32(~x);
+#endif
+}
+
+/** Returns a mask of the low width bits. */
+static uint32_t WidthMask(uint8_t width)
+{
+	return 0xFFFFFFFF >> (32 - width);
+}
+
+uint8_t Bits_Popcount(uint32_t x)
+{
+	// add adjacent bit counts in parallel (SWAR): 2-bit, then 4-bit, then 8-bit fields
+	x = x - ((x >> 1) & 0x55555555);
+	x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+	x = (x + (x >> 4)) & 0x0F0F0F0F;
+	// sum the four byte counts into the top byte
+	return (x * 0x01010101) >> 24;
+}
+
+uint8_t Bits_Clz(uint32_t x, uint8_t width)
+{
+	// the bits above the width are counted by the 32-bit instruction
+	return Clz32(x & WidthMask(width)) - (32 - width);
+}
+
+uint8_t Bits_Clo(uint32_t x, uint8_t width)
+{
+	// align the value to the top so the zeros shifted in stop the count at the width
+	return Clo32(x << (32 - width));
+}
+
+uint8_t Bits_Ctz(uint32_t x, uint8_t width)
+{
+	x &= WidthMask(width);
+	if (!x) {
+		return width;
+	}
+	// x & -x isolates the lowest set bit
+	return 31 - Clz32(x & -x);
+}
+
+uint8_t Bits_Parity(uint32_t x)
+{
+	// fold the value down to 4 bits, then look up the parity of the nibble
+	x ^= x >> 16;
+	x ^= x >> 8;
+	x ^= x >> 4;
+	return (0x6996 >> (x & 0xF)) & 1;
+}
+
+uint32_t Bits_Reverse(uint32_t x, uint8_t width)
+{
+	// reverse each byte, then the byte order, then drop the bits beyond the width
+	uint32_t const rev = ((uint32_t)reversed_bytes[x & 0xFF] << 24)
+		| ((uint32_t)reversed_bytes[(x >> 8) & 0xFF] << 16)
+		| ((uint32_t)reversed_bytes[(x >> 16) & 0xFF] << 8)
+		| reversed_bytes[x >> 24];
+	return rev >> (32 - width);
+}
+
+uint32_t Bits_ByteSwap(uint32_t x, uint8_t width)
+{
+#if defined(__GNUC__)
+	// this compiles to wsbh and rotr on MIPS32r2
+	uint32_t const swapped = __builtin_bswap32(x);
+#else
+	// swap the bytes of each half, then the halves
+	uint32_t swapped = ((x & 0x00FF00FF) << 8) | ((x >> 8) & 0x00FF00FF);
+	swapped = (swapped << 16) | (swapped >> 16);
+#endif
+	return swapped >> (32 - width);
+}
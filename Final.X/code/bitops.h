@@ -0,0 +1,42 @@
+/*
+ * Module of bit manipulation functions.
+ *
+ * Each function works on the low width bits of a value, where width is 1 to 32.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * Returns the number of set bits.
+ */
+uint8_t Bits_Popcount(uint32_t x);
+/**
+ * Returns the number of leading zeros in a value of the given width.
+ */
+uint8_t Bits_Clz(uint32_t x, uint8_t width);
+/**
+ * Returns the number of leading ones in a value of the given width.
+ */
+uint8_t Bits_Clo(uint32_t x, uint8_t width);
+/**
+ * Returns the number of trailing zeros in a value of the given width.
+ */
+uint8_t Bits_Ctz(uint32_t x, uint8_t width);
+/**
+ * Returns 1 if an odd number of bits are set, else 0.
+ */
+uint8_t Bits_Parity(uint32_t x);
+/**
+ * Returns a value of the given width with its bits in reverse order.
+ */
+uint32_t Bits_Reverse(uint32_t x, uint8_t width);
+/**
+ * Returns a value of the given width with its bytes in reverse order.
+ * The width must be a whole number of bytes.
+ */
+uint32_t Bits_ByteSwap(uint32_t x, uint8_t width);
@@ -12,206 +12,546 @@
 #include "input.h"
 #include "utils.h"
 #include "output.h"
+#include "history.h"
+#include "bitops.h"
+#include "radix.h"
+#include "checksum.h"
+#include "ieee754.h"
+#include "bitfield.h"
+#include "expr.h"
+#include "coretimer.h"
+#include "macro.h"
+#include "journal.h"
 #include <string.h>
 
-// Operands
-static uint16_t nums[2];
-static uint8_t num_updated[2];
-static uint8_t num_idx = 0;
-
-// Stores whether the last result was an error
-static uint8_t is_err;
-
-// Numerical base
-static enum NumBase {
-	Bin,
-	Dec,
-	Hex
-} num_base;
-static uint8_t const bases[] = {2, 10, 16};
-
-// Operator
-static enum Operator {
-	Add,
-	Sub,
-	Mult,
-	Div,
-	And,
-	Or,
-	Xor
-} operator;
+// Word sizes in bits, selected with a function key
+static uint8_t const word_sizes[] = {8, 16, 32};
+
+// The switch used to select the function (Fn) layer
+#define FN_SWT_BIT 7
+#define FN_SWT_MASK (1 << FN_SWT_BIT)
+
+// Functions selected with the keypad while the Fn switch is on
+enum FnKey {
+	FnRpn = 0x0,
+	FnPreview = 0x1,
+	// unary operators, in the same order as in enum Operator
+	FnPopcount = 0x2,
+	FnClz = 0x3,
+	FnClo = 0x4,
+	FnCtz = 0x5,
+	FnParity = 0x6,
+	FnBitReverse = 0x7,
+	FnByteSwap = 0x8,
+	FnBitEdit = 0x9,
+	FnWordSize = 0xA,
+	FnDivMode = 0xB,
+	FnChecksum = 0xC,
+	FnIeee = 0xD,
+	FnFields = 0xE,
+	FnSweep = 0xF
+};
+
+// Memory operations, selected in the Fn layer by the buttons held while pressing
+// the key of a memory register
+enum MemOp {
+	// U: store the current operand
+	MemStore,
+	// D: recall into the current operand
+	MemRecall,
+	// R: add the current operand
+	MemAdd,
+	// L: subtract the current operand
+	MemSub,
+	// U and D: swap with the current operand
+	MemSwap
+};
+
+// First column of the result preview on the second line of the LCD
+#define PREVIEW_COL 8
+
+// Custom LCD glyphs of the bit under the cursor: 0 and 1 with an underline
+#define BIT_CURSOR_GLYPH 0
+static uint8_t const bit_cursor_glyphs[2][LCD_GLYPH_ROWS] = {
+	{0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E, 0x1F},
+	{0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E, 0x1F}
+};
+
+// characters shown before the checksum for each algorithm
+static char const checksum_tags[CHECKSUM_ALGO_COUNT] = {'c', 'C', 'F', 'A'};
+
+// characters shown before the decimal value for each format, and before each field
+static char const ieee_tags[IEEE_FORMAT_COUNT] = {'h', 'f', 'd'};
+static char const ieee_field_tags[IEEE_FIELD_COUNT] = {'S', 'E', 'M'};
+
+// x moved by the U and D buttons in the table
+#define SWEEP_PAGE 16
+// most values of x tried by one search, so a 32-bit search takes a few presses
+#define SWEEP_SEARCH_LEN 65536
+
+// Numerical bases stopped at by the U and D buttons, by radix
+enum NumBase {
+	Bin = 2,
+	Oct = 8,
+	Dec = 10,
+	Hex = 16
+};
+static uint8_t const base_stops[] = {Bin, Oct, Dec, Hex};
+
+// number of operators selected by the switches
+#define SWT_OPERATOR_COUNT (Xor + 1)
 
 // operator characters for display
-static char const operators[] = {'+', '-', '*', '/', '&', '|', '^'};
-
-// RGBLED output
-static union {
-	// whether any operation has overflowed
-	uint8_t is_ovf;
-	// a bitfield of operations that can overflow
-	struct OverflowStatus {
-		// first operand
-		uint8_t num1 : 1;
-		// second operand
-		uint8_t num2 : 1;
-		// last result
-		uint8_t result : 1;
-	} fields;
-} overflow_stat = {0};
+static char const operators[] = {'+', '-', '*', '/', '&', '|', '^', 'P', 'L', 'O', 'T', '%', 'R', 'S'};
+// Operator of sweep expressions for each operator
+static enum ExprOp const expr_ops[] = {
+	[Add] = ExprAdd,
+	[Sub] = ExprSub,
+	[Mult] = ExprMult,
+	[Div] = ExprDiv,
+	[And] = ExprAnd,
+	[Or] = ExprOr,
+	[Xor] = ExprXor,
+	[Popcount] = ExprPopcount,
+	[Clz] = ExprClz,
+	[Clo] = ExprClo,
+	[Ctz] = ExprCtz,
+	[Parity] = ExprParity,
+	[BitReverse] = ExprBitReverse,
+	[ByteSwap] = ExprByteSwap
+};
+_Static_assert(sizeof(expr_ops) / sizeof(*expr_ops) == ByteSwap + 1 && ByteSwap + 1 == EXPR_OP_COUNT,
+	"every operator needs an expression operator");
 
 // Private functions
-static void ProcessKey(uint8_t key);
-static void RunOp(void);
-static void UpdateOvfStats(void);
-static void WriteNumLcd(uint8_t idx);
+static void ProcessKey(struct CalcState *calc, uint8_t key);
+static void RunOp(struct CalcState *calc);
+static void RunRpnOp(struct CalcState *calc);
+static void UpdatePreview(struct CalcState *calc);
+static uint64_t ApplyOp(struct CalcState *calc, enum Operator op, uint32_t lhs, uint32_t rhs, uint8_t *div_0_err);
+static uint8_t IsResultOvf(struct CalcState *calc, uint64_t num);
+static void RecordOp(struct CalcState *calc, uint32_t lhs, uint32_t rhs, enum Operator op, uint64_t num, uint8_t div_0_err);
+static void UpdateOvfStats(struct CalcState *calc);
+static void WriteNumLcd(struct CalcState *calc, uint8_t idx);
+static void WriteRemLcd(struct CalcState *calc, uint32_t rem);
+static uint8_t NumPrefixLen(uint8_t base);
+static void WriteNumPrefix(uint8_t base, char *str);
+static uint8_t NumFieldLen(struct CalcState *calc, uint8_t base);
+static uint8_t FitsLcd(struct CalcState *calc, uint32_t num, uint8_t base);
+static void NumToStr(struct CalcState *calc, uint32_t num, uint8_t base, char *str, size_t strlen);
+static void GetJournalState(struct CalcState *calc, struct JournalState *state);
+
+/** Returns whether the key changed in the input event. */
+static uint8_t IsNewKey(struct CalcState const *calc)
+{
+	return calc->event.input.key != calc->event.last.key;
+}
+/** Returns the key pressed in the input event, -1 if none. */
+static int8_t GetKey(struct CalcState const *calc)
+{
+	return calc->event.input.key;
+}
+
+/** Returns whether a button is pressed in the input event. */
+static uint8_t GetBtn(struct CalcState const *calc, uint8_t btn_num)
+{
+	return !!(calc->event.input.btn & (1 << btn_num));
+}
+/** Returns whether a button was pressed in the input event, and not before it. */
+static uint8_t GetNewBtn(struct CalcState const *calc, uint8_t btn_num)
+{
+	uint8_t const mask = 1 << btn_num;
+	return (calc->event.input.btn & mask) && !(calc->event.last.btn & mask);
+}
+/** Returns whether a button was released in the input event. */
+static uint8_t GetReleasedBtn(struct CalcState const *calc, uint8_t btn_num)
+{
+	uint8_t const mask = 1 << btn_num;
+	return !(calc->event.input.btn & mask) && (calc->event.last.btn & mask);
+}
+/** Returns the buttons pressed in the input event. */
+static uint8_t GetBtnGroup(struct CalcState const *calc)
+{
+	return calc->event.input.btn;
+}
+
+/** Returns whether a switch is on in the input event. */
+static uint8_t GetSwt(struct CalcState const *calc, uint8_t swt_num)
+{
+	return !!(calc->event.input.swt & (1 << swt_num));
+}
+/** Returns whether a switch was turned on in the input event. */
+static uint8_t GetNewSwt(struct CalcState const *calc, uint8_t swt_num)
+{
+	uint8_t const mask = 1 << swt_num;
+	return (calc->event.input.swt & mask) && !(calc->event.last.swt & mask);
+}
+/** Returns whether any switch changed in the input event. */
+static uint8_t IsNewSwtGroup(struct CalcState const *calc)
+{
+	return calc->event.input.swt != calc->event.last.swt;
+}
+/** Returns the switches on in the input event. */
+static uint8_t GetSwtGroup(struct CalcState const *calc)
+{
+	return calc->event.input.swt;
+}
+
+/** Marks a line of the LCD as changed. */
+static void SignalLcdUpdate(struct CalcState *calc, uint8_t idx)
+{
+	calc->delta.lcd_lines |= 1 << idx;
+}
+
+/** Sets the rows of a custom LCD glyph, marking it as changed if it did. */
+static void SetLcdGlyph(struct CalcState *calc, uint8_t idx, uint8_t const *rows)
+{
+	if (memcmp(calc->glyphs[idx], rows, LCD_GLYPH_ROWS)) {
+		memcpy(calc->glyphs[idx], rows, LCD_GLYPH_ROWS);
+		calc->delta.glyphs |= 1 << idx;
+	}
+}
+
+/** Sets the color of the RGB LED, marking it as changed if it did. */
+static void SetRgbColor(struct CalcState *calc, uint8_t r, uint8_t g, uint8_t b)
+{
+	if (calc->rgb[0] != r || calc->rgb[1] != g || calc->rgb[2] != b) {
+		calc->rgb[0] = r;
+		calc->rgb[1] = g;
+		calc->rgb[2] = b;
+		calc->delta.rgb = 1;
+	}
+}
+
+/** Sets the LEDs, marking them as changed if they did. */
+static void SetLeds(struct CalcState *calc, uint8_t leds)
+{
+	if (calc->leds != leds) {
+		calc->leds = leds;
+		calc->delta.leds = 1;
+	}
+}
+
+/** Asks the macro module to record, replay, or stop a macro after the step. */
+static void RequestMacro(struct CalcState *calc, enum CalcMacroRequest request, uint8_t slot)
+{
+	calc->delta.macro_request = request;
+	calc->delta.macro_slot = slot;
+}
 
 /** Resets the operands and operator. */
-static void ResetNums(void)
+static void ResetNums(struct CalcState *calc)
+{
+	memset(calc->nums, 0, sizeof(calc->nums));
+	memset(calc->num_updated, 0, sizeof(calc->num_updated));
+	// RPN always edits X, the second operand, and checksum and sweep mode the operand on the second line
+	calc->num_idx = (calc->calc_mode == Rpn || calc->checksum_on || calc->sweep_state);
+	calc->is_err = 0;
+	memset(&calc->overflow_stat, 0, sizeof(calc->overflow_stat));
+	// even zero doesn't fit in binary with the fraction digits of a fixed-point word
+	UpdateOvfStats(calc);
+
+	// clear the RPN stack
+	memset(calc->rpn_ring, 0, sizeof(calc->rpn_ring));
+	calc->rpn_top = 0;
+	calc->rpn_entry = 0;
+	calc->rpn_lift = 0;
+}
+
+/**
+ * Sets an operand, truncated to the word size.
+ * Only signals an LCD update if the value changed.
+ */
+static void SetNum(struct CalcState *calc, uint8_t idx, uint32_t num)
+{
+	num &= calc->word_mask;
+	if (calc->nums[idx] != num) {
+		calc->nums[idx] = num;
+		calc->num_updated[idx] = 1;
+	}
+}
+
+/** Writes a message to the given line of the LCD. */
+static void WriteMsgLcd(struct CalcState *calc, uint8_t idx, char const *msg)
+{
+	char *lcd = calc->lcd_text[idx];
+	// pad with spaces so nothing is left over from the last output
+	memset(lcd, ' ', LCD_BUFFER_STRLEN);
+	memcpy(lcd, msg, strlen(msg));
+	SignalLcdUpdate(calc, idx);
+}
+
+/** Writes an error message to the first line of the LCD. */
+static void ShowError(struct CalcState *calc, char const *msg)
 {
-	memset(nums, 0, sizeof(nums));
-	memset(num_updated, 0, sizeof(num_updated));
-	num_idx = 0;
-	is_err = 0;
-	memset(&overflow_stat, 0, sizeof(overflow_stat));
+	WriteMsgLcd(calc, 0, msg);
+	// signal an error
+	calc->is_err = 1;
 }
 
 /** Resets the LCD output. */
-static void ResetLcd(void)
+static void ResetLcd(struct CalcState *calc)
 {
-	char* lcd[] = {Output_GetLcdBuffer(0), Output_GetLcdBuffer(1)};
+	char* lcd[] = {calc->lcd_text[0], calc->lcd_text[1]};
 
 	// clear both lines with spaces
 	memset(lcd[0], ' ', LCD_BUFFER_STRLEN);
 	memset(lcd[1], ' ', LCD_BUFFER_STRLEN);
 
 	// write the first operand to the first line
-	WriteNumLcd(0);
-	// write the current operator to the second line
-	lcd[1][0] = operators[operator];
+	WriteNumLcd(calc, 0);
+	if (calc->ieee_on || calc->field_on || calc->sweep_state == SweepTable) {
+		// both lines show the floating-point number, fields, or table, written with the preview
+		calc->preview_dirty = 1;
+	} else if (calc->sweep_state == SweepExpr) {
+		// the first line shows the expression, written with the preview,
+		// and the second the operator and operand to apply to it
+		lcd[1][0] = operators[calc->operator];
+		WriteNumLcd(calc, 1);
+		calc->preview_dirty = 1;
+	} else if (calc->checksum_on) {
+		// the first line shows the checksum, written with the preview,
+		// and the second the operand to submit
+		lcd[1][0] = '>';
+		WriteNumLcd(calc, 1);
+		calc->preview_dirty = 1;
+	} else if (calc->calc_mode == Rpn) {
+		// the lines show the Y and X stack levels
+		lcd[0][0] = 'Y';
+		lcd[1][0] = 'X';
+		WriteNumLcd(calc, 1);
+	} else {
+		// write the current operator to the second line
+		lcd[1][0] = operators[calc->operator];
+	}
 
 	// signal that we need to write to the LCD
-	Output_SignalLcdUpdate(0);
-	Output_SignalLcdUpdate(1);
+	SignalLcdUpdate(calc, 0);
+	SignalLcdUpdate(calc, 1);
 }
 
-void Calculator_Init(void)
+/**
+ * Returns the number of digits needed to show a fraction of frac_bits bits in a radix,
+ * limited so radix^digits fits in 32 bits.
+ */
+static uint8_t CountFracDigits(struct CalcState *calc, uint8_t radix)
+{
+	uint8_t count = 0;
+	uint64_t scale = 1;
+	while (scale < ((uint64_t)1 << calc->frac_bits) && scale * radix <= 0xFFFFFFFF) {
+		scale *= radix;
+		++count;
+	}
+	return count;
+}
+
+/** Updates the widths of the digit fields for the word size and fixed-point format. */
+static void UpdateDigitFields(struct CalcState *calc)
+{
+	calc->frac_bits = (calc->div_mode == DivFixed) ? calc->word_bits / 4 * calc->fixed_quarters : 0;
+
+	// the digits of each operand are right-aligned in a field as wide as the largest operand
+	for (uint8_t radix = RADIX_MIN; radix <= RADIX_MAX; ++radix) {
+		calc->max_digits[radix] = Radix_CountDigits(calc->word_mask >> calc->frac_bits, radix);
+		calc->frac_digits[radix] = CountFracDigits(calc, radix);
+	}
+}
+
+/** Sets the word size, truncating the operands to fit. */
+static void SetWordBits(struct CalcState *calc, uint8_t bits)
+{
+	calc->word_bits = bits;
+	calc->word_mask = 0xFFFFFFFF >> (32 - bits);
+	UpdateDigitFields(calc);
+
+	for (int i = 0; i < sizeof(calc->nums) / sizeof(*calc->nums); ++i) {
+		calc->nums[i] &= calc->word_mask;
+	}
+	for (int i = 0; i < RPN_RING_LEN; ++i) {
+		calc->rpn_ring[i] &= calc->word_mask;
+	}
+	calc->bit_cursor &= calc->word_bits - 1;
+}
+
+void Calc_Init(struct CalcState *calc, struct CalcDelta *delta)
 {
+	// everything not set here starts off
+	memset(calc, 0, sizeof(*calc));
 	// reset the operands and operator
-	ResetNums();
-	num_base = Hex;
-	operator = Add;
-	// clear the overflow status
-	memset(&overflow_stat, 0, sizeof(overflow_stat));
+	calc->calc_mode = Standard;
+	calc->div_mode = DivQuot;
+	SetWordBits(calc, 16);
+	calc->num_base = Hex;
+	// also sets the overflow status of the cleared operands
+	ResetNums(calc);
+	calc->operator = Add;
+	// clear the memory registers and history
+	memset(calc->mem_regs, 0, sizeof(calc->mem_regs));
+	History_Init(&calc->history);
+	calc->hist_viewing = 0;
+	// start the journal from the cleared state
+	Journal_Init(&calc->journal);
+	GetJournalState(calc, &calc->journal_state);
+	// set up the bit cursor glyphs
+	calc->bit_edit = 0;
+	for (uint8_t i = 0; i < 2; ++i) {
+		SetLcdGlyph(calc, BIT_CURSOR_GLYPH + i, bit_cursor_glyphs[i]);
+	}
 	// clear the LCD display
-	ResetLcd();
+	ResetLcd(calc);
+
+	// hand over the first output
+	*delta = calc->delta;
+	memset(&calc->delta, 0, sizeof(calc->delta));
 }
 
 /**
  * Reads the switches and updates the current operator.
  */
-static void ProcessOperator(void)
+static void ProcessOperator(struct CalcState *calc)
 {
-	uint8_t const swt = Input_GetSwtGroup();
+	// the Fn switch does not select an operator
+	uint8_t const swt = GetSwtGroup(calc) & ~FN_SWT_MASK;
 	// Note: swt & (swt - 1) results in swt with the rightmost 1 flipped to 0
-	if (Input_IsNewSwtGroup() && (swt & (swt - 1)) == 0) {
+	if (calc->calc_mode == Rpn && !calc->sweep_state) {
+		// RPN applies operators as they are switched on, see ProcessRpnInput
+	} else if (IsNewSwtGroup(calc) && (swt & (swt - 1)) == 0) {
 		// only one switch is set, set operation
-		for (int i = 0; i < sizeof(operators) / sizeof(*operators); ++i) {
+		for (int i = 0; i < SWT_OPERATOR_COUNT; ++i) {
 			if (swt & (1 << i)) {
 				// found the operator
-				operator = i;
+				if (calc->operator != i) {
+					calc->operator = i;
+					calc->preview_dirty = 1;
+				}
+				if ((calc->bit_edit && calc->num_idx == 1) || calc->checksum_on || calc->ieee_on || calc->field_on || calc->sweep_state == SweepTable) {
+					// the bits use the whole line, the operator is shown after the edit;
+					// checksum mode, the float inspector, the fields, and the table don't use the operator
+					break;
+				}
 				// update the operator on the LCD
-				Output_GetLcdBuffer(1)[0] = operators[operator];
-				Output_SignalLcdUpdate(1);
+				char *lcd = calc->lcd_text[1];
+				lcd[0] = operators[calc->operator];
+				if (calc->num_idx == 0) {
+					// no second operand yet, clear what's left of the last preview
+					memset(lcd + 1, ' ', LCD_BUFFER_STRLEN - 1);
+				}
+				SignalLcdUpdate(calc, 1);
 				break;
 			}
 		}
 	}
-	// set the LED of the active operator
-	LED_SetGroupValue(1 << operator);
+	// set the LED of the active operator, and the LED above the Fn switch while recording a macro
+	SetLeds(calc, (1 << calc->operator) | (calc->event.macros.recording << FN_SWT_BIT));
 }
 
 /** Updates the numerical base used for output. */
-static void UpdateNumBase(void)
+static void UpdateNumBase(struct CalcState *calc)
 {
 	// signal that we need to update the displayed number
-	num_updated[0] = 1;
+	calc->num_updated[0] = 1;
 	// also signal to update the second operand if we're on it
-	if (num_idx) {
-		num_updated[1] = 1;
+	if (calc->num_idx) {
+		calc->num_updated[1] = 1;
 	}
 
 	// update the overflow status for the current operand
-	UpdateOvfStats();
+	UpdateOvfStats(calc);
 }
 
 /**
  * Reads the buttons and updates the numerical base.
+ * The buttons move between the base stops, from any radix.
  */
-static void ProcessNumBase(void)
+static void ProcessNumBase(struct CalcState *calc)
 {
-	if (Input_GetNewBtn(BTN_U_BIT)) {
-		// user wants to go up a base
-		if (++num_base > Hex) {
-			// wrap to binary
-			num_base = Bin;
+	if (GetNewBtn(calc, BTN_U_BIT)) {
+		// user wants to go up a base, wrapping to binary
+		uint8_t base = base_stops[0];
+		for (int i = 0; i < sizeof(base_stops); ++i) {
+			if (base_stops[i] > calc->num_base) {
+				base = base_stops[i];
+				break;
+			}
 		}
+		calc->num_base = base;
 		// update the base used for output
-		UpdateNumBase();
-	} else if (Input_GetNewBtn(BTN_D_BIT)) {
-		// user wants to go up a base
-		if (num_base-- == 0) {
-			// wrap to hex
-			num_base = Hex;
+		UpdateNumBase(calc);
+	} else if (GetNewBtn(calc, BTN_D_BIT)) {
+		// user wants to go down a base, wrapping to hex
+		uint8_t base = base_stops[sizeof(base_stops) - 1];
+		for (int i = sizeof(base_stops) - 1; i >= 0; --i) {
+			if (base_stops[i] < calc->num_base) {
+				base = base_stops[i];
+				break;
+			}
 		}
+		calc->num_base = base;
 		// update the base used for output
-		UpdateNumBase();
+		UpdateNumBase(calc);
 	}
 }
 
 /**
  * Reads the buttons and clears or deletes characters from the input.
  */
-static void ProcessClearBackspace(void)
+static void ProcessClearBackspace(struct CalcState *calc)
 {
-	if (Input_GetNewBtn(BTN_R_BIT)) {
+	if (GetNewBtn(calc, BTN_R_BIT)) {
 		// user wants to clear the input
-		if (nums[num_idx] != 0) {
+		if (calc->nums[calc->num_idx] != 0) {
 			// clear the current operand
-			nums[num_idx] = 0;
-			num_updated[num_idx] = 1;
+			calc->nums[calc->num_idx] = 0;
+			calc->num_updated[calc->num_idx] = 1;
 
 			// update the overflow status for the current operand
-			UpdateOvfStats();
+			UpdateOvfStats(calc);
 			// disable red LED for last result, user wants to use what's left
-			overflow_stat.fields.result = 0;
+			calc->overflow_stat.fields.result = 0;
+
+			// in RPN mode, the next entry replaces the cleared X
+			calc->rpn_entry = 0;
+			calc->rpn_lift = 0;
+		} else if (calc->checksum_on) {
+			// start the checksum over
+			Checksum_Init(&calc->checksum, calc->checksum.algo);
+			calc->checksum_pending = 0;
+			calc->preview_dirty = 1;
+		} else if (calc->sweep_state == SweepExpr) {
+			// start the expression over
+			Expr_Init(&calc->sweep_expr);
+			calc->preview_dirty = 1;
 		} else {
 			// clear all operands
-			ResetNums();
-			ResetLcd();
+			ResetNums(calc);
+			ResetLcd(calc);
 		}
-	} else if (Input_GetNewBtn(BTN_L_BIT) && nums[num_idx]) {
+	} else if (GetNewBtn(calc, BTN_L_BIT) && calc->nums[calc->num_idx]) {
 		// shift out the most recent digit (least significant))
-		nums[num_idx] /= bases[num_base];
+		uint8_t digit;
+		calc->nums[calc->num_idx] = Radix_DivMod(calc->nums[calc->num_idx], calc->num_base, &digit);
 		// signal to update the num output
-		num_updated[num_idx] = 1;
+		calc->num_updated[calc->num_idx] = 1;
 
 		// update the overflow status for the current operand
-		UpdateOvfStats();
+		UpdateOvfStats(calc);
 		// disable red LED for last result, user wants to use what's left
-		overflow_stat.fields.result = 0;
+		calc->overflow_stat.fields.result = 0;
 	}
 }
 
 /** Checks for the clear button to clear the current error. */
-static uint8_t CheckForClear(void)
+static uint8_t CheckForClear(struct CalcState *calc)
 {
-	if (Input_GetNewBtn(BTN_R_BIT)) {
+	if (GetNewBtn(calc, BTN_R_BIT)) {
 		// clear the error status
-		is_err = 0;
+		calc->is_err = 0;
 
-		// reset the operands and clear the screen
-		ResetNums();
-		ResetLcd();
+		// reset the operands and clear the screen; the RPN stack is kept
+		if (calc->calc_mode != Rpn) {
+			ResetNums(calc);
+		}
+		ResetLcd(calc);
 
 		// signal that we cleared
 		return 1;
@@ -221,281 +561,1895 @@ static uint8_t CheckForClear(void)
 	}
 }
 
-void Calculator_Process(void)
+/**
+ * Reads the C button and keypad for a standard (infix) calculation.
+ */
+static void ProcessStdInput(struct CalcState *calc)
 {
-	// process changes to the operator
-	ProcessOperator();
-
-	if (is_err) {
-		// last operation was an error, check for clear
-		if (!CheckForClear()) {
-			// user hasn't cleared yet, leave early
-			return;
-		}
-	}
-
-	// process changes to the numerical base or clear/backspace
-	ProcessNumBase();
-	ProcessClearBackspace();
-
-	// process new input
-	if (Input_GetNewBtn(BTN_C_BIT)) {
+	if (GetNewBtn(calc, BTN_C_BIT)) {
 		// user submitted an operand
-		if (num_idx == 0) {
+		if (calc->num_idx == 0) {
 			// user submitted first operand, switch to second and update output
-			++num_idx;
-			num_updated[num_idx] = 1;
+			++calc->num_idx;
+			calc->num_updated[calc->num_idx] = 1;
 
 			// disable red LED for last result, user wants to use what's left
-			overflow_stat.fields.result = 0;
+			calc->overflow_stat.fields.result = 0;
 		} else {
 			// user submitted second operand, run the operation
-			RunOp();
+			RunOp(calc);
 		}
-	} else if (Input_IsNewKey()) {
+	} else if (IsNewKey(calc)) {
 		// user submitted another digit
-		int8_t const key = Input_GetKey();
+		int8_t const key = GetKey(calc);
 		if (key >= 0) {
 			// valid key, update the current operand
-			ProcessKey(key);
+			ProcessKey(calc, key);
 
 			// disable red LED for last result, user wants to use what's left
-			overflow_stat.fields.result = 0;
+			calc->overflow_stat.fields.result = 0;
 		}
 	}
+}
 
-	// update the LCD output
-	if (num_updated[0]) {
-		WriteNumLcd(0);
-	}
-	if (num_updated[1]) {
-		WriteNumLcd(1);
+/** Pushes X onto the RPN stack, discarding the bottom level if the stack is full. */
+static void RpnLift(struct CalcState *calc)
+{
+	// Y moves down to level 3, overwriting the slot of the bottom level
+	calc->rpn_top = (calc->rpn_top == 0 ? RPN_RING_LEN : calc->rpn_top) - 1;
+	calc->rpn_ring[calc->rpn_top] = calc->nums[0];
+	// X is copied into Y
+	SetNum(calc, 0, calc->nums[1]);
+}
+
+/** Pops level 3 of the RPN stack into Y; the caller overwrites X. */
+static void RpnDrop(struct CalcState *calc)
+{
+	SetNum(calc, 0, calc->rpn_ring[calc->rpn_top]);
+	// the slot of level 3 becomes the zero-filled bottom level
+	calc->rpn_ring[calc->rpn_top] = 0;
+	if (++calc->rpn_top == RPN_RING_LEN) {
+		calc->rpn_top = 0;
 	}
+}
 
-	// update the RGB LED
-	uint8_t const is_red = !!(overflow_stat.is_ovf);
-	Output_SetRgbColor(0x1F * is_red, 0, 0);
+/**
+ * Reads the switches for an RPN calculation, applying an operator to Y and X
+ * when its switch is turned on. Returns whether an operator was applied.
+ */
+static uint8_t ProcessRpnOperator(struct CalcState *calc)
+{
+	for (int i = 0; i < SWT_OPERATOR_COUNT; ++i) {
+		if (GetNewSwt(calc, i)) {
+			calc->operator = i;
+			RunRpnOp(calc);
+			return 1;
+		}
+	}
+	return 0;
 }
 
-/** Updates an operand based on the given keypress. */
-static void ProcessKey(uint8_t key)
+/**
+ * Reads the switches, C button (ENTER), and keypad for an RPN calculation.
+ */
+static void ProcessRpnInput(struct CalcState *calc)
 {
-	switch (num_base) {
-		case Bin:
-			// key can be 0 or 1; do not accept key if bits 14 or 15 are set (max int)
-			if (key <= 0b1 && !(nums[num_idx] & 0xC000)) {
-				// shift left for new digit
-				nums[num_idx] <<= 1;
-				// add new digit
-				nums[num_idx] += key;
-				// update the num output
-				num_updated[num_idx] = 1;
-			}
-			break;
-			
-		case Dec:
-			// key can be 0-9
-			if (key <= 9) {
-				// multiply operand by 10 and add new digit
-				uint32_t const num = nums[num_idx] * 10 + key;
-				// only update the number if it fits in 16 bits
-				if (num <= 0xFFFF) {
-					nums[num_idx] = num;
-					// update the num output
-					num_updated[num_idx] = 1;
+	if (ProcessRpnOperator(calc)) {
+		return;
+	}
+
+	if (GetNewBtn(calc, BTN_C_BIT)) {
+		// ENTER, push a copy of X; the next entry replaces the copy left in X
+		RpnLift(calc);
+		calc->rpn_entry = 0;
+		calc->rpn_lift = 0;
+
+		// update the overflow status for the moved operand
+		UpdateOvfStats(calc);
+		// disable red LED for last result, user wants to use what's left
+		calc->overflow_stat.fields.result = 0;
+	} else if (IsNewKey(calc)) {
+		// user submitted another digit
+		int8_t const key = GetKey(calc);
+		if (key >= 0 && key < calc->num_base) {
+			if (!calc->rpn_entry) {
+				// start a new entry in X, pushing the last result if needed
+				if (calc->rpn_lift) {
+					RpnLift(calc);
 				}
+				SetNum(calc, 1, 0);
+				calc->rpn_entry = 1;
+				UpdateOvfStats(calc);
 			}
-			break;
-			
-		case Hex:
-			// key can be 0-F; do not accept key if upper byte is non-zero (max int)
-			if (key <= 0xF && !(nums[num_idx] & 0xF000)) {
-				// shift left for new digit
-				nums[num_idx] <<= 4;
-				// add new digit
-				nums[num_idx] += key;
-				// update the num output
-				num_updated[num_idx] = 1;
-			}
-			break;
+			// valid key, update X
+			ProcessKey(calc, key);
+
+			// disable red LED for last result, user wants to use what's left
+			calc->overflow_stat.fields.result = 0;
+		}
+	}
+}
+
+/** Runs a unary operator on the current operand, replacing it with the result. */
+static void RunUnaryOp(struct CalcState *calc, enum Operator op)
+{
+	uint8_t div_0_err;
+	uint64_t const num = ApplyOp(calc, op, calc->nums[calc->num_idx], 0, &div_0_err);
+	RecordOp(calc, calc->nums[calc->num_idx], 0, op, num, div_0_err);
+
+	if (calc->calc_mode == Rpn) {
+		// the result is a new X that the next entry pushes
+		calc->rpn_entry = 0;
+		calc->rpn_lift = 1;
+	}
+	SetNum(calc, calc->num_idx, num);
+
+	// update the overflow status for the new operand; the result itself always fits
+	UpdateOvfStats(calc);
+	calc->overflow_stat.fields.result = 0;
+}
+
+/** Turns bit edit mode on or off. */
+static void SetBitEdit(struct CalcState *calc, uint8_t on)
+{
+	if (calc->bit_edit == on) {
+		return;
+	}
+	calc->bit_edit = on;
+	calc->bit_cursor = 0;
+
+	if (calc->bit_edit) {
+		// show the bits of the current operand
+		calc->num_updated[calc->num_idx] = 1;
+	} else {
+		// show the operands as normal, including the operator or stack marker
+		ResetLcd(calc);
+		calc->num_updated[1] = calc->num_idx;
 	}
 }
 
 /**
- * Runs the arithmetic operation on the inputs.
+ * Reads the buttons and keypad in bit edit mode.
+ * L and R move the cursor by one bit, U and D by one hex digit, the keypad
+ * toggles the bit under the cursor, and C ends the edit.
  */
-static void RunOp(void)
+static void ProcessBitEdit(struct CalcState *calc)
 {
-	uint32_t num = 0;
-	uint8_t div_0_err = 0;
+	uint8_t cursor = calc->bit_cursor;
+	if (GetNewBtn(calc, BTN_L_BIT)) {
+		++cursor;
+	} else if (GetNewBtn(calc, BTN_R_BIT)) {
+		--cursor;
+	} else if (GetNewBtn(calc, BTN_U_BIT)) {
+		cursor += 4;
+	} else if (GetNewBtn(calc, BTN_D_BIT)) {
+		cursor -= 4;
+	} else if (GetNewBtn(calc, BTN_C_BIT)) {
+		SetBitEdit(calc, 0);
+		return;
+	} else if (IsNewKey(calc)) {
+		int8_t const key = GetKey(calc);
+		if (key < 0) {
+			return;
+		}
+		// any key toggles the bit in place
+		calc->nums[calc->num_idx] ^= (uint32_t)1 << calc->bit_cursor;
+		calc->num_updated[calc->num_idx] = 1;
 
-	// run the operation
-	switch (operator) {
-		case Add:
-			num = nums[0] + nums[1];
-			break;
-		case Sub:
-			num = nums[0] - nums[1];
-			break;
-		case Mult:
-			num = nums[0] * nums[1];
-			break;
-		case Div:
-			// check for divide by 0
-			if (nums[1] == 0) {
-				div_0_err = 1;
-			} else {
-				num = nums[0] / nums[1];
-			}
-			break;
-		case And:
-			num = nums[0] & nums[1];
-			break;
-		case Or:
-			num = nums[0] | nums[1];
-			break;
-		case Xor:
-			num = nums[0] ^ nums[1];
-			break;
+		// update the overflow status for the edited operand
+		UpdateOvfStats(calc);
+		// disable red LED for last result, user wants to use what's left
+		calc->overflow_stat.fields.result = 0;
+		return;
 	}
 
-	// reset operands and clear screen
-	ResetNums();
-	ResetLcd();
+	// wrap around the word; the LCD only rewrites the two cells the cursor moved between
+	cursor &= calc->word_bits - 1;
+	if (cursor != calc->bit_cursor) {
+		calc->bit_cursor = cursor;
+		calc->num_updated[calc->num_idx] = 1;
+	}
+}
 
-	// set output
-	if (div_0_err) {
-		// output an error to the LCD
-		strcpy(Output_GetLcdBuffer(0), "Err: div by 0");
-		Output_SignalLcdUpdate(0);
-		// signal an error
-		is_err = 1;
-	} else {
-		// output the result
-		nums[0] = num;
-		num_updated[0] = 1;
+/** Adds the bytes of an operand to a checksum, most significant first like the digits are typed. */
+static void FeedChecksum(struct CalcState *calc, struct Checksum *sum, uint32_t num)
+{
+	uint8_t bytes[4];
+	uint8_t const len = calc->word_bits / 8;
+	for (uint8_t i = 0; i < len; ++i) {
+		bytes[i] = num >> (8 * (len - 1 - i));
+	}
+	Checksum_Update(sum, bytes, len);
+}
 
-		// set the overflow status
-		if (num > 0xFFFF || (num_base == Bin && (num & 0x8000))) {
-			overflow_stat.fields.result = 1;
-		} else {
-			overflow_stat.fields.result = 0;
+/**
+ * Writes the checksum to the first line of the LCD, with every digit of its width.
+ * Includes the operand being typed, so the checksum is always live.
+ */
+static void WriteChecksumLcd(struct CalcState *calc)
+{
+	struct Checksum sum = calc->checksum;
+	if (calc->checksum_pending) {
+		FeedChecksum(calc, &sum, calc->nums[1]);
+	}
+
+	char *lcd = calc->lcd_text[0];
+	memset(lcd, ' ', LCD_BUFFER_STRLEN);
+	lcd[0] = checksum_tags[sum.algo];
+
+	uint8_t const prefix_len = NumPrefixLen(calc->num_base);
+	WriteNumPrefix(calc->num_base, lcd + 1);
+	uint8_t len = Radix_CountDigits(0xFFFFFFFF >> (32 - Checksum_GetWidth(sum.algo)), calc->num_base);
+	if (prefix_len + len > LCD_BUFFER_STRLEN - 1) {
+		// only the lowest digits fit, such as a CRC-32 in binary
+		len = LCD_BUFFER_STRLEN - 1 - prefix_len;
+	}
+	Radix_ToStr(Checksum_Get(&sum), calc->num_base, lcd + 1 + prefix_len, len);
+	SignalLcdUpdate(calc, 0);
+}
+
+/**
+ * Reads the C button and keypad in checksum mode.
+ * C feeds the operand on the second line into the checksum.
+ */
+static void ProcessChecksumInput(struct CalcState *calc)
+{
+	if (GetNewBtn(calc, BTN_C_BIT)) {
+		FeedChecksum(calc, &calc->checksum, calc->nums[1]);
+		calc->checksum_pending = 0;
+		calc->preview_dirty = 1;
+		// start the next operand
+		SetNum(calc, 1, 0);
+		UpdateOvfStats(calc);
+	} else if (IsNewKey(calc)) {
+		// user submitted another digit
+		int8_t const key = GetKey(calc);
+		if (key >= 0) {
+			ProcessKey(calc, key);
+			calc->checksum_pending = 1;
+			calc->preview_dirty = 1;
 		}
 	}
 }
 
-/** Updates the current operand's overflow status. */
-static void UpdateOvfStats(void)
+/**
+ * Switches to the next checksum algorithm, starting a new checksum, or
+ * leaves checksum mode after the last algorithm.
+ */
+static void CycleChecksum(struct CalcState *calc)
 {
-	if (num_base == Bin) {
-		// We're in binary; if beyond 15 bits, signal overflow
-		overflow_stat.fields.num1 = !!(nums[0] & 0x8000);
-		overflow_stat.fields.num2 = !!(nums[1] & 0x8000);
+	if (!calc->checksum_on) {
+		// the checksum takes over the LCD from the float inspector, fields, and sweep mode
+		calc->ieee_on = 0;
+		calc->field_on = 0;
+		calc->sweep_state = SweepOff;
+		calc->checksum_on = 1;
+		Checksum_Init(&calc->checksum, 0);
+	} else if (calc->checksum.algo + 1 < CHECKSUM_ALGO_COUNT) {
+		Checksum_Init(&calc->checksum, calc->checksum.algo + 1);
 	} else {
-		// Not in binary, so operands cannot overflow
-		overflow_stat.fields.num1 = 0;
-		overflow_stat.fields.num2 = 0;
+		calc->checksum_on = 0;
 	}
+	calc->checksum_pending = 0;
+
+	// entering or leaving checksum mode clears the operands
+	ResetNums(calc);
+	ResetLcd(calc);
+	calc->num_updated[1] = calc->num_idx;
 }
 
-static void NumToStr(uint16_t num, char *str, size_t strlen);
+/**
+ * Leaves bit edit, checksum mode, the float inspector, the fields, and sweep mode
+ * before another view takes over the LCD. The operands are cleared if a mode repurposed them.
+ */
+static void LeaveModes(struct CalcState *calc)
+{
+	SetBitEdit(calc, 0);
+	if (calc->checksum_on || calc->sweep_state) {
+		calc->checksum_on = 0;
+		calc->sweep_state = SweepOff;
+		ResetNums(calc);
+	}
+	calc->ieee_on = 0;
+	calc->field_on = 0;
+}
 
-/** Writes the given operand onto the LCD. */
-static void WriteNumLcd(uint8_t idx)
+/** Grows the word size to the smallest that holds the given number of bits, if needed. */
+static void GrowWordBits(struct CalcState *calc, uint8_t bits)
 {
-	char *lcd = Output_GetLcdBuffer(idx);
-	// convert the operand to a string
-	NumToStr(nums[idx], lcd + 1, LCD_BUFFER_STRLEN - 1);
-	// signal that we want to update this line of the LCD
-	Output_SignalLcdUpdate(idx);
+	if (calc->word_bits >= bits) {
+		return;
+	}
+	uint8_t i = 0;
+	while (i < sizeof(word_sizes) - 1 && word_sizes[i] < bits) {
+		++i;
+	}
+	SetWordBits(calc, word_sizes[i]);
+
+	// update the overflow status for the wider operands
+	UpdateOvfStats(calc);
+	// disable red LED for last result, it may not overflow anymore
+	calc->overflow_stat.fields.result = 0;
 }
 
-/** Converts a binary number to a string. */
-static void BinToStr(uint16_t bin, char *str, size_t strlen)
+/** Returns the bit pattern of the floating-point number being inspected. */
+static uint64_t GetIeeeBits(struct CalcState *calc)
 {
-	// 16-bit binary number is max 15 digits (+ 1 blank on LCD), unless string isn't long enough
-	size_t const max_len = strlen < 16 ? strlen : 15;
+	if (calc->ieee_format == IeeeDouble) {
+		// the first operand holds the high word and the second the low word
+		return ((uint64_t)calc->nums[0] << 32) | calc->nums[1];
+	}
+	return calc->nums[calc->num_idx] & (0xFFFFFFFF >> (32 - Ieee_GetWidth(calc->ieee_format)));
+}
 
-	memset(str, ' ', strlen);
-	// no space for prefix
-	for (int i = 0; i < max_len; ++i) {
-		uint8_t const bin_digit = bin & 0x1;
-		// set the digit i from the right of the string
-		str[max_len - i - 1] = '0' + bin_digit;
-		// shift out the digit we just set
-		bin >>= 1;
-		
-		if (!bin) {
-			break;
-		}
+/** Sets the operands to the bit pattern of the floating-point number being inspected. */
+static void SetIeeeBits(struct CalcState *calc, uint64_t bits)
+{
+	if (calc->ieee_format == IeeeDouble) {
+		SetNum(calc, 0, bits >> 32);
+		SetNum(calc, 1, bits);
+	} else {
+		SetNum(calc, calc->num_idx, bits);
+	}
+	// update the overflow status for the changed operands
+	UpdateOvfStats(calc);
+}
+
+/** Returns the largest value of a field of the inspected format. */
+static uint64_t GetIeeeFieldMax(struct CalcState *calc, enum IeeeField field)
+{
+	switch (field) {
+		case FieldSign:
+			return 1;
+		case FieldExp:
+			return (1 << Ieee_GetExpBits(calc->ieee_format)) - 1;
+		default:
+			return ((uint64_t)1 << Ieee_GetMantBits(calc->ieee_format)) - 1;
 	}
 }
 
-/** Converts a decimal number to a string. */
-static void DecToStr(uint16_t dec, char *str, size_t strlen)
+/** Returns the value of a field. */
+static uint64_t GetIeeeField(struct IeeeFields const *fields, enum IeeeField field)
 {
-	// 16-bit decimal number is max 5 digits + prefix of 2, unless string isn't long enough 
-	size_t const max_len = strlen < 7 ? strlen : 7;
+	switch (field) {
+		case FieldSign:
+			return fields->sign;
+		case FieldExp:
+			return fields->exp;
+		default:
+			return fields->mant;
+	}
+}
 
-	memset(str, ' ', strlen);
-	// prefix of "0d"
-	str[0] = '0';
-	str[1] = 'd';
-	for (int i = 0; i < max_len - 2; ++i) {
-		uint8_t const dec_digit = dec % 10;
-		// set the digit i from the right of the string
-		str[max_len - i - 1] = '0' + dec_digit;
-		// shift out the digit we just set
-		dec /= 10;
-		
-		if (!dec) {
+/** Sets the value of a field. */
+static void SetIeeeField(struct IeeeFields *fields, enum IeeeField field, uint64_t value)
+{
+	switch (field) {
+		case FieldSign:
+			fields->sign = value;
+			break;
+		case FieldExp:
+			fields->exp = value;
+			break;
+		default:
+			fields->mant = value;
 			break;
-		}
 	}
 }
 
-/** Converts a hexadecimal number to a string. */
-static void HexToStr(uint16_t hex, char *str, size_t strlen)
+/**
+ * Writes the floating-point number being inspected to the LCD. The first line shows
+ * the format and the decimal value, and the second the selected field in the
+ * numerical base, with the unbiased exponent after the exponent field.
+ */
+static void WriteIeeeLcd(struct CalcState *calc)
 {
-	// 16-bit hex number is max 4 digits + prefix of 2, unless string isn't long enough 
-	size_t const max_len = strlen < 6 ? strlen : 6;
+	char* lcd[] = {calc->lcd_text[0], calc->lcd_text[1]};
+	uint64_t const bits = GetIeeeBits(calc);
 
-	memset(str, ' ', strlen);
-	// prefix of "0x"
-	str[0] = '0';
-	str[1] = 'x';
-	for (int i = 0; i < max_len - 2; ++i) {
-		uint8_t const hex_digit = hex & 0xF;
-		// set the digit i from the right of the string
-		if (hex_digit >= 0xA) {
-			str[max_len - i - 1] = 'A' + hex_digit - 0xA;
-		} else {
-			str[max_len - i - 1] = '0' + hex_digit;
-		}
-		// shift out the digit we just set
-		hex >>= 4;
-		
-		if (!hex) {
-			break;
+	memset(lcd[0], ' ', LCD_BUFFER_STRLEN);
+	lcd[0][0] = ieee_tags[calc->ieee_format];
+	Ieee_ToStr(calc->ieee_format, bits, lcd[0] + 1, LCD_BUFFER_STRLEN - 1);
+
+	struct IeeeFields fields;
+	Ieee_Unpack(calc->ieee_format, bits, &fields);
+
+	memset(lcd[1], ' ', LCD_BUFFER_STRLEN);
+	lcd[1][0] = ieee_field_tags[calc->ieee_field];
+	uint8_t const prefix_len = NumPrefixLen(calc->num_base);
+	WriteNumPrefix(calc->num_base, lcd[1] + 1);
+	uint8_t len = Radix_CountDigits64(GetIeeeFieldMax(calc, calc->ieee_field), calc->num_base);
+	if (prefix_len + len > LCD_BUFFER_STRLEN - 1) {
+		// only the lowest digits fit, such as a double's mantissa in binary
+		len = LCD_BUFFER_STRLEN - 1 - prefix_len;
+	}
+	Radix_ToStr64(GetIeeeField(&fields, calc->ieee_field), calc->num_base, lcd[1] + 1 + prefix_len, len);
+
+	if (calc->ieee_field == FieldExp && fields.exp != GetIeeeFieldMax(calc, FieldExp)) {
+		// subnormal numbers have the exponent of the smallest normal numbers
+		int16_t const exp = (fields.exp ? fields.exp : 1) - Ieee_GetBias(calc->ieee_format);
+		uint16_t const exp_abs = (exp < 0) ? -exp : exp;
+		uint8_t const exp_digits = Radix_CountDigits(exp_abs, 10);
+		// "2^", the sign, and the digits, right-aligned if there's room after the field
+		uint8_t const exp_len = 2 + (exp < 0) + exp_digits;
+		if (1 + prefix_len + len + 1 + exp_len <= LCD_BUFFER_STRLEN) {
+			char *str = lcd[1] + LCD_BUFFER_STRLEN - exp_len;
+			str[0] = '2';
+			str[1] = '^';
+			if (exp < 0) {
+				str[2] = '-';
+			}
+			Radix_ToStr(exp_abs, 10, str + exp_len - exp_digits, exp_digits);
 		}
 	}
+
+	SignalLcdUpdate(calc, 0);
+	SignalLcdUpdate(calc, 1);
 }
 
-/** Converts a number to a string in the appropriate numerical base format. */
-static void NumToStr(uint16_t num, char *str, size_t strlen)
+/**
+ * Reads the buttons and keypad while inspecting a floating-point number.
+ * L and R select a field, the keypad types the value of the field in the
+ * numerical base, and C negates the number.
+ */
+static void ProcessIeeeInput(struct CalcState *calc)
 {
-	// we need to have enough space for a 2-digit prefix
-	if (strlen < 2) return;
+	struct IeeeFields fields;
+	Ieee_Unpack(calc->ieee_format, GetIeeeBits(calc), &fields);
 
-	switch (num_base) {
-		case Bin:
-			BinToStr(num, str, strlen);
-			break;
-		case Dec:
-			DecToStr(num, str, strlen);
-			break;
-		case Hex:
-			HexToStr(num, str, strlen);
+	if (GetNewBtn(calc, BTN_L_BIT)) {
+		// L moves toward the sign, wrapping to the mantissa
+		calc->ieee_field = (calc->ieee_field == FieldSign) ? FieldMant : calc->ieee_field - 1;
+		calc->ieee_entry = 0;
+		calc->preview_dirty = 1;
+		return;
+	} else if (GetNewBtn(calc, BTN_R_BIT)) {
+		// R moves toward the mantissa, wrapping to the sign
+		calc->ieee_field = (calc->ieee_field == FieldMant) ? FieldSign : calc->ieee_field + 1;
+		calc->ieee_entry = 0;
+		calc->preview_dirty = 1;
+		return;
+	} else if (GetNewBtn(calc, BTN_C_BIT)) {
+		fields.sign ^= 1;
+	} else if (IsNewKey(calc)) {
+		int8_t const key = GetKey(calc);
+		if (key < 0 || key >= calc->num_base) {
+			return;
+		}
+		// the first digit replaces the field, and the next ones are appended;
+		// the field is at most 52 bits, so this can't overflow
+		uint64_t const value = (calc->ieee_entry ? GetIeeeField(&fields, calc->ieee_field) * calc->num_base : 0) + key;
+		if (value > GetIeeeFieldMax(calc, calc->ieee_field)) {
+			return;
+		}
+		SetIeeeField(&fields, calc->ieee_field, value);
+		calc->ieee_entry = 1;
+	} else {
+		return;
+	}
+
+	SetIeeeBits(calc, Ieee_Pack(calc->ieee_format, &fields));
+	// disable red LED for last result, user wants to use what's left
+	calc->overflow_stat.fields.result = 0;
+}
+
+/** Stops showing the operand as a floating-point number or fields, or the sweep, showing the operands again. */
+static void CloseViews(struct CalcState *calc)
+{
+	calc->ieee_on = 0;
+	calc->field_on = 0;
+	if (calc->sweep_state) {
+		// sweep mode repurposed the operands
+		calc->sweep_state = SweepOff;
+		ResetNums(calc);
+	}
+	ResetLcd(calc);
+	// ResetLcd only writes the second operand in RPN mode
+	calc->num_updated[1] = calc->num_idx;
+}
+
+/**
+ * Inspects the current operand as the next floating-point format: half, single,
+ * then double, and stops inspecting after double.
+ * The word size grows if needed to hold the format.
+ */
+static void CycleIeee(struct CalcState *calc)
+{
+	if (!calc->ieee_on) {
+		// the inspector takes over the LCD from the other modes
+		LeaveModes(calc);
+		calc->ieee_on = 1;
+		calc->ieee_format = IeeeHalf;
+		calc->ieee_field = FieldSign;
+	} else if (calc->ieee_format + 1 < IEEE_FORMAT_COUNT) {
+		++calc->ieee_format;
+	} else {
+		CloseViews(calc);
+		return;
+	}
+	calc->ieee_entry = 0;
+
+	// a double is split over two 32-bit operands
+	GrowWordBits(calc, calc->ieee_format == IeeeDouble ? 32 : Ieee_GetWidth(calc->ieee_format));
+	ResetLcd(calc);
+}
+
+/**
+ * Writes the current operand split into fields to the LCD. The first line shows the
+ * value of every field in its own base, and the second the selected field with its
+ * name and base prefix, then the name of the layout.
+ */
+static void WriteFieldsLcd(struct CalcState *calc)
+{
+	char* lcd[] = {calc->lcd_text[0], calc->lcd_text[1]};
+	struct BitLayout const *layout = Bitfield_GetLayout(calc->field_layout);
+	uint32_t values[BITFIELD_MAX_FIELDS];
+	Bitfield_Decode(layout, calc->nums[calc->num_idx], values);
+
+	// the values are right-aligned in the width of their fields, separated by spaces
+	memset(lcd[0], ' ', LCD_BUFFER_STRLEN);
+	uint8_t col = 0;
+	for (uint8_t i = 0; i < layout->count; ++i) {
+		struct BitField const *field = &layout->fields[i];
+		uint8_t const len = Radix_CountDigits(field->mask, field->base);
+		if (col + len > LCD_BUFFER_STRLEN) {
+			break;
+		}
+		Radix_ToStr(values[i], field->base, lcd[0] + col, len);
+		col += len + 1;
+	}
+
+	struct BitField const *field = &layout->fields[calc->field_idx];
+	memset(lcd[1], ' ', LCD_BUFFER_STRLEN);
+	memcpy(lcd[1], field->name, strlen(field->name));
+	char *str = lcd[1] + BITFIELD_NAME_LEN + 1;
+	uint8_t const prefix_len = NumPrefixLen(field->base);
+	uint8_t const len = Radix_CountDigits(field->mask, field->base);
+	WriteNumPrefix(field->base, str);
+	Radix_ToStr(values[calc->field_idx], field->base, str + prefix_len, len);
+
+	uint8_t const name_len = strlen(layout->name);
+	if (BITFIELD_NAME_LEN + 1 + prefix_len + len + 1 + name_len <= LCD_BUFFER_STRLEN) {
+		memcpy(lcd[1] + LCD_BUFFER_STRLEN - name_len, layout->name, name_len);
+	}
+
+	SignalLcdUpdate(calc, 0);
+	SignalLcdUpdate(calc, 1);
+}
+
+/**
+ * Reads the buttons and keypad while the current operand is split into fields.
+ * L and R select a field, U and D select the layout, the keypad types the value
+ * of the field in its base, and C clears the field.
+ */
+static void ProcessFieldInput(struct CalcState *calc)
+{
+	uint8_t const layout_count = Bitfield_GetLayoutCount();
+	struct BitLayout const *layout = Bitfield_GetLayout(calc->field_layout);
+	struct BitField const *field = &layout->fields[calc->field_idx];
+	uint32_t value;
+
+	if (GetNewBtn(calc, BTN_L_BIT)) {
+		calc->field_idx = (calc->field_idx == 0 ? layout->count : calc->field_idx) - 1;
+	} else if (GetNewBtn(calc, BTN_R_BIT)) {
+		calc->field_idx = (calc->field_idx + 1 == layout->count) ? 0 : calc->field_idx + 1;
+	} else if (GetNewBtn(calc, BTN_U_BIT)) {
+		calc->field_layout = (calc->field_layout + 1 == layout_count) ? 0 : calc->field_layout + 1;
+		calc->field_idx = 0;
+		GrowWordBits(calc, Bitfield_GetWidth(Bitfield_GetLayout(calc->field_layout)));
+	} else if (GetNewBtn(calc, BTN_D_BIT)) {
+		calc->field_layout = (calc->field_layout == 0 ? layout_count : calc->field_layout) - 1;
+		calc->field_idx = 0;
+		GrowWordBits(calc, Bitfield_GetWidth(Bitfield_GetLayout(calc->field_layout)));
+	} else {
+		int8_t const key = GetKey(calc);
+		if (GetNewBtn(calc, BTN_C_BIT)) {
+			value = 0;
+			calc->field_entry = 0;
+		} else if (IsNewKey(calc) && key >= 0) {
+			// the first digit replaces the field, and the next ones are appended
+			value = calc->field_entry ? Bitfield_Get(field, calc->nums[calc->num_idx]) : 0;
+			if (!Radix_AppendDigit(&value, field->base, key, field->mask)) {
+				return;
+			}
+			calc->field_entry = 1;
+		} else {
+			return;
+		}
+
+		// re-pack the field into the operand
+		SetNum(calc, calc->num_idx, Bitfield_Pack(field, calc->nums[calc->num_idx], value));
+		// update the overflow status for the edited operand
+		UpdateOvfStats(calc);
+		// disable red LED for last result, user wants to use what's left
+		calc->overflow_stat.fields.result = 0;
+		return;
+	}
+
+	// a different field or layout was selected
+	calc->field_entry = 0;
+	calc->preview_dirty = 1;
+}
+
+/**
+ * Turns splitting the current operand into fields on or off, keeping the last layout.
+ * The word size grows if needed to hold the fields.
+ */
+static void ToggleFields(struct CalcState *calc)
+{
+	if (calc->field_on) {
+		CloseViews(calc);
+		return;
+	}
+
+	// the fields take over the LCD from the other modes
+	LeaveModes(calc);
+	calc->field_on = 1;
+	calc->field_idx = 0;
+	calc->field_entry = 0;
+	GrowWordBits(calc, Bitfield_GetWidth(Bitfield_GetLayout(calc->field_layout)));
+	ResetLcd(calc);
+}
+
+/** Writes the expression of sweep mode to the first line of the LCD, with constants in the numerical base. */
+static void WriteSweepExprLcd(struct CalcState *calc)
+{
+	char *lcd = calc->lcd_text[0];
+	memset(lcd, ' ', LCD_BUFFER_STRLEN);
+	// only the end of a long expression fits, where the newest operators are
+	Expr_ToStr(&calc->sweep_expr, calc->num_base, lcd, LCD_BUFFER_STRLEN);
+	SignalLcdUpdate(calc, 0);
+}
+
+/**
+ * Writes the table of sweep mode to the LCD. The first line shows x, followed by the
+ * evaluations per second of the last search if it fits, and the second line the value
+ * of the expression for x, or the target while it is typed.
+ */
+static void WriteSweepTableLcd(struct CalcState *calc)
+{
+	char* lcd[] = {calc->lcd_text[0], calc->lcd_text[1]};
+
+	lcd[0][0] = 'x';
+	NumToStr(calc, calc->sweep_x, calc->num_base, lcd[0] + 1, LCD_BUFFER_STRLEN - 1);
+	if (calc->sweep_rate) {
+		// thousands of evaluations per second, such as "950k/s", right-aligned
+		uint32_t const rate = (calc->sweep_rate + 500) / 1000;
+		uint8_t const digits = Radix_CountDigits(rate, 10);
+		uint8_t const rate_len = digits + 3;
+		if (1 + NumFieldLen(calc, calc->num_base) + 1 + rate_len <= LCD_BUFFER_STRLEN) {
+			char *str = lcd[0] + LCD_BUFFER_STRLEN - rate_len;
+			Radix_ToStr(rate, 10, str, digits);
+			memcpy(str + digits, "k/s", 3);
+		}
+	}
+	SignalLcdUpdate(calc, 0);
+
+	uint32_t value;
+	if (calc->sweep_not_found) {
+		WriteMsgLcd(calc, 1, "not found");
+	} else if (calc->sweep_target_entry) {
+		lcd[1][0] = '?';
+		NumToStr(calc, calc->sweep_target, calc->num_base, lcd[1] + 1, LCD_BUFFER_STRLEN - 1);
+		SignalLcdUpdate(calc, 1);
+	} else if (!Expr_Eval(&calc->sweep_expr, calc->sweep_x, calc->word_bits, &value)) {
+		WriteMsgLcd(calc, 1, "Err: div by 0");
+	} else {
+		lcd[1][0] = '=';
+		NumToStr(calc, value, calc->num_base, lcd[1] + 1, LCD_BUFFER_STRLEN - 1);
+		SignalLcdUpdate(calc, 1);
+	}
+}
+
+/**
+ * Searches for the next x after the one shown whose value is the target, trying every
+ * x in the word or SWEEP_SEARCH_LEN of them, whichever is fewer. Shows the x found, or the
+ * last x tried if none was, and hands the number of evaluations to the caller to time.
+ */
+static void RunSweepSearch(struct CalcState *calc)
+{
+	uint32_t const count = (calc->word_mask < SWEEP_SEARCH_LEN) ? calc->word_mask + 1 : SWEEP_SEARCH_LEN;
+	uint32_t const start = (calc->sweep_x + 1) & calc->word_mask;
+	uint8_t found;
+
+	uint32_t x = Expr_Search(&calc->sweep_expr, start, count, calc->word_bits, calc->sweep_target, &found);
+
+	uint32_t evals = count;
+	if (found) {
+		evals = ((x - start) & calc->word_mask) + 1;
+	} else {
+		// the next search goes on from the x after the last one tried
+		x = (x - 1) & calc->word_mask;
+	}
+	calc->delta.sweep_evals = evals;
+
+	calc->sweep_x = x;
+	calc->sweep_not_found = !found;
+	calc->sweep_target_entry = 0;
+	calc->preview_dirty = 1;
+}
+
+/**
+ * Reads the buttons and keypad in the table of sweep mode.
+ * L and R step x by one and U and D by a page, the keypad types the target, and C
+ * searches for it. While typing the target, L deletes a digit and R clears it.
+ */
+static void ProcessSweepTableInput(struct CalcState *calc)
+{
+	uint32_t x = calc->sweep_x;
+
+	if (GetNewBtn(calc, BTN_C_BIT)) {
+		RunSweepSearch(calc);
+		return;
+	} else if (IsNewKey(calc)) {
+		int8_t const key = GetKey(calc);
+		// the first digit replaces the last target, and the next ones are appended
+		uint32_t target = calc->sweep_target_entry ? calc->sweep_target : 0;
+		if (key < 0 || !Radix_AppendDigit(&target, calc->num_base, key, calc->word_mask) || !FitsLcd(calc, target, calc->num_base)) {
+			return;
+		}
+		calc->sweep_target = target;
+		calc->sweep_target_entry = 1;
+	} else if (calc->sweep_target_entry && GetNewBtn(calc, BTN_R_BIT)) {
+		// clear the target, then show the value again
+		if (calc->sweep_target) {
+			calc->sweep_target = 0;
+		} else {
+			calc->sweep_target_entry = 0;
+		}
+	} else if (calc->sweep_target_entry && GetNewBtn(calc, BTN_L_BIT)) {
+		uint8_t digit;
+		calc->sweep_target = Radix_DivMod(calc->sweep_target, calc->num_base, &digit);
+	} else {
+		if (GetNewBtn(calc, BTN_L_BIT)) {
+			--x;
+		} else if (GetNewBtn(calc, BTN_R_BIT)) {
+			++x;
+		} else if (GetNewBtn(calc, BTN_U_BIT)) {
+			x += SWEEP_PAGE;
+		} else if (GetNewBtn(calc, BTN_D_BIT)) {
+			x -= SWEEP_PAGE;
+		} else {
+			return;
+		}
+		// wrap around the word
+		calc->sweep_x = x & calc->word_mask;
+	}
+
+	calc->sweep_not_found = 0;
+	calc->preview_dirty = 1;
+}
+
+/**
+ * Reads the C button and keypad while building the expression of sweep mode.
+ * C applies the operator to the expression with the operand as its right side.
+ */
+static void ProcessSweepExprInput(struct CalcState *calc)
+{
+	if (GetNewBtn(calc, BTN_C_BIT)) {
+		if (!Expr_AppendBinary(&calc->sweep_expr, expr_ops[calc->operator], calc->nums[1])) {
+			ShowError(calc, "Err: expr full");
+			return;
+		}
+		calc->preview_dirty = 1;
+		// start the next operand
+		SetNum(calc, 1, 0);
+		UpdateOvfStats(calc);
+	} else if (IsNewKey(calc)) {
+		// user submitted another digit
+		int8_t const key = GetKey(calc);
+		if (key >= 0) {
+			ProcessKey(calc, key);
+		}
+	}
+}
+
+/** Applies a unary operator to the expression of sweep mode. */
+static void AppendSweepUnaryOp(struct CalcState *calc, enum Operator op)
+{
+	if (!Expr_AppendUnary(&calc->sweep_expr, expr_ops[op])) {
+		ShowError(calc, "Err: expr full");
+		return;
+	}
+	calc->preview_dirty = 1;
+}
+
+/**
+ * Steps sweep mode: the first press starts building an expression of x, the second
+ * shows it as a table of x and its value, and the third leaves sweep mode.
+ */
+static void CycleSweep(struct CalcState *calc)
+{
+	if (calc->sweep_state == SweepOff) {
+		// sweep mode takes over the LCD from the other modes
+		LeaveModes(calc);
+		calc->sweep_state = SweepExpr;
+		Expr_Init(&calc->sweep_expr);
+		// the operand to apply is typed on the second line
+		ResetNums(calc);
+	} else if (calc->sweep_state == SweepExpr) {
+		calc->sweep_state = SweepTable;
+		calc->sweep_x = 0;
+		calc->sweep_target = 0;
+		calc->sweep_target_entry = 0;
+		calc->sweep_not_found = 0;
+		calc->sweep_rate = 0;
+	} else {
+		CloseViews(calc);
+		return;
+	}
+	ResetLcd(calc);
+}
+
+/** Toggles between standard and RPN mode, clearing all input. */
+static void ToggleRpn(struct CalcState *calc)
+{
+	calc->calc_mode = (calc->calc_mode == Rpn) ? Standard : Rpn;
+	ResetNums(calc);
+	ResetLcd(calc);
+}
+
+/** Shows the operation of age hist_age from the history on the LCD. */
+static void ShowHistoryEntry(struct CalcState *calc)
+{
+	struct HistoryEntry entry;
+	if (!History_Get(&calc->history, calc->hist_age, &entry)) {
+		return;
+	}
+
+	char* lcd[] = {calc->lcd_text[0], calc->lcd_text[1]};
+
+	// the first line shows the result, the second the operator and its operand
+	uint32_t const operand = (entry.op >= Popcount) ? entry.lhs : entry.rhs;
+	if (entry.is_err) {
+		WriteMsgLcd(calc, 0, "Err: div by 0");
+	} else {
+		lcd[0][0] = '=';
+		NumToStr(calc, entry.result, entry.base, lcd[0] + 1, LCD_BUFFER_STRLEN - 1);
+		SignalLcdUpdate(calc, 0);
+	}
+	lcd[1][0] = operators[entry.op];
+	NumToStr(calc, operand, entry.base, lcd[1] + 1, LCD_BUFFER_STRLEN - 1);
+	SignalLcdUpdate(calc, 1);
+}
+
+/** Stops showing the history or macro information, restoring the operands on the LCD. */
+static void CloseHistory(struct CalcState *calc)
+{
+	calc->hist_viewing = 0;
+	calc->macro_viewing = 0;
+	ResetLcd(calc);
+	// ResetLcd only writes the second operand in RPN mode
+	calc->num_updated[1] = calc->num_idx;
+}
+
+/**
+ * Reads taps of the L and R buttons and scrolls through the history.
+ * L shows older operations, and R newer ones until the operands are shown again.
+ */
+static void ProcessHistoryScroll(struct CalcState *calc)
+{
+	// buttons held for a page of functions don't scroll when released
+	uint8_t const tapped = ~calc->fn_btn_used;
+	if (GetReleasedBtn(calc, BTN_L_BIT) && (tapped & BTN_L_MASK)) {
+		if (!calc->hist_viewing) {
+			// start with the newest operation
+			if (History_GetCount(&calc->history)) {
+				calc->hist_viewing = 1;
+				calc->hist_age = 0;
+				ShowHistoryEntry(calc);
+			}
+		} else if (calc->hist_age + 1 < History_GetCount(&calc->history)) {
+			++calc->hist_age;
+			ShowHistoryEntry(calc);
+		}
+	} else if (GetReleasedBtn(calc, BTN_R_BIT) && (tapped & BTN_R_MASK) && calc->hist_viewing) {
+		if (calc->hist_age) {
+			--calc->hist_age;
+			ShowHistoryEntry(calc);
+		} else {
+			CloseHistory(calc);
+		}
+	}
+}
+
+/** Reads taps of the U and D buttons in the Fn layer, stepping the radix up or down by one. */
+static void ProcessRadixStep(struct CalcState *calc)
+{
+	// buttons held for a page of functions don't step when released
+	uint8_t const tapped = ~calc->fn_btn_used;
+	uint8_t base = calc->num_base;
+	if (GetReleasedBtn(calc, BTN_U_BIT) && (tapped & BTN_U_MASK)) {
+		base = (base == RADIX_MAX) ? RADIX_MIN : base + 1;
+	} else if (GetReleasedBtn(calc, BTN_D_BIT) && (tapped & BTN_D_MASK)) {
+		base = (base == RADIX_MIN) ? RADIX_MAX : base - 1;
+	} else {
+		return;
+	}
+
+	if (calc->hist_viewing || calc->macro_viewing) {
+		// the operands are shown in the new base
+		CloseHistory(calc);
+	}
+	calc->num_base = base;
+	UpdateNumBase(calc);
+}
+
+/** Gets the part of the state kept in the journal. */
+static void GetJournalState(struct CalcState *calc, struct JournalState *state)
+{
+	memcpy(state->nums, calc->nums, sizeof(calc->nums));
+	state->num_idx = calc->num_idx;
+	state->op = calc->operator;
+	state->base = calc->num_base;
+	state->ovf = calc->overflow_stat.is_ovf;
+}
+
+/** Adds the change to the state since the newest change in the journal, if any. */
+static void RecordChange(struct CalcState *calc)
+{
+	struct JournalState state;
+	GetJournalState(calc, &state);
+	Journal_Record(&calc->journal, &calc->journal_state, &state);
+	calc->journal_state = state;
+}
+
+/**
+ * Undoes the newest change from the journal, or redoes the last undone one.
+ * Only the operands that changed are rewritten, unless the operator, base, or
+ * current operand changed, which rewrites the LCD.
+ */
+static void RestoreChange(struct CalcState *calc, uint8_t redo)
+{
+	// changes made since the last loop are undone first
+	RecordChange(calc);
+	struct JournalState state = calc->journal_state;
+	if (!(redo ? Journal_Redo(&calc->journal, &state) : Journal_Undo(&calc->journal, &state))) {
+		return;
+	}
+
+	for (uint8_t i = 0; i < 2; ++i) {
+		// the word size isn't journaled, and may have shrunk since the change
+		uint32_t const num = state.nums[i] & calc->word_mask;
+		if (calc->nums[i] != num) {
+			calc->nums[i] = num;
+			calc->num_updated[i] = 1;
+		}
+	}
+	calc->overflow_stat.is_ovf = state.ovf;
+	if (calc->num_idx != state.num_idx || calc->operator != state.op || calc->num_base != state.base) {
+		calc->num_idx = state.num_idx;
+		calc->operator = state.op;
+		calc->num_base = state.base;
+		ResetLcd(calc);
+		// ResetLcd only writes the second operand in RPN mode
+		calc->num_updated[1] = calc->num_idx;
+	}
+	// the operands' flags were journaled for the word size at the time
+	UpdateOvfStats(calc);
+	// the journal goes on from the state as restored, so the masking and
+	// flags aren't recorded as a change, which would drop the redos
+	GetJournalState(calc, &calc->journal_state);
+
+	if (calc->calc_mode == Rpn) {
+		// the restored X is kept, and pushed by the next entry like a recalled one
+		calc->rpn_entry = 0;
+		calc->rpn_lift = 1;
+	}
+}
+
+/**
+ * Reads taps of the C button in the Fn layer, undoing the newest change,
+ * or redoing the last undone change if R is held.
+ */
+static void ProcessUndoTap(struct CalcState *calc)
+{
+	// buttons held for a page of functions don't undo when released
+	uint8_t const tapped = ~calc->fn_btn_used;
+	if (!GetReleasedBtn(calc, BTN_C_BIT) || !(tapped & BTN_C_MASK)) {
+		return;
+	}
+
+	if (calc->hist_viewing || calc->macro_viewing) {
+		// the change is shown on the operands
+		CloseHistory(calc);
+	}
+	if (GetBtn(calc, BTN_R_BIT)) {
+		// R was held for the redo, so releasing it doesn't scroll the history
+		calc->fn_btn_used |= BTN_R_MASK;
+		RestoreChange(calc, 1);
+	} else {
+		RestoreChange(calc, 0);
+	}
+}
+
+/** Switches to the next word size, truncating the operands to fit. */
+static void CycleWordSize(struct CalcState *calc)
+{
+	uint8_t i = 0;
+	while (i < sizeof(word_sizes) - 1 && word_sizes[i] != calc->word_bits) {
+		++i;
+	}
+	if (++i == sizeof(word_sizes)) {
+		i = 0;
+	}
+	SetWordBits(calc, word_sizes[i]);
+
+	// the digit fields changed width, so rewrite the operands
+	UpdateNumBase(calc);
+	// disable red LED for last result, it may not overflow anymore
+	calc->overflow_stat.fields.result = 0;
+}
+
+/**
+ * Switches to the next division mode: quotient, quotient and remainder, then fixed-point
+ * with a quarter, half, and three quarters of the word as fraction bits.
+ */
+static void CycleDivMode(struct CalcState *calc)
+{
+	if (calc->div_mode == DivFixed && calc->fixed_quarters < 3) {
+		++calc->fixed_quarters;
+	} else if (calc->div_mode == DivFixed) {
+		calc->div_mode = DivQuot;
+	} else if (++calc->div_mode == DivFixed) {
+		calc->fixed_quarters = 1;
+	}
+	UpdateDigitFields(calc);
+
+	// the operands are shown with or without fraction digits
+	UpdateNumBase(calc);
+	calc->preview_dirty = 1;
+	// disable red LED for last result, user wants to use what's left
+	calc->overflow_stat.fields.result = 0;
+}
+
+/** Runs a memory operation between a memory register and the current operand. */
+static void RunMemOp(struct CalcState *calc, enum MemOp op, uint8_t reg)
+{
+	uint32_t const num = calc->nums[calc->num_idx];
+	uint8_t div_0_err;
+	uint64_t result;
+
+	switch (op) {
+		case MemStore:
+			calc->mem_regs[reg] = num;
+			return;
+		case MemAdd:
+		case MemSub:
+			result = ApplyOp(calc, op == MemAdd ? Add : Sub, calc->mem_regs[reg], num, &div_0_err);
+			calc->mem_regs[reg] = result & calc->word_mask;
+			// signal if the register overflowed
+			calc->overflow_stat.fields.result = IsResultOvf(calc, result);
+			return;
+		case MemRecall:
+		case MemSwap:
+			break;
+	}
+
+	if (calc->calc_mode == Rpn) {
+		// recalling terminates any entry, pushing X like a new entry would
+		if (op == MemRecall && (calc->rpn_entry || calc->rpn_lift)) {
+			RpnLift(calc);
+		}
+		calc->rpn_entry = 0;
+		calc->rpn_lift = 1;
+	}
+
+	// load the register directly into the current operand
+	SetNum(calc, calc->num_idx, calc->mem_regs[reg]);
+	if (op == MemSwap) {
+		calc->mem_regs[reg] = num;
+	}
+
+	// update the overflow status for the loaded operand
+	UpdateOvfStats(calc);
+	// disable red LED for last result, user wants to use what's left
+	calc->overflow_stat.fields.result = 0;
+}
+
+/**
+ * Starts recording a macro into a slot, or stops recording.
+ * Keys without a slot only stop recording.
+ */
+static void RecordMacro(struct CalcState *calc, uint8_t slot)
+{
+	if (calc->event.macros.recording) {
+		RequestMacro(calc, CalcMacroStop, slot);
+	} else {
+		RequestMacro(calc, CalcMacroRecord, slot);
+	}
+}
+
+/** Replays the macro in a slot on the current operands, or stops recording. */
+static void PlayMacro(struct CalcState *calc, uint8_t slot)
+{
+	if (calc->event.macros.recording) {
+		RequestMacro(calc, CalcMacroStop, slot);
+	} else {
+		RequestMacro(calc, CalcMacroPlay, slot);
+	}
+}
+
+/**
+ * Shows the number of input steps in the macro in a slot on the first line, and
+ * the steps per second of the last replay on the second line.
+ */
+static void ShowMacroInfo(struct CalcState *calc, uint8_t slot)
+{
+	if (slot >= MACRO_SLOT_COUNT) {
+		return;
+	}
+	char* lcd[] = {calc->lcd_text[0], calc->lcd_text[1]};
+	memset(lcd[0], ' ', LCD_BUFFER_STRLEN);
+	memset(lcd[1], ' ', LCD_BUFFER_STRLEN);
+
+	// such as "M2 14 steps"
+	uint8_t const len = calc->event.macros.lens[slot];
+	uint8_t digits = Radix_CountDigits(len, 10);
+	lcd[0][0] = 'M';
+	lcd[0][1] = Radix_DigitToChar(slot);
+	Radix_ToStr(len, 10, lcd[0] + 3, digits);
+	memcpy(lcd[0] + 3 + digits + 1, "steps", 5);
+
+	uint32_t const rate = calc->event.macros.replay_rate;
+	if (rate) {
+		digits = Radix_CountDigits(rate, 10);
+		Radix_ToStr(rate, 10, lcd[1], digits);
+		if (digits + 8 <= LCD_BUFFER_STRLEN) {
+			memcpy(lcd[1] + digits, " steps/s", 8);
+		} else {
+			memcpy(lcd[1] + digits, "/s", 2);
+		}
+	}
+
+	calc->macro_viewing = 1;
+	SignalLcdUpdate(calc, 0);
+	SignalLcdUpdate(calc, 1);
+}
+
+/**
+ * Reads the keypad and runs the selected function.
+ * The buttons held while pressing the key select the page of functions.
+ */
+static void ProcessFunctionKey(struct CalcState *calc)
+{
+	if (!IsNewKey(calc)) {
+		return;
+	}
+	int8_t const key = GetKey(calc);
+	if (key < 0) {
+		return;
+	}
+
+	if (calc->hist_viewing || calc->macro_viewing) {
+		// functions work on the operands, so show them again
+		CloseHistory(calc);
+	}
+
+	uint8_t const btn = GetBtnGroup(calc);
+	calc->fn_btn_used |= btn;
+	switch (btn) {
+		case 0:
+			// no buttons held, run the function for the key
+			break;
+		case BTN_U_MASK:
+			RunMemOp(calc, MemStore, key);
+			return;
+		case BTN_D_MASK:
+			RunMemOp(calc, MemRecall, key);
+			return;
+		case BTN_R_MASK:
+			RunMemOp(calc, MemAdd, key);
+			return;
+		case BTN_L_MASK:
+			RunMemOp(calc, MemSub, key);
+			return;
+		case BTN_U_MASK | BTN_D_MASK:
+			RunMemOp(calc, MemSwap, key);
+			return;
+		case BTN_C_MASK | BTN_U_MASK:
+			RecordMacro(calc, key);
+			return;
+		case BTN_C_MASK:
+			PlayMacro(calc, key);
+			return;
+		case BTN_C_MASK | BTN_D_MASK:
+			ShowMacroInfo(calc, key);
+			return;
+		default:
+			// no page for these buttons
+			return;
+	}
+
+	switch (key) {
+		case FnRpn:
+			ToggleRpn(calc);
+			break;
+		case FnPreview:
+			calc->preview_on = !calc->preview_on;
+			calc->preview_dirty = 1;
+			// rewrite the second operand to add or remove the preview
+			calc->num_updated[1] = calc->num_idx;
+			break;
+		case FnPopcount:
+		case FnClz:
+		case FnClo:
+		case FnCtz:
+		case FnParity:
+		case FnBitReverse:
+		case FnByteSwap:
+			if (calc->sweep_state == SweepExpr) {
+				// the function applies to the expression instead
+				AppendSweepUnaryOp(calc, Popcount + (key - FnPopcount));
+			} else if (calc->sweep_state == SweepOff) {
+				RunUnaryOp(calc, Popcount + (key - FnPopcount));
+			}
+			break;
+		case FnBitEdit:
+			if (calc->ieee_on || calc->field_on || calc->sweep_state) {
+				// the bits are edited on the operands' lines
+				CloseViews(calc);
+			}
+			SetBitEdit(calc, !calc->bit_edit);
+			break;
+		case FnWordSize:
+			CycleWordSize(calc);
+			break;
+		case FnDivMode:
+			CycleDivMode(calc);
+			break;
+		case FnChecksum:
+			CycleChecksum(calc);
+			break;
+		case FnIeee:
+			CycleIeee(calc);
+			break;
+		case FnFields:
+			ToggleFields(calc);
+			break;
+		case FnSweep:
+			CycleSweep(calc);
+			break;
+	}
+}
+
+/** Runs the calculator on the input event in its state. */
+static void ProcessInput(struct CalcState *calc)
+{
+	// process changes to the operator
+	ProcessOperator(calc);
+
+	if (calc->is_err) {
+		// last operation was an error, check for clear
+		if (!CheckForClear(calc)) {
+			// user hasn't cleared yet, leave early
+			return;
+		} else if (calc->calc_mode == Rpn) {
+			// the clear press only clears the error, the stack is kept
+			return;
+		}
+	}
+
+	if (GetSwt(calc, FN_SWT_BIT)) {
+		// the keypad selects functions instead of digits, and button taps
+		// scroll through the history or step the radix
+		ProcessFunctionKey(calc);
+		ProcessHistoryScroll(calc);
+		ProcessRadixStep(calc);
+		ProcessUndoTap(calc);
+		// forget the buttons that were released
+		calc->fn_btn_used &= GetBtnGroup(calc);
+	} else {
+		calc->fn_btn_used = 0;
+
+		if (calc->hist_viewing || calc->macro_viewing) {
+			// left the Fn layer, show the operands again
+			CloseHistory(calc);
+		}
+
+		if (calc->ieee_on) {
+			// the buttons and keypad edit the fields of the floating-point number,
+			// and U and D still change the base the fields are shown in
+			ProcessNumBase(calc);
+			ProcessIeeeInput(calc);
+		} else if (calc->field_on) {
+			// the buttons and keypad select and edit the fields of the operand
+			ProcessFieldInput(calc);
+		} else if (calc->sweep_state == SweepTable) {
+			// the buttons and keypad move through the table and search it
+			ProcessSweepTableInput(calc);
+		} else if (calc->bit_edit) {
+			// the buttons and keypad edit bits until the edit ends;
+			// operator switches still apply in RPN mode
+			if (calc->calc_mode != Rpn || !ProcessRpnOperator(calc)) {
+				ProcessBitEdit(calc);
+			}
+		} else {
+			// process changes to the numerical base or clear/backspace
+			ProcessNumBase(calc);
+			ProcessClearBackspace(calc);
+
+			// process new input
+			if (calc->checksum_on) {
+				ProcessChecksumInput(calc);
+			} else if (calc->sweep_state == SweepExpr) {
+				ProcessSweepExprInput(calc);
+			} else if (calc->calc_mode == Rpn) {
+				ProcessRpnInput(calc);
+			} else {
+				ProcessStdInput(calc);
+			}
+		}
+	}
+
+	// add any change to the journal, so it can be undone
+	RecordChange(calc);
+
+	// update the LCD output, only for the operands that changed
+	for (int i = 0; i < sizeof(calc->nums) / sizeof(*calc->nums); ++i) {
+		if (calc->num_updated[i]) {
+			WriteNumLcd(calc, i);
+			calc->num_updated[i] = 0;
+			calc->preview_dirty = 1;
+		}
+	}
+
+	// only recompute the preview if its inputs changed
+	if (calc->preview_dirty) {
+		UpdatePreview(calc);
+	}
+
+	// update the RGB LED
+	uint8_t const is_red = !!(calc->overflow_stat.is_ovf);
+	SetRgbColor(calc, 0x1F * is_red, 0, 0);
+}
+
+void Calc_Step(struct CalcState *calc, struct CalcEvent const *event, struct CalcDelta *delta)
+{
+	calc->event = *event;
+	// the rate of a search comes in the step after it, once the caller has timed it
+	if (calc->event.sweep_rate != calc->sweep_rate) {
+		calc->sweep_rate = calc->event.sweep_rate;
+		calc->preview_dirty |= (calc->sweep_state == SweepTable);
+	}
+	ProcessInput(calc);
+
+	// hand over what changed, and start over for the next step
+	*delta = calc->delta;
+	memset(&calc->delta, 0, sizeof(calc->delta));
+}
+
+void Calc_SetFormat(struct CalcState *calc, uint8_t word_bits, enum DivMode div_mode, uint8_t fixed_quarters, uint8_t base)
+{
+	calc->div_mode = div_mode;
+	calc->fixed_quarters = fixed_quarters;
+	SetWordBits(calc, word_bits);
+	calc->num_base = base;
+	UpdateNumBase(calc);
+}
+
+uint32_t Calc_RunOp(struct CalcState *calc, enum Operator op, uint32_t lhs, uint32_t rhs, uint8_t *is_ovf, uint8_t *div_0_err)
+{
+	// the same as RunOp, which also writes the result and flags to the LCD and history
+	uint64_t const num = ApplyOp(calc, op, lhs, rhs, div_0_err);
+	*is_ovf = !*div_0_err && IsResultOvf(calc, num);
+	return num & calc->word_mask;
+}
+
+void Calc_NumToStr(struct CalcState *calc, uint32_t num, uint8_t base, char *str, uint8_t len)
+{
+	NumToStr(calc, num, base, str, len);
+}
+
+/** Updates an operand based on the given keypress. */
+static void ProcessKey(struct CalcState *calc, uint8_t key)
+{
+	uint32_t num = calc->nums[calc->num_idx];
+	// only accept the digit if it's valid for the base and the operand still
+	// fits in the word and on the LCD
+	if (Radix_AppendDigit(&num, calc->num_base, key, calc->word_mask) && FitsLcd(calc, num, calc->num_base)) {
+		calc->nums[calc->num_idx] = num;
+		// update the num output
+		calc->num_updated[calc->num_idx] = 1;
+	}
+}
+
+/**
+ * Divides two numbers, returning the quotient and setting rem to the remainder
+ * from the same division.
+ */
+static uint32_t DivMod(uint32_t lhs, uint32_t rhs, uint32_t *rem)
+{
+	uint32_t quot;
+#if defined(__mips__)
+	// divu leaves the quotient in LO and the remainder in HI
+	asm("divu $0, %2, %3\n\tmflo %0\n\tmfhi %1" : "=r"(quot), "=r"(*rem) : "r"(lhs), "r"(rhs) : "hi", "lo");
+#else
+	quot = lhs / rhs;
+	// the compiler takes the remainder from the same division
+	*rem = lhs % rhs;
+#endif
+	return quot;
+}
+
+/**
+ * Applies an operator to two operands, returning the untruncated result.
+ * Unary operators only use the first operand.
+ * Sets div_0_err if the operation divides by 0.
+ */
+static uint64_t ApplyOp(struct CalcState *calc, enum Operator op, uint32_t lhs, uint32_t rhs, uint8_t *div_0_err)
+{
+	uint64_t num = 0;
+	*div_0_err = 0;
+
+	// run the operation
+	switch (op) {
+		case Add:
+			num = (uint64_t)lhs + rhs;
+			break;
+		case Sub:
+			// a negative result wraps to beyond the word, which is an overflow
+			num = (uint64_t)lhs - rhs;
+			break;
+		case Mult:
+			// a fixed-point product has twice the fraction bits
+			num = ((uint64_t)lhs * rhs) >> calc->frac_bits;
+			break;
+		case Div:
+			// check for divide by 0
+			if (rhs == 0) {
+				*div_0_err = 1;
+			} else if (calc->frac_bits) {
+				// scale up the dividend to keep the fraction bits of the quotient
+				num = ((uint64_t)lhs << calc->frac_bits) / rhs;
+			} else {
+				num = DivMod(lhs, rhs, &calc->div_rem);
+			}
+			break;
+		case And:
+			num = lhs & rhs;
+			break;
+		case Or:
+			num = lhs | rhs;
+			break;
+		case Xor:
+			num = lhs ^ rhs;
+			break;
+		case Popcount:
+			num = Bits_Popcount(lhs);
+			break;
+		case Clz:
+			num = Bits_Clz(lhs, calc->word_bits);
+			break;
+		case Clo:
+			num = Bits_Clo(lhs, calc->word_bits);
+			break;
+		case Ctz:
+			num = Bits_Ctz(lhs, calc->word_bits);
+			break;
+		case Parity:
+			num = Bits_Parity(lhs);
+			break;
+		case BitReverse:
+			num = Bits_Reverse(lhs, calc->word_bits);
+			break;
+		case ByteSwap:
+			num = Bits_ByteSwap(lhs, calc->word_bits);
+			break;
+	}
+
+	return num;
+}
+
+/** Returns whether a result overflows the operand or the LCD. */
+static uint8_t IsResultOvf(struct CalcState *calc, uint64_t num)
+{
+	return num > calc->word_mask || !FitsLcd(calc, num, calc->num_base);
+}
+
+/** Adds an operation to the history. */
+static void RecordOp(struct CalcState *calc, uint32_t lhs, uint32_t rhs, enum Operator op, uint64_t num, uint8_t div_0_err)
+{
+	struct HistoryEntry const entry = {
+		.lhs = lhs,
+		.rhs = rhs,
+		.result = num & calc->word_mask,
+		.op = op,
+		.base = calc->num_base,
+		.is_err = div_0_err
+	};
+	History_Push(&calc->history, &entry);
+}
+
+/**
+ * Previews the result of the pending operation at the end of the second line,
+ * the checksum in checksum mode, the operand as a floating-point number or fields,
+ * or the expression or table in sweep mode.
+ */
+static void UpdatePreview(struct CalcState *calc)
+{
+	calc->preview_dirty = 0;
+	calc->preview_valid = 0;
+
+	if (calc->ieee_on) {
+		WriteIeeeLcd(calc);
+		return;
+	} else if (calc->field_on) {
+		WriteFieldsLcd(calc);
+		return;
+	} else if (calc->sweep_state == SweepExpr) {
+		WriteSweepExprLcd(calc);
+		return;
+	} else if (calc->sweep_state == SweepTable) {
+		WriteSweepTableLcd(calc);
+		return;
+	} else if (calc->checksum_on) {
+		// the pending operation feeds the operand into the checksum
+		WriteChecksumLcd(calc);
+		return;
+	}
+
+	// there is only room for a preview if the operand fits before it,
+	// so not for bit edits or long binary operands
+	if (!calc->preview_on || calc->calc_mode != Standard || calc->num_idx == 0 || calc->bit_edit
+		|| 1 + NumFieldLen(calc, calc->num_base) > PREVIEW_COL) {
+		return;
+	}
+
+	calc->preview_num = ApplyOp(calc, calc->operator, calc->nums[0], calc->nums[1], &calc->preview_div_0_err);
+	calc->preview_rem = calc->div_rem;
+	calc->preview_valid = 1;
+
+	char *lcd = calc->lcd_text[1] + PREVIEW_COL;
+	size_t const len = LCD_BUFFER_STRLEN - PREVIEW_COL;
+	if (calc->preview_div_0_err) {
+		memset(lcd, ' ', len);
+		memcpy(lcd, "!Err", 4);
+	} else {
+		// '!' instead of '=' predicts an overflow
+		lcd[0] = IsResultOvf(calc, calc->preview_num) ? '!' : '=';
+		NumToStr(calc, calc->preview_num, calc->num_base, lcd + 1, len - 1);
+	}
+	SignalLcdUpdate(calc, 1);
+}
+
+/**
+ * Runs the arithmetic operation on the inputs.
+ */
+static void RunOp(struct CalcState *calc)
+{
+	uint8_t div_0_err;
+	uint64_t num;
+	uint32_t rem;
+
+	// the operator, operands, or base may have changed earlier in this step,
+	// after the preview was last computed
+	uint8_t const preview_valid = calc->preview_valid && !calc->preview_dirty
+		&& !calc->num_updated[0] && !calc->num_updated[1];
+	if (preview_valid) {
+		// the preview is up to date, reuse its result
+		num = calc->preview_num;
+		rem = calc->preview_rem;
+		div_0_err = calc->preview_div_0_err;
+	} else {
+		num = ApplyOp(calc, calc->operator, calc->nums[0], calc->nums[1], &div_0_err);
+		rem = calc->div_rem;
+	}
+	RecordOp(calc, calc->nums[0], calc->nums[1], calc->operator, num, div_0_err);
+
+	// the remainder replaces the second line
+	uint8_t const show_rem = (calc->operator == Div && calc->div_mode == DivRem);
+
+	if (preview_valid && !div_0_err && !show_rem) {
+		// the second line already shows the operation and its result, so
+		// leave it there and only write the result to the first line
+		ResetNums(calc);
+		calc->nums[0] = num & calc->word_mask;
+		calc->num_updated[0] = 1;
+		UpdateOvfStats(calc);
+		calc->overflow_stat.fields.result = IsResultOvf(calc, num);
+		return;
+	}
+
+	// reset operands and clear screen
+	ResetNums(calc);
+	ResetLcd(calc);
+
+	// set output
+	if (div_0_err) {
+		// output an error to the LCD
+		ShowError(calc, "Err: div by 0");
+	} else {
+		// output the result
+		calc->nums[0] = num & calc->word_mask;
+		calc->num_updated[0] = 1;
+		if (show_rem) {
+			WriteRemLcd(calc, rem);
+		}
+
+		// set the overflow status
+		UpdateOvfStats(calc);
+		calc->overflow_stat.fields.result = IsResultOvf(calc, num);
+	}
+}
+
+/**
+ * Runs the arithmetic operation on the Y and X levels of the RPN stack.
+ */
+static void RunRpnOp(struct CalcState *calc)
+{
+	uint8_t div_0_err;
+	uint64_t const num = ApplyOp(calc, calc->operator, calc->nums[0], calc->nums[1], &div_0_err);
+	RecordOp(calc, calc->nums[0], calc->nums[1], calc->operator, num, div_0_err);
+
+	if (div_0_err) {
+		// output an error to the LCD, leaving the stack as it was
+		ShowError(calc, "Err: div by 0");
+		return;
+	}
+
+	if (calc->operator == Div && calc->div_mode == DivRem) {
+		// Y and X are replaced by the quotient and remainder
+		SetNum(calc, 0, num);
+		SetNum(calc, 1, calc->div_rem);
+	} else {
+		// Y and X are replaced by the result
+		RpnDrop(calc);
+		SetNum(calc, 1, num);
+	}
+	// the next entry pushes the result
+	calc->rpn_entry = 0;
+	calc->rpn_lift = 1;
+
+	// set the overflow status
+	UpdateOvfStats(calc);
+	calc->overflow_stat.fields.result = IsResultOvf(calc, num);
+}
+
+/** Updates the current operand's overflow status. */
+static void UpdateOvfStats(struct CalcState *calc)
+{
+	// signal overflow if an operand has more digits than fit on the LCD,
+	// such as a 16-bit operand in binary
+	calc->overflow_stat.fields.num1 = !FitsLcd(calc, calc->nums[0], calc->num_base);
+	calc->overflow_stat.fields.num2 = !FitsLcd(calc, calc->nums[1], calc->num_base);
+}
+
+/**
+ * Writes the bits of the operand being edited onto the LCD, with the cursor glyph
+ * on the selected bit. A 32-bit word shows the half with the cursor.
+ */
+static void WriteBitsLcd(struct CalcState *calc, uint8_t idx)
+{
+	char *lcd = calc->lcd_text[idx];
+	uint32_t const num = calc->nums[idx];
+	uint8_t const count = calc->word_bits < LCD_BUFFER_STRLEN ? calc->word_bits : LCD_BUFFER_STRLEN;
+	// lowest bit shown
+	uint8_t const first = calc->bit_cursor & ~(LCD_BUFFER_STRLEN - 1);
+
+	// the bits are right-aligned, most significant on the left
+	memset(lcd, ' ', LCD_BUFFER_STRLEN - count);
+	for (uint8_t i = 0; i < count; ++i) {
+		uint8_t const bit = first + count - 1 - i;
+		uint8_t const digit = (num >> bit) & 1;
+		lcd[LCD_BUFFER_STRLEN - count + i] = (bit == calc->bit_cursor) ? LCD_GLYPH_CHAR + BIT_CURSOR_GLYPH + digit : '0' + digit;
+	}
+	SignalLcdUpdate(calc, idx);
+}
+
+/** Writes the given operand onto the LCD. */
+static void WriteNumLcd(struct CalcState *calc, uint8_t idx)
+{
+	if (calc->ieee_on || calc->field_on || calc->sweep_state == SweepTable || (calc->sweep_state == SweepExpr && idx == 0)) {
+		// the operand is shown as a floating-point number or fields, or the line shows
+		// the sweep, written with the preview
+		calc->preview_dirty = 1;
+		return;
+	} else if (calc->bit_edit && idx == calc->num_idx) {
+		WriteBitsLcd(calc, idx);
+		return;
+	}
+
+	char *lcd = calc->lcd_text[idx];
+	if ((calc->calc_mode == Standard || calc->sweep_state) && !calc->checksum_on && idx == 1) {
+		// the operator may have been replaced by a remainder
+		lcd[0] = operators[calc->operator];
+	}
+	// convert the operand to a string
+	NumToStr(calc, calc->nums[idx], calc->num_base, lcd + 1, LCD_BUFFER_STRLEN - 1);
+	// signal that we want to update this line of the LCD
+	SignalLcdUpdate(calc, idx);
+}
+
+/** Writes the remainder of a division to the second line, in place of the operator and second operand. */
+static void WriteRemLcd(struct CalcState *calc, uint32_t rem)
+{
+	char *lcd = calc->lcd_text[1];
+	lcd[0] = 'r';
+	NumToStr(calc, rem, calc->num_base, lcd + 1, LCD_BUFFER_STRLEN - 1);
+	SignalLcdUpdate(calc, 1);
+}
+
+/** Returns the length of the prefix of a numerical base. */
+static uint8_t NumPrefixLen(uint8_t base)
+{
+	switch (base) {
+		case Bin:
+			// no space for a prefix
+			return 0;
+		case Oct:
+		case Dec:
+		case Hex:
+			return 2;
+		default:
+			// the radix and a '#'
+			return (base < 10 ? 1 : 2) + 1;
+	}
+}
+
+/** Writes the prefix of a numerical base, such as "0x" for hex or "36#" for base 36. */
+static void WriteNumPrefix(uint8_t base, char *str)
+{
+	uint8_t const len = NumPrefixLen(base);
+	switch (base) {
+		case Bin:
+			break;
+		case Oct:
+			str[0] = '0';
+			str[1] = 'o';
+			break;
+		case Dec:
+			str[0] = '0';
+			str[1] = 'd';
+			break;
+		case Hex:
+			str[0] = '0';
+			str[1] = 'x';
+			break;
+		default:
+			Radix_ToStr(base, 10, str, len - 1);
+			str[len - 1] = '#';
+			break;
+	}
+}
+
+/**
+ * Returns the length of an operand on the LCD: the prefix and a field as wide as the largest operand,
+ * including the point and fraction digits in fixed-point mode.
+ */
+static uint8_t NumFieldLen(struct CalcState *calc, uint8_t base)
+{
+	uint8_t len = NumPrefixLen(base) + calc->max_digits[base];
+	if (calc->frac_bits) {
+		len += 1 + calc->frac_digits[base];
+	}
+	return len;
+}
+
+/** Returns whether every digit of a number fits on the LCD after the operator. */
+static uint8_t FitsLcd(struct CalcState *calc, uint32_t num, uint8_t base)
+{
+	uint8_t len = NumPrefixLen(base) + Radix_CountDigits(num >> calc->frac_bits, base);
+	if (calc->frac_bits) {
+		len += 1 + calc->frac_digits[base];
+	}
+	return len <= LCD_BUFFER_STRLEN - 1;
+}
+
+/** Writes the first len digits of a fixed-point fraction, truncated. */
+static void FracToStr(struct CalcState *calc, uint32_t frac, uint8_t base, char *str, uint8_t len)
+{
+	uint64_t scale = 1;
+	for (uint8_t i = 0; i < len; ++i) {
+		scale *= base;
+	}
+	// the digits of frac / 2^frac_bits are the integer part of frac * base^len / 2^frac_bits
+	uint32_t const digits = (frac * scale) >> calc->frac_bits;
+	// keep the leading zeros of the fraction
+	memset(str, '0', len);
+	Radix_ToStr(digits, base, str, len);
+}
+
+/** Converts a number to a string in the appropriate numerical base format. */
+static void NumToStr(struct CalcState *calc, uint32_t num, uint8_t base, char *str, size_t strlen)
+{
+	uint8_t const prefix_len = NumPrefixLen(base);
+	// we need to have enough space for the prefix and a digit
+	if (strlen <= prefix_len) return;
+
+	memset(str, ' ', strlen);
+	WriteNumPrefix(base, str);
+	// the digits are right-aligned in their field, unless the string isn't long enough
+	size_t const max_len = NumFieldLen(calc, base) < strlen ? NumFieldLen(calc, base) : strlen;
+	uint8_t int_len = max_len - prefix_len;
+
+	if (calc->frac_bits) {
+		// the fraction goes after the integer part; keep at least one integer digit,
+		// dropping the last fraction digits if there isn't room
+		uint8_t frac_len = calc->frac_digits[base];
+		if (int_len < 2) return;
+		if (frac_len > int_len - 2) {
+			frac_len = int_len - 2;
+		}
+		int_len -= frac_len + 1;
+
+		char *frac_str = str + prefix_len + int_len;
+		frac_str[0] = '.';
+		FracToStr(calc, num & ((1 << calc->frac_bits) - 1), base, frac_str + 1, frac_len);
+		num >>= calc->frac_bits;
+	}
+
+	Radix_ToStr(num, base, str + prefix_len, int_len);
+}
+
+// The calculator run on the input and output modules
+static struct CalcState main_calc;
+// evaluations per second of its last search of sweep mode, timed around its step
+static uint32_t sweep_rate;
+
+/** Shows what changed in a step of the calculator, and runs its macro request. */
+static void ApplyDelta(struct CalcDelta const *delta)
+{
+	for (uint8_t i = 0; i < LCD_BUFFER_COUNT; ++i) {
+		if (delta->lcd_lines & (1 << i)) {
+			memcpy(Output_GetLcdBuffer(i), main_calc.lcd_text[i], sizeof(main_calc.lcd_text[i]));
+			Output_SignalLcdUpdate(i);
+		}
+	}
+	for (uint8_t i = 0; i < LCD_GLYPH_COUNT; ++i) {
+		if (delta->glyphs & (1 << i)) {
+			Output_SetLcdGlyph(i, main_calc.glyphs[i]);
+		}
+	}
+	if (delta->rgb) {
+		Output_SetRgbColor(main_calc.rgb[0], main_calc.rgb[1], main_calc.rgb[2]);
+	}
+	if (delta->leds) {
+		LED_SetGroupValue(main_calc.leds);
+	}
+
+	switch (delta->macro_request) {
+		case CalcMacroRecord:
+			Macro_Record(delta->macro_slot);
+			break;
+		case CalcMacroPlay:
+			Macro_Play(delta->macro_slot);
+			break;
+		case CalcMacroStop:
+			Macro_Stop();
+			break;
+		default:
 			break;
 	}
 }
+
+void Calculator_Init(void)
+{
+	struct CalcDelta delta;
+	Calc_Init(&main_calc, &delta);
+	ApplyDelta(&delta);
+}
+
+void Calculator_Process(void)
+{
+	struct CalcEvent event;
+	Input_GetState(&event.input);
+	Input_GetLastState(&event.last);
+	// the macros are kept by the macro module, outside the state
+	event.macros.recording = Macro_IsRecording();
+	for (uint8_t i = 0; i < MACRO_SLOT_COUNT; ++i) {
+		event.macros.lens[i] = Macro_GetLen(i);
+	}
+	event.macros.replay_rate = Macro_GetReplayRate();
+	event.sweep_rate = sweep_rate;
+
+	struct CalcDelta delta;
+	uint32_t const start = CoreTimer_Read();
+	Calc_Step(&main_calc, &event, &delta);
+	uint32_t const ticks = CoreTimer_Read() - start;
+	if (delta.sweep_evals) {
+		// the search takes up nearly all of the step
+		sweep_rate = CoreTimer_GetRate(delta.sweep_evals, ticks);
+	}
+	ApplyDelta(&delta);
+}
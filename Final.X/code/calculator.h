@@ -1,12 +1,306 @@
 /*
  * Module to run the programmer calculator.
  *
+ * The calculator is a state and a step function, which runs it on one input event
+ * and returns what changed on the LCD and LEDs, so any number of calculators can
+ * run without the peripherals. Calculator_Process runs one on the input and output modules.
+ *
  * Author: Benjamin Hall
  * Date: 2022 September 16
  */
 
 #pragma once
 
+#include "input.h"
+#include "output.h"
+#include "history.h"
+#include "journal.h"
+#include "checksum.h"
+#include "ieee754.h"
+#include "expr.h"
+#include "radix.h"
+#include "macro.h"
+#include <stdint.h>
+
+// Depth of the RPN operand stack, including the two levels shown on the LCD
+#define RPN_STACK_DEPTH 16
+// Number of RPN stack levels kept below the LCD levels
+#define RPN_RING_LEN (RPN_STACK_DEPTH - 2)
+
+// Memory registers, one per key
+#define MEM_REG_COUNT 16
+
+// Calculator mode
+enum CalcMode {
+	Standard,
+	Rpn
+};
+
+// Fields of a floating-point number, selected with the L and R buttons
+enum IeeeField {
+	FieldSign,
+	FieldExp,
+	FieldMant,
+	IEEE_FIELD_COUNT
+};
+
+// Sweep mode, which evaluates an expression of x over a range of x
+enum SweepState {
+	SweepOff,
+	// building the expression: each operand submitted applies the operator to it
+	SweepExpr,
+	// paging through x and the value of the expression, or searching for a target value
+	SweepTable
+};
+
+// Division modes, selected with a function key
+enum DivMode {
+	// the quotient replaces the operands
+	DivQuot,
+	// the quotient is shown with the remainder
+	DivRem,
+	// the operands are fixed-point Qm.n numbers, which also scales multiplication
+	DivFixed
+};
+
+// Operator
+enum Operator {
+	Add,
+	Sub,
+	Mult,
+	Div,
+	And,
+	Or,
+	Xor,
+	// unary operators, run on the current operand with a function key
+	Popcount,
+	Clz,
+	Clo,
+	Ctz,
+	Parity,
+	BitReverse,
+	ByteSwap
+};
+
+/** The macros held by the macro module, which the calculator shows. */
+struct CalcMacroInfo {
+	// whether a macro is recording
+	uint8_t recording;
+	// number of input steps in each slot
+	uint8_t lens[MACRO_SLOT_COUNT];
+	// steps per second of the last replay, or 0 if not measured
+	uint32_t replay_rate;
+};
+
+/** An input event: a sample of the input, the sample before it, the macros, and the search rate. */
+struct CalcEvent {
+	struct InputState input;
+	struct InputState last;
+	struct CalcMacroInfo macros;
+	// evaluations per second of the last search of sweep mode, measured by the
+	// caller that ran it, or 0 if not measured
+	uint32_t sweep_rate;
+};
+
+/** What a step asks the macro module to do. */
+enum CalcMacroRequest {
+	CalcMacroNone,
+	CalcMacroRecord,
+	CalcMacroPlay,
+	CalcMacroStop
+};
+
+/** What changed in a step. The new values are in the state. */
+struct CalcDelta {
+	// a bit for each line of the LCD that changed
+	uint8_t lcd_lines;
+	// a bit for each custom glyph that changed
+	uint8_t glyphs;
+	// whether the color of the RGB LED changed
+	uint8_t rgb;
+	// whether the LEDs changed
+	uint8_t leds;
+	// what to do with a macro, and its slot
+	enum CalcMacroRequest macro_request;
+	uint8_t macro_slot;
+	// number of evaluations of the search of sweep mode run in the step, for the
+	// caller to time, or 0 if none ran
+	uint32_t sweep_evals;
+};
+
+/** The state of a calculator. */
+struct CalcState {
+	// Width of the operands in bits
+	uint8_t word_bits;
+	// Largest operand of the word size
+	uint32_t word_mask;
+
+	// Operands
+	uint32_t nums[2];
+	uint8_t num_updated[2];
+	uint8_t num_idx;
+
+	enum CalcMode calc_mode;
+
+	// RPN stack levels below Y (nums[0]) and X (nums[1]), stored as a ring
+	uint32_t rpn_ring[RPN_RING_LEN];
+	// index of level 3 (the level below Y) in the ring
+	uint8_t rpn_top;
+	// whether X is being typed in
+	uint8_t rpn_entry;
+	// whether starting a new entry pushes X onto the stack
+	uint8_t rpn_lift;
+
+	// buttons held in the Fn layer that selected a page of functions for a key,
+	// so releasing them is not a tap
+	uint8_t fn_btn_used;
+
+	uint32_t mem_regs[MEM_REG_COUNT];
+
+	// History of operations
+	struct History history;
+	// whether the LCD shows the history instead of the operands
+	uint8_t hist_viewing;
+	// age of the operation shown from the history, 0 is the newest
+	uint16_t hist_age;
+	// Journal of changes to the operands, operator, base, and overflow status, to undo and redo them
+	struct Journal journal;
+	// the state as of the newest change in the journal
+	struct JournalState journal_state;
+
+	// whether the LCD shows the information of a macro instead of the operands;
+	// it is closed like the history
+	uint8_t macro_viewing;
+
+	// whether the pending result is previewed while typing the second operand
+	uint8_t preview_on;
+	// whether the operands, operator, or base changed since the last preview
+	uint8_t preview_dirty;
+	// whether the last preview is still valid for the current input
+	uint8_t preview_valid;
+	// the last previewed result, reused when the operation is run
+	uint64_t preview_num;
+	uint32_t preview_rem;
+	uint8_t preview_div_0_err;
+
+	// whether the buttons move a cursor over the bits of the current operand,
+	// and the keypad toggles the bit under the cursor
+	uint8_t bit_edit;
+	// bit under the cursor
+	uint8_t bit_cursor;
+
+	// whether the submitted operands are fed into a checksum instead of calculated with
+	uint8_t checksum_on;
+	// checksum of the submitted operands
+	struct Checksum checksum;
+	// whether digits were typed since the last operand was submitted, so the
+	// checksum on the LCD includes the operand being typed
+	uint8_t checksum_pending;
+
+	// whether the LCD shows the current operand as a floating-point number, and the
+	// keypad enters its fields; a double uses both operands
+	uint8_t ieee_on;
+	enum IeeeFormat ieee_format;
+	enum IeeeField ieee_field;
+	// whether digits were typed into the selected field since it was selected
+	uint8_t ieee_entry;
+
+	// whether the LCD shows the current operand split into the fields of a layout,
+	// and the keypad enters the selected field
+	uint8_t field_on;
+	// preset layout of the fields
+	uint8_t field_layout;
+	// selected field of the layout
+	uint8_t field_idx;
+	// whether digits were typed into the selected field since it was selected
+	uint8_t field_entry;
+
+	enum SweepState sweep_state;
+	struct Expr sweep_expr;
+	// x shown in the table
+	uint32_t sweep_x;
+	// value of the expression searched for
+	uint32_t sweep_target;
+	// whether the target is being typed, and shown instead of the value
+	uint8_t sweep_target_entry;
+	// whether the last search ended without finding the target
+	uint8_t sweep_not_found;
+	// evaluations per second of the last search shown, from the input event
+	uint32_t sweep_rate;
+
+	// Stores whether the last result was an error
+	uint8_t is_err;
+
+	// Radix of the numerical base, any from RADIX_MIN to RADIX_MAX
+	uint8_t num_base;
+	// Number of digits of the largest operand in each radix, for the active word size;
+	// only the integer part in fixed-point mode
+	uint8_t max_digits[RADIX_MAX + 1];
+	// Number of fraction digits in each radix in fixed-point mode
+	uint8_t frac_digits[RADIX_MAX + 1];
+
+	enum DivMode div_mode;
+	// number of quarters of the word used for fraction bits in fixed-point mode
+	uint8_t fixed_quarters;
+	// number of fraction bits (n in Qm.n), 0 unless in fixed-point mode
+	uint8_t frac_bits;
+	// remainder of the last division run by ApplyOp
+	uint32_t div_rem;
+
+	enum Operator operator;
+
+	// RGBLED output
+	union {
+		// whether any operation has overflowed
+		uint8_t is_ovf;
+		// a bitfield of operations that can overflow
+		struct OverflowStatus {
+			// first operand
+			uint8_t num1 : 1;
+			// second operand
+			uint8_t num2 : 1;
+			// last result
+			uint8_t result : 1;
+		} fields;
+	} overflow_stat;
+
+	// The input event being run
+	struct CalcEvent event;
+
+	// What the LCD, RGB LED, and LEDs show
+	char lcd_text[LCD_BUFFER_COUNT][LCD_BUFFER_STRLEN + 1];
+	uint8_t glyphs[LCD_GLYPH_COUNT][LCD_GLYPH_ROWS];
+	uint8_t rgb[3];
+	uint8_t leds;
+	// what changed in the step so far
+	struct CalcDelta delta;
+};
+
+/**
+ * Initializes a calculator, and sets what it shows first.
+ */
+void Calc_Init(struct CalcState *calc, struct CalcDelta *delta);
+/**
+ * Runs a calculator on an input event, and sets what changed.
+ */
+void Calc_Step(struct CalcState *calc, struct CalcEvent const *event, struct CalcDelta *delta);
+/**
+ * Sets the word size, division mode, and base of a calculator, as the function keys
+ * and buttons would. In fixed-point mode, fixed_quarters quarters of the word are fraction bits.
+ */
+void Calc_SetFormat(struct CalcState *calc, uint8_t word_bits, enum DivMode div_mode, uint8_t fixed_quarters, uint8_t base);
+/**
+ * Runs an operator on two operands as = does, without changing the LCD or history.
+ * Returns the result truncated to the word, and sets whether it overflows the word
+ * or LCD and whether it divides by 0. Leaves the remainder of an integer division in div_rem.
+ */
+uint32_t Calc_RunOp(struct CalcState *calc, enum Operator op, uint32_t lhs, uint32_t rhs, uint8_t *is_ovf, uint8_t *div_0_err);
+/**
+ * Writes a number as the LCD shows an operand in a base, with its prefix and in the format
+ * of the calculator, right-aligned in len characters. The string is not terminated.
+ */
+void Calc_NumToStr(struct CalcState *calc, uint32_t num, uint8_t base, char *str, uint8_t len);
+
 /**
  * Initializes the calculator module.
  * Depends on the input module.
@@ -0,0 +1,49 @@
+/*
+ * Module to compute checksums of byte sequences.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/** Checksum algorithms. */
+enum ChecksumAlgo {
+	// CRC-16/CCITT-FALSE: polynomial 0x1021, initial value 0xFFFF, not reflected
+	ChecksumCrc16,
+	// CRC-32 (ISO-HDLC, as used by Ethernet and zip): polynomial 0x04C11DB7, reflected
+	ChecksumCrc32,
+	// Fletcher-16: two sums of the bytes modulo 255
+	ChecksumFletcher16,
+	// Adler-32: two sums of the bytes modulo 65521
+	ChecksumAdler32,
+	CHECKSUM_ALGO_COUNT
+};
+
+/** A running checksum. */
+struct Checksum {
+	uint8_t algo;
+	// CRC register, or the first sum of Fletcher and Adler
+	uint32_t a;
+	// second sum of Fletcher and Adler
+	uint32_t b;
+};
+
+/**
+ * Starts a checksum with the given algorithm.
+ */
+void Checksum_Init(struct Checksum *sum, enum ChecksumAlgo algo);
+/**
+ * Adds bytes to a checksum.
+ */
+void Checksum_Update(struct Checksum *sum, uint8_t const *data, uint32_t len);
+/**
+ * Returns the checksum of the bytes added so far.
+ */
+uint32_t Checksum_Get(struct Checksum const *sum);
+/**
+ * Returns the width of an algorithm's checksum in bits.
+ */
+uint8_t Checksum_GetWidth(enum ChecksumAlgo algo);
@@ -7,21 +7,18 @@
 
 #pragma once
 
+#if defined(__XC32)
 #include <xc.h>
+#endif
+#include "hal/hal.h"
 
 #define PB_FRQ  40000000
 
-#define macro_enable_interrupts() \
-{  unsigned int val = 0;\
-    asm volatile("mfc0 %0,$13":"=r"(val));  \
-    val |= 0x00800000;  \
-    asm volatile("mtc0 %0,$13" : "+r"(val)); \
-    INTCONbits.MVEC = 1; \
-__builtin_enable_interrupts(); }
+#define macro_enable_interrupts() Hal_EnableInterrupts()
 
 //#define macro_enable_interrupts INTEnableSystemMultiVectoredInt()
 
-#define macro_disable_interrupts() __builtin_disable_interrupts()
+#define macro_disable_interrupts() Hal_DisableInterrupts()
 //#define macro_disable_interrupts INTDisableInterrupts()
 
 
@@ -38,6 +35,7 @@ extern "C" {
 #define  prt_LEDS_GRP   PORTA
 #define  msk_LEDS_GRP   0xFF    
 #define  lat_LEDS_GRP_ADDR   0xBF886030
+#define port_LEDS_GRP   HalPortA
 
 #define  lat_LEDS_LED0  LATAbits.LATA0
 #define  lat_LEDS_LED1  LATAbits.LATA1
@@ -52,49 +50,62 @@ extern "C" {
 
 #define tris_SWT_SWT0   TRISFbits.TRISF3
 #define  prt_SWT_SWT0   PORTFbits.RF3
+#define  pin_SWT_SWT0   HAL_PIN(HalPortF, 3)
         
 #define tris_SWT_SWT1   TRISFbits.TRISF5
 #define  prt_SWT_SWT1   PORTFbits.RF5
+#define  pin_SWT_SWT1   HAL_PIN(HalPortF, 5)
 
 #define tris_SWT_SWT2   TRISFbits.TRISF4
 #define  prt_SWT_SWT2   PORTFbits.RF4
+#define  pin_SWT_SWT2   HAL_PIN(HalPortF, 4)
 
 #define tris_SWT_SWT3   TRISDbits.TRISD15
 #define  prt_SWT_SWT3   PORTDbits.RD15
+#define  pin_SWT_SWT3   HAL_PIN(HalPortD, 15)
 
 #define tris_SWT_SWT4   TRISDbits.TRISD14
 #define  prt_SWT_SWT4   PORTDbits.RD14
+#define  pin_SWT_SWT4   HAL_PIN(HalPortD, 14)
 
 #define tris_SWT_SWT5   TRISBbits.TRISB11
 #define  prt_SWT_SWT5   PORTBbits.RB11
+#define  pin_SWT_SWT5   HAL_PIN(HalPortB, 11)
 #define  ansel_SWT_SWT5 ANSELBbits.ANSB11
 
 #define tris_SWT_SWT6   TRISBbits.TRISB10
 #define  prt_SWT_SWT6   PORTBbits.RB10
+#define  pin_SWT_SWT6   HAL_PIN(HalPortB, 10)
 #define  ansel_SWT_SWT6 ANSELBbits.ANSB10
 
 #define tris_SWT_SWT7   TRISBbits.TRISB9
 #define  prt_SWT_SWT7   PORTBbits.RB9
+#define  pin_SWT_SWT7   HAL_PIN(HalPortB, 9)
 #define  ansel_SWT_SWT7 ANSELBbits.ANSB9
 
  // Buttons
 #define tris_BTN_BTNU   TRISBbits.TRISB1
 #define prt_BTN_BTNU    PORTBbits.RB1
+#define pin_BTN_BTNU    HAL_PIN(HalPortB, 1)
 #define ansel_BTN_BTNU  ANSELBbits.ANSB1
 
 #define tris_BTN_BTNL   TRISBbits.TRISB0
 #define prt_BTN_BTNL    PORTBbits.RB0
+#define pin_BTN_BTNL    HAL_PIN(HalPortB, 0)
 #define ansel_BTN_BTNL  ANSELBbits.ANSB0
 
 #define tris_BTN_BTNC   TRISFbits.TRISF0
 #define prt_BTN_BTNC    PORTFbits.RF0
+#define pin_BTN_BTNC    HAL_PIN(HalPortF, 0)
 
 #define tris_BTN_BTNR   TRISBbits.TRISB8
 #define prt_BTN_BTNR    PORTBbits.RB8
+#define pin_BTN_BTNR    HAL_PIN(HalPortB, 8)
 #define ansel_BTN_BTNR  ANSELBbits.ANSB8
 
 #define tris_BTN_BTND   TRISAbits.TRISA15
 #define  prt_BTN_BTND   PORTAbits.RA15
+#define pin_BTN_BTND    HAL_PIN(HalPortA, 15)
 
  // SSD - Seven Segment Display
 
@@ -156,20 +167,24 @@ extern "C" {
 #define lat_LCD_DISP_RS     LATBbits.LATB15
 #define ansel_LCD_DISP_RS   ANSELBbits.ANSB15
 #define rp_LCD_DISP_RS      RPB15R
+#define pin_LCD_DISP_RS     HAL_PIN(HalPortB, 15)
 
 
 #define tris_LCD_DISP_RW    TRISDbits.TRISD5
 #define  lat_LCD_DISP_RW    LATDbits.LATD5
 #define rp_LCD_DISP_RW      RPD5R
+#define pin_LCD_DISP_RW     HAL_PIN(HalPortD, 5)
 
 #define tris_LCD_DISP_EN    TRISDbits.TRISD4
 #define  lat_LCD_DISP_EN    LATDbits.LATD4
 #define rp_LCD_DISP_EN      RPD4R
+#define pin_LCD_DISP_EN     HAL_PIN(HalPortD, 4)
 
 #define tris_LCD_DATA       TRISE
 #define lat_LCD_DATA        LATE
 #define prt_LCD_DATA        PORTE
 #define msk_LCD_DATA        0xFF
+#define port_LCD_DATA       HalPortE
 #define  lat_LCD_DATA_ADDR   0xBF886440
 #define ansel_LCD_DB2        ANSELEbits.ANSE2
 #define ansel_LCD_DB4        ANSELEbits.ANSE4
@@ -182,16 +197,19 @@ extern "C" {
 #define tris_LED8_R         TRISDbits.TRISD2
 #define rp_LED8_R           RPD2R
 #define lat_LED8_R          LATDbits.LATD2
+#define pin_LED8_R          HAL_PIN(HalPortD, 2)
 #define ansel_LED8_R        ANSELDbits.ANSD2
 
 #define tris_LED8_G         TRISDbits.TRISD12
 #define rp_LED8_G           RPD12R
 #define lat_LED8_G          LATDbits.LATD12
+#define pin_LED8_G          HAL_PIN(HalPortD, 12)
 
 
 #define tris_LED8_B         TRISDbits.TRISD3
 #define rp_LED8_B           RPD3R
 #define lat_LED8_B          LATDbits.LATD3
+#define pin_LED8_B          HAL_PIN(HalPortD, 3)
 #define ansel_LED8_B        ANSELDbits.ANSD3
 
 // SPIFLASH - corresponds to SPI1
@@ -285,6 +303,7 @@ extern "C" {
 #define   rp_PMODS_JA1   RPC2R
 #define  lat_PMODS_JA1   LATCbits.LATC2
 #define  prt_PMODS_JA1   PORTCbits.RC2
+#define  pin_PMODS_JA1   HAL_PIN(HalPortC, 2)
 #define cnpu_PMODS_JA1   CNPUCbits.CNPUC2
 #define cnpd_PMODS_JA1   CNPDCbits.CNPDC2
 
@@ -293,6 +312,7 @@ extern "C" {
 #define   rp_PMODS_JA2   RPC1R
 #define  lat_PMODS_JA2   LATCbits.LATC1
 #define  prt_PMODS_JA2   PORTCbits.RC1
+#define  pin_PMODS_JA2   HAL_PIN(HalPortC, 1)
 #define cnpu_PMODS_JA2   CNPUCbits.CNPUC1
 #define cnpd_PMODS_JA2   CNPDCbits.CNPDC1
 
@@ -301,6 +321,7 @@ extern "C" {
 #define   rp_PMODS_JA3   RPC4R
 #define  lat_PMODS_JA3   LATCbits.LATC4
 #define  prt_PMODS_JA3   PORTCbits.RC4
+#define  pin_PMODS_JA3   HAL_PIN(HalPortC, 4)
 #define cnpu_PMODS_JA3   CNPUCbits.CNPUC4
 #define cnpd_PMODS_JA3   CNPDCbits.CNPDC4
 
@@ -309,6 +330,7 @@ extern "C" {
 #define   rp_PMODS_JA4   RPG6R
 #define  lat_PMODS_JA4   LATGbits.LATG6
 #define  prt_PMODS_JA4   PORTGbits.RG6
+#define  pin_PMODS_JA4   HAL_PIN(HalPortG, 6)
 #define ansel_PMODS_JA4  ANSELGbits.ANSG6
 #define cnpu_PMODS_JA4   CNPUGbits.CNPUG6
 #define cnpd_PMODS_JA4   CNPDGbits.CNPDG6
@@ -318,6 +340,7 @@ extern "C" {
 #define   rp_PMODS_JA7   RPC3R
 #define  lat_PMODS_JA7   LATCbits.LATC3
 #define  prt_PMODS_JA7   PORTCbits.RC3
+#define  pin_PMODS_JA7   HAL_PIN(HalPortC, 3)
 #define cnpu_PMODS_JA7   CNPUCbits.CNPUC3
 #define cnpd_PMODS_JA7   CNPDCbits.CNPDC3
 
@@ -326,6 +349,7 @@ extern "C" {
 #define   rp_PMODS_JA8   RPG7R
 #define  lat_PMODS_JA8   LATGbits.LATG7
 #define  prt_PMODS_JA8   PORTGbits.RG7
+#define  pin_PMODS_JA8   HAL_PIN(HalPortG, 7)
 #define ansel_PMODS_JA8  ANSELGbits.ANSG7
 #define cnpu_PMODS_JA8   CNPUGbits.CNPUG7
 #define cnpd_PMODS_JA8   CNPDGbits.CNPDG7
@@ -335,6 +359,7 @@ extern "C" {
 #define   rp_PMODS_JA9   RPG8R
 #define  lat_PMODS_JA9   LATGbits.LATG8
 #define  prt_PMODS_JA9   PORTGbits.RG8
+#define  pin_PMODS_JA9   HAL_PIN(HalPortG, 8)
 #define ansel_PMODS_JA9  ANSELGbits.ANSG8
 #define cnpu_PMODS_JA9   CNPUGbits.CNPUG8
 #define cnpd_PMODS_JA9   CNPDGbits.CNPDG8
@@ -344,6 +369,7 @@ extern "C" {
 #define   rp_PMODS_JA10   RPG9R
 #define  lat_PMODS_JA10   LATGbits.LATG9
 #define  prt_PMODS_JA10   PORTGbits.RG9
+#define  pin_PMODS_JA10   HAL_PIN(HalPortG, 9)
 #define ansel_PMODS_JA10  ANSELGbits.ANSG9
 #define cnpu_PMODS_JA10   CNPUGbits.CNPUG9
 #define cnpd_PMODS_JA10   CNPDGbits.CNPDG9
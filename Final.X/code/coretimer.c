@@ -0,0 +1,22 @@
+/*
+ * Module to read the core timer, the Count register of the MIPS core.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "coretimer.h"
+#include "hal/hal.h"
+
+uint32_t CoreTimer_Read(void)
+{
+	return Hal_CoreTimerRead();
+}
+
+uint32_t CoreTimer_GetRate(uint32_t events, uint32_t ticks)
+{
+	if (!ticks) {
+		return 0;
+	}
+	return (uint64_t)events * CORE_TIMER_FRQ / ticks;
+}
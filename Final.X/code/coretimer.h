@@ -0,0 +1,25 @@
+/*
+ * Module to read the core timer, the Count register of the MIPS core.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// The core timer counts at half the 80 MHz system clock
+#define CORE_TIMER_FRQ 40000000
+
+/**
+ * Returns the count of the core timer, which wraps around every 107 seconds.
+ * On Linux, it counts the simulated time, so work that doesn't access the ports or
+ * delay takes no time.
+ */
+uint32_t CoreTimer_Read(void);
+/**
+ * Returns the number of events per second, given the core timer ticks they took,
+ * or 0 if no time was measured.
+ */
+uint32_t CoreTimer_GetRate(uint32_t events, uint32_t ticks);
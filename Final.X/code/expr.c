@@ -0,0 +1,217 @@
+/*
+ * Module to compile expressions of x into bytecode and evaluate them with a
+ * small stack machine.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "expr.h"
+#include "bitops.h"
+#include "radix.h"
+#include <string.h>
+
+/**
+ * Instructions that push a value, after the operators, which are their own instructions.
+ * Constants are stored little-endian in as few bytes as they need.
+ */
+enum Opcode {
+	OpcodeX = EXPR_OP_COUNT,
+	OpcodeConst8,
+	OpcodeConst16,
+	OpcodeConst32
+};
+
+// operator characters for text, like the calculator's
+static char const op_chars[EXPR_OP_COUNT] = {'+', '-', '*', '/', '&', '|', '^', 'P', 'L', 'O', 'T', '%', 'R', 'S'};
+
+// Longest text of an expression: a 32-digit binary constant and its operator
+// take 6 bytes of bytecode, and a unary operator and its parentheses take 1
+#define TEXT_LEN (EXPR_CODE_LEN * 6)
+
+void Expr_Init(struct Expr *expr)
+{
+	expr->code[0] = OpcodeX;
+	expr->len = 1;
+	expr->depth = 1;
+}
+
+uint8_t Expr_AppendBinary(struct Expr *expr, enum ExprOp op, uint32_t constant)
+{
+	uint8_t const_len = 4;
+	uint8_t opcode = OpcodeConst32;
+	if (constant <= 0xFF) {
+		const_len = 1;
+		opcode = OpcodeConst8;
+	} else if (constant <= 0xFFFF) {
+		const_len = 2;
+		opcode = OpcodeConst16;
+	}
+
+	// the constant is pushed above the expression so far, then both are popped
+	if (expr->len + 1 + const_len + 1 > EXPR_CODE_LEN) {
+		return 0;
+	}
+	uint8_t *code = expr->code + expr->len;
+	*code++ = opcode;
+	for (uint8_t i = 0; i < const_len; ++i) {
+		*code++ = constant >> (8 * i);
+	}
+	*code++ = op;
+	expr->len = code - expr->code;
+	if (expr->depth < 2) {
+		expr->depth = 2;
+	}
+	return 1;
+}
+
+uint8_t Expr_AppendUnary(struct Expr *expr, enum ExprOp op)
+{
+	if (expr->len + 1 > EXPR_CODE_LEN) {
+		return 0;
+	}
+	expr->code[expr->len++] = op;
+	return 1;
+}
+
+uint8_t Expr_Eval(struct Expr const *expr, uint32_t x, uint8_t width, uint32_t *result)
+{
+	uint32_t const mask = 0xFFFFFFFF >> (32 - width);
+	// the top of the stack is kept apart, so most instructions don't touch memory
+	uint32_t stack[EXPR_STACK_DEPTH];
+	uint8_t sp = 0;
+	uint32_t top = 0;
+
+	uint8_t const *pc = expr->code;
+	uint8_t const *const end = pc + expr->len;
+	while (pc < end) {
+		switch (*pc++) {
+			case OpcodeX:
+				stack[sp++] = top;
+				top = x;
+				break;
+			case OpcodeConst8:
+				stack[sp++] = top;
+				top = pc[0];
+				pc += 1;
+				break;
+			case OpcodeConst16:
+				stack[sp++] = top;
+				top = pc[0] | ((uint32_t)pc[1] << 8);
+				pc += 2;
+				break;
+			case OpcodeConst32:
+				stack[sp++] = top;
+				top = pc[0] | ((uint32_t)pc[1] << 8) | ((uint32_t)pc[2] << 16) | ((uint32_t)pc[3] << 24);
+				pc += 4;
+				break;
+			case ExprAdd:
+				top = stack[--sp] + top;
+				break;
+			case ExprSub:
+				top = stack[--sp] - top;
+				break;
+			case ExprMult:
+				top = stack[--sp] * top;
+				break;
+			case ExprDiv:
+				if (!top) {
+					return 0;
+				}
+				top = stack[--sp] / top;
+				break;
+			case ExprAnd:
+				top = stack[--sp] & top;
+				break;
+			case ExprOr:
+				top = stack[--sp] | top;
+				break;
+			case ExprXor:
+				top = stack[--sp] ^ top;
+				break;
+			case ExprPopcount:
+				top = Bits_Popcount(top);
+				break;
+			case ExprClz:
+				top = Bits_Clz(top, width);
+				break;
+			case ExprClo:
+				top = Bits_Clo(top, width);
+				break;
+			case ExprCtz:
+				top = Bits_Ctz(top, width);
+				break;
+			case ExprParity:
+				top = Bits_Parity(top);
+				break;
+			case ExprBitReverse:
+				top = Bits_Reverse(top, width);
+				break;
+			case ExprByteSwap:
+				top = Bits_ByteSwap(top, width);
+				break;
+		}
+		// every result is truncated to the word, like the calculator's
+		top &= mask;
+	}
+
+	*result = top;
+	return 1;
+}
+
+uint32_t Expr_Search(struct Expr const *expr, uint32_t start, uint32_t count, uint8_t width, uint32_t target, uint8_t *found)
+{
+	uint32_t const mask = 0xFFFFFFFF >> (32 - width);
+	uint32_t x = start & mask;
+
+	*found = 0;
+	for (; count; --count) {
+		uint32_t result;
+		if (Expr_Eval(expr, x, width, &result) && result == target) {
+			*found = 1;
+			return x;
+		}
+		x = (x + 1) & mask;
+	}
+	return x;
+}
+
+uint8_t Expr_ToStr(struct Expr const *expr, uint8_t radix, char *str, uint8_t len)
+{
+	char text[TEXT_LEN];
+	uint16_t text_len = 0;
+	uint32_t constant = 0;
+
+	uint8_t const *pc = expr->code;
+	uint8_t const *const end = pc + expr->len;
+	while (pc < end) {
+		uint8_t const opcode = *pc++;
+		if (opcode == OpcodeX) {
+			text[text_len++] = 'x';
+		} else if (opcode >= OpcodeConst8) {
+			// the constant is written after the operator that follows it
+			uint8_t const const_len = (opcode == OpcodeConst8) ? 1 : (opcode == OpcodeConst16) ? 2 : 4;
+			constant = 0;
+			for (uint8_t i = 0; i < const_len; ++i) {
+				constant |= (uint32_t)*pc++ << (8 * i);
+			}
+		} else if (opcode < ExprPopcount) {
+			text[text_len++] = op_chars[opcode];
+			uint8_t const digits = Radix_CountDigits(constant, radix);
+			Radix_ToStr(constant, radix, text + text_len, digits);
+			text_len += digits;
+		} else {
+			// a unary operator applies to everything before it, like a function
+			memmove(text + 2, text, text_len);
+			text[0] = op_chars[opcode];
+			text[1] = '(';
+			text_len += 2;
+			text[text_len++] = ')';
+		}
+	}
+
+	// keep the end of the text, where the newest operators are
+	uint16_t const start = (text_len > len) ? text_len - len : 0;
+	memcpy(str, text + start, text_len - start);
+	return text_len - start;
+}
@@ -0,0 +1,81 @@
+/*
+ * Module to compile expressions of x into bytecode and evaluate them with a
+ * small stack machine, over one value or a range of values.
+ *
+ * An expression starts as x, and each operator applies to the expression so far,
+ * with a constant as the right operand of binary operators.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Most bytes of bytecode in an expression
+#define EXPR_CODE_LEN 64
+// Most values on the stack while evaluating
+#define EXPR_STACK_DEPTH 4
+
+/** Operators, in the same order as the calculator's operators. */
+enum ExprOp {
+	// binary operators
+	ExprAdd,
+	ExprSub,
+	ExprMult,
+	ExprDiv,
+	ExprAnd,
+	ExprOr,
+	ExprXor,
+	// unary operators
+	ExprPopcount,
+	ExprClz,
+	ExprClo,
+	ExprCtz,
+	ExprParity,
+	ExprBitReverse,
+	ExprByteSwap,
+	EXPR_OP_COUNT
+};
+
+/** A compiled expression. */
+struct Expr {
+	uint8_t code[EXPR_CODE_LEN];
+	// bytes of bytecode
+	uint8_t len;
+	// stack levels the bytecode needs
+	uint8_t depth;
+};
+
+/**
+ * Starts an expression as x.
+ */
+void Expr_Init(struct Expr *expr);
+/**
+ * Applies a binary operator with a constant right operand to an expression.
+ * Returns 0 and leaves the expression unchanged if there is no room.
+ */
+uint8_t Expr_AppendBinary(struct Expr *expr, enum ExprOp op, uint32_t constant);
+/**
+ * Applies a unary operator to an expression.
+ * Returns 0 and leaves the expression unchanged if there is no room.
+ */
+uint8_t Expr_AppendUnary(struct Expr *expr, enum ExprOp op);
+/**
+ * Evaluates an expression for x in a word of the given width, 1 to 32 bits.
+ * Every operation is truncated to the word. Returns 0 if it divides by 0.
+ */
+uint8_t Expr_Eval(struct Expr const *expr, uint32_t x, uint8_t width, uint32_t *result);
+/**
+ * Evaluates an expression for count values of x from start, wrapping around the word,
+ * until the result equals target. Returns the first matching x and sets found,
+ * or returns the x after the last one tried.
+ */
+uint32_t Expr_Search(struct Expr const *expr, uint32_t start, uint32_t count, uint8_t width, uint32_t target, uint8_t *found);
+/**
+ * Writes an expression as text, such as "P(x*3)&FF", with constants in a radix.
+ * Only the end is written if the text is longer than len.
+ * Returns the number of characters written; str is not terminated.
+ */
+uint8_t Expr_ToStr(struct Expr const *expr, uint8_t radix, char *str, uint8_t len);
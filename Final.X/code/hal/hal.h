@@ -0,0 +1,89 @@
+/*
+ * Hardware abstraction layer for the GPIO ports, the timer, and interrupts.
+ *
+ * hal_pic32.c implements it with the PIC32 registers, and hal_linux.c with
+ * simulated registers so the program can be built and run on a PC.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/** The GPIO ports of the PIC32MX370. */
+enum HalPort {
+	HalPortA,
+	HalPortB,
+	HalPortC,
+	HalPortD,
+	HalPortE,
+	HalPortF,
+	HalPortG,
+	HAL_PORT_COUNT
+};
+
+/** Directions of a pin. Every pin is made digital. */
+enum HalPinMode {
+	HalOutput,
+	HalInput,
+	// an input pulled up when nothing drives it
+	HalInputPullUp
+};
+
+// A pin as its port and bit, in one byte
+#define HAL_PIN(port, bit) (((port) << 4) | (bit))
+#define HAL_PIN_PORT(pin) ((enum HalPort)((pin) >> 4))
+#define HAL_PIN_MASK(pin) ((uint32_t)1 << ((pin) & 0xF))
+
+/* --------- Pins --------- */
+#define Hal_PinMode(pin, mode) Hal_PortMode(HAL_PIN_PORT(pin), HAL_PIN_MASK(pin), mode)
+#define Hal_PinWrite(pin, value) Hal_PortWrite(HAL_PIN_PORT(pin), HAL_PIN_MASK(pin), (value) ? HAL_PIN_MASK(pin) : 0)
+#define Hal_PinRead(pin) (!!(Hal_PortRead(HAL_PIN_PORT(pin)) & HAL_PIN_MASK(pin)))
+
+/* --------- Ports --------- */
+/**
+ * Sets the direction of the masked pins of a port, and makes them digital.
+ */
+void Hal_PortMode(enum HalPort port, uint32_t mask, enum HalPinMode mode);
+/**
+ * Sets the masked output latches of a port to the bits of value.
+ */
+void Hal_PortWrite(enum HalPort port, uint32_t mask, uint32_t value);
+/**
+ * Inverts the masked output latches of a port.
+ */
+void Hal_PortToggle(enum HalPort port, uint32_t mask);
+/**
+ * Returns the levels of the pins of a port.
+ */
+uint32_t Hal_PortRead(enum HalPort port);
+
+/* --------- Timer and interrupts --------- */
+/**
+ * Calls handler from an interrupt every period_us microseconds, up to about 400 ms.
+ * Interrupts must be enabled for it to run.
+ */
+void Hal_TimerStart(uint32_t period_us, void (*handler)(void));
+/**
+ * Stops the timer.
+ */
+void Hal_TimerStop(void);
+/**
+ * Enables interrupts, in multi-vector mode.
+ */
+void Hal_EnableInterrupts(void);
+/**
+ * Disables interrupts.
+ */
+void Hal_DisableInterrupts(void);
+/**
+ * Waits about count hundreds of microseconds. The wait is not precise.
+ */
+void Hal_Delay100Us(uint32_t count);
+/**
+ * Returns the count of the core timer, which counts at half the 80 MHz system clock.
+ * On Linux, it counts the simulated time, which passes as the ports are accessed and in delays.
+ */
+uint32_t Hal_CoreTimerRead(void);
@@ -0,0 +1,253 @@
+/*
+ * Hardware abstraction layer for Linux, using simulated registers.
+ *
+ * The ports keep the registers the PIC32 has, so the program runs unchanged.
+ * The timer interrupt is a SIGALRM, and disabling interrupts blocks the signal.
+ * In virtual time, delays don't sleep and the timer interrupt runs as the virtual
+ * time passes each period, so runs are as fast as the PC and always the same.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "hal/hal.h"
+#include "hal/hal_sim.h"
+#include <errno.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <time.h>
+
+/** The registers of a port, and the levels driven on its pins from outside. */
+struct SimPort {
+	uint32_t ansel;
+	uint32_t tris;
+	uint32_t lat;
+	uint32_t cnpu;
+	// pins driven from outside, and their levels
+	uint32_t driven;
+	uint32_t levels;
+};
+
+// Every pin starts as an analog input, as on reset
+#define PORT_RESET {.ansel = 0xFFFF, .tris = 0xFFFF}
+
+static struct SimPort ports[HAL_PORT_COUNT] = {
+	PORT_RESET, PORT_RESET, PORT_RESET, PORT_RESET, PORT_RESET, PORT_RESET, PORT_RESET
+};
+
+static void (*hooks[HALSIM_HOOK_COUNT])(enum HalPort port);
+static uint8_t hook_count;
+
+static void (*timer_handler)(void);
+// timer period in virtual time, 0 when stopped, and when it next runs
+static uint64_t timer_period_ns;
+static uint64_t timer_next_ns;
+static uint8_t interrupts_enabled;
+static uint8_t in_interrupt;
+
+// virtual time in nanoseconds, and whether delays sleep and the timer is a signal
+static uint64_t time_ns;
+static uint8_t real_time = 1;
+// accesses to the ports
+static uint64_t access_count;
+
+/**
+ * Advances the virtual time, running the timer interrupt for each period passed.
+ * The interrupt takes its time from what it interrupts, as on the PIC32.
+ */
+static void Advance(uint64_t ns)
+{
+	uint64_t end = time_ns + ns;
+	if (real_time || in_interrupt) {
+		time_ns = end;
+		return;
+	}
+	while (timer_period_ns && interrupts_enabled && timer_next_ns <= end) {
+		if (time_ns < timer_next_ns) {
+			time_ns = timer_next_ns;
+		}
+		uint64_t const start = time_ns;
+		timer_next_ns += timer_period_ns;
+		in_interrupt = 1;
+		timer_handler();
+		in_interrupt = 0;
+		end += time_ns - start;
+	}
+	time_ns = end;
+}
+
+/** Counts an access to a port, and the time it takes. */
+static void Access(void)
+{
+	Advance(HALSIM_ACCESS_NS);
+	++access_count;
+}
+
+/** Tells the devices about a write to a port, once the write has taken its time. */
+static void RunHooks(enum HalPort port)
+{
+	Access();
+	for (uint8_t i = 0; i < hook_count; ++i) {
+		hooks[i](port);
+	}
+}
+
+void Hal_PortMode(enum HalPort port, uint32_t mask, enum HalPinMode mode)
+{
+	struct SimPort *const p = &ports[port];
+	p->ansel &= ~mask;
+	if (mode == HalInputPullUp) {
+		p->cnpu |= mask;
+	} else {
+		p->cnpu &= ~mask;
+	}
+	if (mode == HalOutput) {
+		p->tris &= ~mask;
+	} else {
+		p->tris |= mask;
+	}
+	RunHooks(port);
+}
+
+void Hal_PortWrite(enum HalPort port, uint32_t mask, uint32_t value)
+{
+	struct SimPort *const p = &ports[port];
+	p->lat = (p->lat & ~mask) | (value & mask);
+	RunHooks(port);
+}
+
+void Hal_PortToggle(enum HalPort port, uint32_t mask)
+{
+	ports[port].lat ^= mask;
+	RunHooks(port);
+}
+
+uint32_t Hal_PortRead(enum HalPort port)
+{
+	struct SimPort const *const p = &ports[port];
+	Access();
+	// outputs read their latches, and analog pins read 0
+	uint32_t const outside = (p->levels & p->driven) | (p->cnpu & ~p->driven);
+	return ((p->lat & ~p->tris) | (outside & p->tris)) & ~p->ansel;
+}
+
+/** Runs the timer handler as the timer interrupt. */
+static void OnAlarm(int signal)
+{
+	(void)signal;
+	timer_handler();
+}
+
+void Hal_TimerStart(uint32_t period_us, void (*handler)(void))
+{
+	timer_handler = handler;
+	timer_period_ns = period_us * 1000ULL;
+	timer_next_ns = time_ns + timer_period_ns;
+	if (!real_time) {
+		return;
+	}
+	struct sigaction action = {0};
+	action.sa_handler = OnAlarm;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGALRM, &action, NULL);
+
+	struct itimerval const timer = {{0, period_us}, {0, period_us}};
+	setitimer(ITIMER_REAL, &timer, NULL);
+}
+
+void Hal_TimerStop(void)
+{
+	timer_period_ns = 0;
+	struct itimerval const timer = {{0, 0}, {0, 0}};
+	setitimer(ITIMER_REAL, &timer, NULL);
+}
+
+/** Blocks or unblocks the timer signal. */
+static void MaskAlarm(int how)
+{
+	sigset_t set;
+	sigemptyset(&set);
+	sigaddset(&set, SIGALRM);
+	sigprocmask(how, &set, NULL);
+}
+
+void Hal_EnableInterrupts(void)
+{
+	interrupts_enabled = 1;
+	if (!real_time && timer_period_ns && timer_next_ns <= time_ns) {
+		// a period passed while disabled leaves the interrupt pending, but only once
+		timer_next_ns = time_ns - (time_ns - timer_next_ns) % timer_period_ns;
+		Advance(0);
+	}
+	MaskAlarm(SIG_UNBLOCK);
+}
+
+void Hal_DisableInterrupts(void)
+{
+	interrupts_enabled = 0;
+	MaskAlarm(SIG_BLOCK);
+}
+
+void Hal_Delay100Us(uint32_t count)
+{
+	Advance(count * 100000ULL);
+	if (!real_time) {
+		return;
+	}
+	struct timespec wait = {count / 10000, (count % 10000) * 100000L};
+	// the timer signal interrupts the sleep, so sleep for what is left
+	while (nanosleep(&wait, &wait) && errno == EINTR) {
+	}
+}
+
+uint32_t Hal_CoreTimerRead(void)
+{
+	// the core timer ticks every 25 ns
+	return time_ns / 25;
+}
+
+void HalSim_DrivePins(enum HalPort port, uint32_t mask, uint32_t levels)
+{
+	struct SimPort *const p = &ports[port];
+	p->driven |= mask;
+	p->levels = (p->levels & ~mask) | (levels & mask);
+}
+
+void HalSim_ReleasePins(enum HalPort port, uint32_t mask)
+{
+	ports[port].driven &= ~mask;
+}
+
+uint32_t HalSim_GetLat(enum HalPort port)
+{
+	return ports[port].lat;
+}
+
+uint32_t HalSim_GetTris(enum HalPort port)
+{
+	return ports[port].tris;
+}
+
+uint8_t HalSim_AddWriteHook(void (*hook)(enum HalPort port))
+{
+	if (hook_count >= HALSIM_HOOK_COUNT) {
+		return 0;
+	}
+	hooks[hook_count++] = hook;
+	return 1;
+}
+
+uint64_t HalSim_GetTimeNs(void)
+{
+	return time_ns;
+}
+
+void HalSim_SetRealTime(uint8_t real)
+{
+	real_time = real;
+}
+
+uint64_t HalSim_GetAccessCount(void)
+{
+	return access_count;
+}
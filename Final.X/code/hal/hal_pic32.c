@@ -0,0 +1,131 @@
+/*
+ * Hardware abstraction layer for the PIC32MX370, using its registers.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "hal/hal.h"
+#include "config.h"
+#include <xc.h>
+#include <sys/attribs.h>
+
+// The registers of port A start here, and each port after it is a stride further
+#define PORT_BASE 0xBF886000
+#define PORT_STRIDE 0x100
+
+/** Offsets of the registers of a port. Ports without analog inputs ignore writes to ANSEL. */
+enum PortReg {
+	RegAnsel = 0x00,
+	RegTris = 0x10,
+	RegPort = 0x20,
+	RegLat = 0x30,
+	RegCnpu = 0x50
+};
+
+// Each register is followed by registers that clear, set, and invert the bits written to them
+#define REG_CLR 0x4
+#define REG_SET 0x8
+#define REG_INV 0xC
+
+/** Returns a register of a port. */
+static volatile uint32_t *GetReg(enum HalPort port, uint16_t offset)
+{
+	return (volatile uint32_t *)(PORT_BASE + port * PORT_STRIDE + offset);
+}
+
+void Hal_PortMode(enum HalPort port, uint32_t mask, enum HalPinMode mode)
+{
+	*GetReg(port, RegAnsel + REG_CLR) = mask;
+	*GetReg(port, RegCnpu + ((mode == HalInputPullUp) ? REG_SET : REG_CLR)) = mask;
+	*GetReg(port, RegTris + ((mode == HalOutput) ? REG_CLR : REG_SET)) = mask;
+}
+
+void Hal_PortWrite(enum HalPort port, uint32_t mask, uint32_t value)
+{
+	// each pin changes at most once
+	*GetReg(port, RegLat + REG_CLR) = mask & ~value;
+	*GetReg(port, RegLat + REG_SET) = mask & value;
+}
+
+void Hal_PortToggle(enum HalPort port, uint32_t mask)
+{
+	*GetReg(port, RegLat + REG_INV) = mask;
+}
+
+uint32_t Hal_PortRead(enum HalPort port)
+{
+	return *GetReg(port, RegPort);
+}
+
+static void (*timer_handler)(void);
+
+void __ISR(_TIMER_5_VECTOR, ipl2) Hal_Timer5Vector(void)
+{
+	timer_handler();
+	IFS0bits.T5IF = 0;     // clear interrupt flag
+}
+
+void Hal_TimerStart(uint32_t period_us, void (*handler)(void))
+{
+	timer_handler = handler;
+	// Timer5 counts the peripheral clock through a 1:256 prescaler
+	PR5 = (period_us * (PB_FRQ / 1000000) + 128) / 256;
+	TMR5 = 0;                           //    initialize count to 0
+	T5CONbits.TCKPS = 3;                //    1:256 prescaler value
+	T5CONbits.TGATE = 0;                //    not gated input (the default)
+	T5CONbits.TCS = 0;                  //    PCBLK input (the default)
+	IPC5bits.T5IP = 2;                  //    INT step 4: priority
+	IPC5bits.T5IS = 0;                  //    subpriority
+	IFS0bits.T5IF = 0;                  //    clear interrupt flag
+	IEC0bits.T5IE = 1;                  //    enable interrupt
+	T5CONbits.ON = 1;                   //    turn on Timer5
+}
+
+void Hal_TimerStop(void)
+{
+	T5CONbits.ON = 0;
+	IEC0bits.T5IE = 0;
+}
+
+void Hal_EnableInterrupts(void)
+{
+	unsigned int val = 0;
+	// set the interrupt vector spacing in the Cause register, register 13 of coprocessor 0
+	asm volatile("mfc0 %0,$13" : "=r"(val));
+	val |= 0x00800000;
+	asm volatile("mtc0 %0,$13" : "+r"(val));
+	INTCONbits.MVEC = 1;
+	__builtin_enable_interrupts();
+}
+
+void Hal_DisableInterrupts(void)
+{
+	__builtin_disable_interrupts();
+}
+
+void Hal_Delay100Us(uint32_t count)
+{
+	// the loop is tuned for the system clock, so the delay is not precise
+	volatile int j;
+	while (0 < count) {
+		count--;
+		j = 14;
+		while (0 < j) {
+			j--;
+		}
+		asm volatile("nop");
+		asm volatile("nop");
+		asm volatile("nop");
+		asm volatile("nop");
+		asm volatile("nop");
+	}
+}
+
+uint32_t Hal_CoreTimerRead(void)
+{
+	uint32_t count;
+	// Count is register 9 of coprocessor 0
+	asm volatile("mfc0 %0, $9" : "=r"(count));
+	return count;
+}
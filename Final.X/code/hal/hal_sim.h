@@ -0,0 +1,55 @@
+/*
+ * Access to the simulated registers of the Linux HAL, for models of the devices
+ * wired to the pins.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include "hal/hal.h"
+
+// Most functions called on writes to the ports
+#define HALSIM_HOOK_COUNT 4
+// Virtual nanoseconds each access to a port takes, about two peripheral bus clocks
+#define HALSIM_ACCESS_NS 50
+
+/**
+ * Drives the masked pins of a port from outside the chip, as a device would.
+ * An input reads the level driven on it, or the level of its pull-up if nothing drives it.
+ */
+void HalSim_DrivePins(enum HalPort port, uint32_t mask, uint32_t levels);
+/**
+ * Stops driving the masked pins of a port.
+ */
+void HalSim_ReleasePins(enum HalPort port, uint32_t mask);
+/**
+ * Returns the output latches of a port.
+ */
+uint32_t HalSim_GetLat(enum HalPort port);
+/**
+ * Returns the directions of the pins of a port, 1 for inputs.
+ */
+uint32_t HalSim_GetTris(enum HalPort port);
+/**
+ * Adds a function called with the port after each write to the latches or directions of a port,
+ * so a device can respond to them. Returns 0 if there is no room.
+ */
+uint8_t HalSim_AddWriteHook(void (*hook)(enum HalPort port));
+/**
+ * Returns the virtual time in nanoseconds. Each access to a port and each delay advances it
+ * by how long it would take on the PIC32.
+ */
+uint64_t HalSim_GetTimeNs(void);
+/**
+ * Sets whether the program runs in real time, which it does by default, with delays
+ * sleeping and the timer interrupt a signal. Otherwise it runs in virtual time only,
+ * with the timer interrupt run as the virtual time passes each period.
+ * Call this before starting the timer.
+ */
+void HalSim_SetRealTime(uint8_t real);
+/**
+ * Returns the number of reads and writes of the ports so far.
+ */
+uint64_t HalSim_GetAccessCount(void);
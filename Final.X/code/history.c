@@ -0,0 +1,240 @@
+/*
+ * Module to keep a history of calculator operations.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "history.h"
+#include <string.h>
+
+// Record header flags
+// all fields are stored in full
+#define HIST_KEY 0x80
+// first operand is stored as a delta from the last result, else it is the last result
+#define HIST_LHS 0x40
+// second operand is stored as a delta from the last second operand, else it is repeated
+#define HIST_RHS 0x20
+// operator and base bytes are stored, else they are repeated
+#define HIST_META 0x10
+// operation was an error, no result is stored
+#define HIST_ERR 0x08
+
+// Longest record: header, 3 varints of up to 5 bytes, and the operator and base bytes
+#define HIST_MAX_RECORD_LEN 18
+
+/** Wraps an offset into the history ring. */
+static uint16_t Wrap(uint16_t pos)
+{
+	return pos & (HISTORY_BUFFER_SIZE - 1);
+}
+
+/** Maps a signed delta to an unsigned one so small deltas of either sign stay small. */
+static uint32_t ZigZag(uint32_t delta)
+{
+	// the arithmetic shift copies the sign bit into every bit
+	return (delta << 1) ^ (uint32_t)((int32_t)delta >> 31);
+}
+
+/** Reverses ZigZag. */
+static uint32_t UnZigZag(uint32_t z)
+{
+	return (z >> 1) ^ -(z & 1);
+}
+
+/** Writes a varint (7 bits per byte, high bit set if more bytes follow), returning its length. */
+static uint8_t PutVarint(uint8_t *out, uint32_t val)
+{
+	uint8_t len = 0;
+	while (val >= 0x80) {
+		out[len++] = (val & 0x7F) | 0x80;
+		val >>= 7;
+	}
+	out[len++] = val;
+	return len;
+}
+
+/** Reads a varint from the history ring, advancing pos past it. */
+static uint32_t GetVarint(struct History const *hist, uint16_t *pos)
+{
+	uint32_t val = 0;
+	uint8_t shift = 0;
+	uint8_t byte;
+	do {
+		byte = hist->buf[*pos];
+		*pos = Wrap(*pos + 1);
+		val |= (uint32_t)(byte & 0x7F) << shift;
+		shift += 7;
+	} while (byte & 0x80);
+	return val;
+}
+
+/** Encodes an entry against the previous one, returning the record length. */
+static uint8_t Encode(struct HistoryEntry const *prev, struct HistoryEntry const *entry, uint8_t is_key, uint8_t *rec)
+{
+	uint8_t len = 1;
+	uint8_t header = 0;
+
+	if (is_key) {
+		header = HIST_KEY | HIST_LHS | HIST_RHS | HIST_META;
+		len += PutVarint(rec + len, entry->lhs);
+		len += PutVarint(rec + len, entry->rhs);
+	} else {
+		if (entry->lhs != prev->result) {
+			header |= HIST_LHS;
+			len += PutVarint(rec + len, ZigZag(entry->lhs - prev->result));
+		}
+		if (entry->rhs != prev->rhs) {
+			header |= HIST_RHS;
+			len += PutVarint(rec + len, ZigZag(entry->rhs - prev->rhs));
+		}
+		if (entry->op != prev->op || entry->base != prev->base) {
+			header |= HIST_META;
+		}
+	}
+
+	if (header & HIST_META) {
+		rec[len++] = entry->op;
+		rec[len++] = entry->base;
+	}
+
+	if (entry->is_err) {
+		header |= HIST_ERR;
+	} else if (is_key) {
+		len += PutVarint(rec + len, entry->result);
+	} else {
+		// results are usually close to the first operand
+		len += PutVarint(rec + len, ZigZag(entry->result - entry->lhs));
+	}
+
+	rec[0] = header;
+	return len;
+}
+
+/**
+ * Decodes the record at pos on top of the previous entry, returning the record length.
+ */
+static uint16_t Decode(struct History const *hist, uint16_t pos, struct HistoryEntry *entry)
+{
+	uint16_t const start = pos;
+	uint8_t const header = hist->buf[pos];
+	pos = Wrap(pos + 1);
+
+	if (header & HIST_KEY) {
+		entry->lhs = GetVarint(hist, &pos);
+		entry->rhs = GetVarint(hist, &pos);
+	} else {
+		// first operand defaults to the last result, second to the last second operand
+		entry->lhs = entry->result;
+		if (header & HIST_LHS) {
+			entry->lhs += UnZigZag(GetVarint(hist, &pos));
+		}
+		if (header & HIST_RHS) {
+			entry->rhs += UnZigZag(GetVarint(hist, &pos));
+		}
+	}
+
+	if (header & HIST_META) {
+		entry->op = hist->buf[pos];
+		pos = Wrap(pos + 1);
+		entry->base = hist->buf[pos];
+		pos = Wrap(pos + 1);
+	}
+
+	entry->is_err = !!(header & HIST_ERR);
+	if (entry->is_err) {
+		entry->result = 0;
+	} else if (header & HIST_KEY) {
+		entry->result = GetVarint(hist, &pos);
+	} else {
+		entry->result = entry->lhs + UnZigZag(GetVarint(hist, &pos));
+	}
+
+	return Wrap(pos - start);
+}
+
+/** Drops the oldest block of records. */
+static void EvictBlock(struct History *hist)
+{
+	struct HistoryEntry entry;
+	uint16_t pos = hist->head;
+	uint16_t len = 0;
+
+	// the block ends at the next keyframe
+	do {
+		uint16_t const rec_len = Decode(hist, pos, &entry);
+		pos = Wrap(pos + rec_len);
+		len += rec_len;
+		--hist->count;
+	} while (hist->count && !(hist->buf[pos] & HIST_KEY));
+
+	hist->head = pos;
+	hist->used -= len;
+	if (!hist->count) {
+		// the newest block was dropped, the next record starts a new one
+		hist->block_len = 0;
+	}
+}
+
+void History_Init(struct History *hist)
+{
+	memset(hist, 0, sizeof(*hist));
+}
+
+void History_Push(struct History *hist, struct HistoryEntry const *entry)
+{
+	uint8_t rec[HIST_MAX_RECORD_LEN];
+	uint8_t len;
+
+	// errors have no result; keep it 0 so the next record's deltas decode the same way
+	struct HistoryEntry new_entry = *entry;
+	if (new_entry.is_err) {
+		new_entry.result = 0;
+	}
+	entry = &new_entry;
+
+	do {
+		// start a new block with a keyframe when the newest block is full
+		if (hist->block_len == HISTORY_BLOCK_LEN) {
+			hist->block_len = 0;
+		}
+		len = Encode(&hist->last, entry, hist->block_len == 0, rec);
+		// make room by dropping the oldest blocks; this re-encodes the record
+		// as a keyframe if every block was dropped
+		if (hist->used + len > HISTORY_BUFFER_SIZE) {
+			EvictBlock(hist);
+			len = 0;
+		}
+	} while (!len);
+
+	// copy the record into the ring
+	uint16_t pos = Wrap(hist->head + hist->used);
+	for (uint8_t i = 0; i < len; ++i) {
+		hist->buf[pos] = rec[i];
+		pos = Wrap(pos + 1);
+	}
+
+	hist->used += len;
+	++hist->count;
+	++hist->block_len;
+	hist->last = new_entry;
+}
+
+uint16_t History_GetCount(struct History const *hist)
+{
+	return hist->count;
+}
+
+uint8_t History_Get(struct History const *hist, uint16_t age, struct HistoryEntry *entry)
+{
+	if (age >= hist->count) {
+		return 0;
+	}
+
+	// records are only decodable from the oldest keyframe forward
+	uint16_t pos = hist->head;
+	for (uint16_t i = hist->count - age; i > 0; --i) {
+		pos = Wrap(pos + Decode(hist, pos, entry));
+	}
+	return 1;
+}
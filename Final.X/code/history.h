@@ -0,0 +1,72 @@
+/*
+ * Module to keep a history of calculator operations.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Size of the history ring in bytes; must be a power of 2
+#define HISTORY_BUFFER_SIZE 2048
+// Number of records per block; each block starts with a keyframe
+#define HISTORY_BLOCK_LEN 16
+
+/** An operation in the history. */
+struct HistoryEntry {
+	// first operand
+	uint32_t lhs;
+	// second operand
+	uint32_t rhs;
+	// result of the operation, 0 if it was an error
+	uint32_t result;
+	// operator of the operation
+	uint8_t op;
+	// radix of the numerical base when the operation was run
+	uint8_t base;
+	// whether the operation was an error
+	uint8_t is_err;
+};
+
+/**
+ * A fixed-size ring of history records.
+ *
+ * Each record only stores what changed from the record before it:
+ * the first operand is left out when it's the last result, the second
+ * operand when it's repeated, and the rest are stored as small deltas.
+ * Every HISTORY_BLOCK_LEN records, a keyframe stores every field so the
+ * oldest block can be dropped without re-encoding the records after it.
+ */
+struct History {
+	uint8_t buf[HISTORY_BUFFER_SIZE];
+	// offset of the oldest record, always a keyframe
+	uint16_t head;
+	// number of bytes in use
+	uint16_t used;
+	// number of records
+	uint16_t count;
+	// number of records in the newest block
+	uint8_t block_len;
+	// the newest record, which the next record is encoded against
+	struct HistoryEntry last;
+};
+
+/**
+ * Clears the history.
+ */
+void History_Init(struct History *hist);
+/**
+ * Adds an operation to the history, dropping the oldest block if full.
+ */
+void History_Push(struct History *hist, struct HistoryEntry const *entry);
+/**
+ * Returns the number of operations in the history.
+ */
+uint16_t History_GetCount(struct History const *hist);
+/**
+ * Gets an operation from the history, where age 0 is the newest.
+ * Returns 0 if there is no operation of the given age.
+ */
+uint8_t History_Get(struct History const *hist, uint16_t age, struct HistoryEntry *entry);
@@ -0,0 +1,589 @@
+/*
+ * Module to inspect IEEE 754 binary floating-point numbers.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "ieee754.h"
+#include "bitops.h"
+#include "radix.h"
+#include <string.h>
+
+/** Widths of the fields of a format. */
+struct IeeeLayout {
+	uint8_t exp_bits;
+	uint8_t mant_bits;
+};
+
+static struct IeeeLayout const layouts[IEEE_FORMAT_COUNT] = {
+	{5, 10},
+	{8, 23},
+	{11, 52}
+};
+
+// Words of a multiprecision number, enough for the largest bound of a double (about 2^810)
+#define BIG_WORDS 28
+
+/** A multiprecision unsigned integer, least significant word first. */
+struct Big {
+	uint32_t w[BIG_WORDS];
+	// number of words in use, without leading zero words
+	uint8_t len;
+};
+
+// Largest power of 5 that fits in a word, and its exponent
+#define POW5_WORD 1220703125
+#define POW5_WORD_EXP 13
+
+// Powers of 5 below POW5_WORD
+static uint32_t const pow5_small[POW5_WORD_EXP] = {
+	1, 5, 25, 125, 625, 3125, 15625, 78125, 390625, 1953125, 9765625, 48828125, 244140625
+};
+
+// Most digits of the shortest decimal of a double
+#define DIGITS_MAX 17
+// Digits converted at a time without a 64-bit division
+#define DIGITS_CHUNK 9
+#define DIGITS_CHUNK_SCALE 1000000000
+
+/** Drops the leading zero words of a multiprecision number. */
+static void BigTrim(struct Big *b)
+{
+	while (b->len && !b->w[b->len - 1]) {
+		--b->len;
+	}
+}
+
+/** Sets a multiprecision number to a 64-bit value. */
+static void BigSet(struct Big *b, uint64_t v)
+{
+	b->w[0] = v;
+	b->w[1] = v >> 32;
+	b->len = 2;
+	BigTrim(b);
+}
+
+/** Returns a word of a multiprecision number, 0 above its length. */
+static uint32_t BigWord(struct Big const *b, uint8_t i)
+{
+	return (i < b->len) ? b->w[i] : 0;
+}
+
+/** Returns the number of bits of a multiprecision number. */
+static uint16_t BigBitLen(struct Big const *b)
+{
+	if (!b->len) {
+		return 0;
+	}
+	return 32 * b->len - Bits_Clz(b->w[b->len - 1], 32);
+}
+
+/** Multiplies a multiprecision number by a word. */
+static void BigMulWord(struct Big *b, uint32_t m)
+{
+	uint32_t carry = 0;
+	for (uint8_t i = 0; i < b->len; ++i) {
+		uint64_t const prod = (uint64_t)b->w[i] * m + carry;
+		b->w[i] = prod;
+		carry = prod >> 32;
+	}
+	if (carry) {
+		b->w[b->len++] = carry;
+	}
+}
+
+/** Multiplies a multiprecision number by 5^e, a word at a time. */
+static void BigMulPow5(struct Big *b, uint16_t e)
+{
+	for (; e >= POW5_WORD_EXP; e -= POW5_WORD_EXP) {
+		BigMulWord(b, POW5_WORD);
+	}
+	BigMulWord(b, pow5_small[e]);
+}
+
+/** Adds a multiprecision number to another. */
+static void BigAdd(struct Big *a, struct Big const *b)
+{
+	uint8_t const len = (a->len > b->len) ? a->len : b->len;
+	uint32_t carry = 0;
+	for (uint8_t i = 0; i < len; ++i) {
+		uint64_t const sum = (uint64_t)BigWord(a, i) + BigWord(b, i) + carry;
+		a->w[i] = sum;
+		carry = sum >> 32;
+	}
+	a->len = len;
+	if (carry) {
+		a->w[a->len++] = carry;
+	}
+}
+
+/** Subtracts a multiprecision number from another that is no smaller. */
+static void BigSub(struct Big *a, struct Big const *b)
+{
+	uint32_t borrow = 0;
+	for (uint8_t i = 0; i < a->len; ++i) {
+		uint64_t const diff = (uint64_t)a->w[i] - BigWord(b, i) - borrow;
+		a->w[i] = diff;
+		borrow = (diff >> 32) & 1;
+	}
+	BigTrim(a);
+}
+
+/** Returns a negative number, 0, or a positive number as a is less than, equal to, or greater than b. */
+static int8_t BigCmp(struct Big const *a, struct Big const *b)
+{
+	if (a->len != b->len) {
+		return (a->len > b->len) ? 1 : -1;
+	}
+	for (uint8_t i = a->len; i > 0; --i) {
+		if (a->w[i - 1] != b->w[i - 1]) {
+			return (a->w[i - 1] > b->w[i - 1]) ? 1 : -1;
+		}
+	}
+	return 0;
+}
+
+/** Shifts a multiprecision number left by n bits. */
+static void BigShiftLeft(struct Big *b, uint16_t n)
+{
+	if (!b->len) {
+		return;
+	}
+	uint8_t const words = n / 32;
+	uint8_t const bits = n % 32;
+
+	// move the words from the top down, so none is overwritten before it's read
+	b->w[b->len + words] = 0;
+	for (uint8_t i = b->len; i > 0; --i) {
+		uint32_t const word = b->w[i - 1];
+		if (bits) {
+			b->w[i + words] |= word >> (32 - bits);
+		}
+		b->w[i - 1 + words] = word << bits;
+	}
+	memset(b->w, 0, words * sizeof(*b->w));
+	b->len += words + 1;
+	BigTrim(b);
+}
+
+/** Multiplies a multiprecision number by a 64-bit value. */
+static void BigMul64(struct Big *b, uint64_t m)
+{
+	struct Big high = *b;
+	BigMulWord(b, m);
+	BigMulWord(&high, m >> 32);
+	BigShiftLeft(&high, 32);
+	BigAdd(b, &high);
+}
+
+/** Shifts a multiprecision number right by one bit. */
+static void BigShiftRight1(struct Big *b)
+{
+	for (uint8_t i = 0; i < b->len; ++i) {
+		b->w[i] = (b->w[i] >> 1) | (BigWord(b, i + 1) << 31);
+	}
+	BigTrim(b);
+}
+
+/**
+ * Returns b / 2^n, rounded down, which must fit in 64 bits.
+ * Sets exact to whether nothing was rounded off.
+ */
+static uint64_t BigShiftRight64(struct Big const *b, uint16_t n, uint8_t *exact)
+{
+	uint8_t const words = n / 32;
+	uint8_t const bits = n % 32;
+
+	*exact = 1;
+	for (uint8_t i = 0; i < words && i < b->len; ++i) {
+		if (b->w[i]) {
+			*exact = 0;
+		}
+	}
+	if (BigWord(b, words) & ((1u << bits) - 1)) {
+		*exact = 0;
+	}
+
+	uint64_t quot = (((uint64_t)BigWord(b, words + 1) << 32) | BigWord(b, words)) >> bits;
+	if (bits) {
+		quot |= (uint64_t)BigWord(b, words + 2) << (64 - bits);
+	}
+	return quot;
+}
+
+/**
+ * Returns num / den, rounded down, which must fit in 64 bits; num is left with the remainder.
+ * Sets exact to whether the remainder is 0.
+ */
+static uint64_t BigDiv64(struct Big *num, struct Big const *den, uint8_t *exact)
+{
+	uint64_t quot = 0;
+	int16_t shift = BigBitLen(num) - BigBitLen(den);
+
+	if (shift >= 0) {
+		// binary long division, starting from the highest bit the quotient can have
+		struct Big sub = *den;
+		BigShiftLeft(&sub, shift);
+		for (;;) {
+			if (BigCmp(num, &sub) >= 0) {
+				BigSub(num, &sub);
+				quot |= (uint64_t)1 << shift;
+			}
+			if (--shift < 0) {
+				break;
+			}
+			BigShiftRight1(&sub);
+		}
+	}
+
+	*exact = !num->len;
+	return quot;
+}
+
+/** Returns floor(log10(2^e)) for e up to 1650. */
+static uint16_t Log10Pow2(uint16_t e)
+{
+	return ((uint32_t)e * 78913) >> 18;
+}
+
+/** Returns floor(log10(5^e)) for e up to 2620. */
+static uint16_t Log10Pow5(uint16_t e)
+{
+	return ((uint32_t)e * 732923) >> 20;
+}
+
+uint8_t Ieee_GetWidth(enum IeeeFormat fmt)
+{
+	return 1 + layouts[fmt].exp_bits + layouts[fmt].mant_bits;
+}
+
+uint8_t Ieee_GetExpBits(enum IeeeFormat fmt)
+{
+	return layouts[fmt].exp_bits;
+}
+
+uint8_t Ieee_GetMantBits(enum IeeeFormat fmt)
+{
+	return layouts[fmt].mant_bits;
+}
+
+int16_t Ieee_GetBias(enum IeeeFormat fmt)
+{
+	return (1 << (layouts[fmt].exp_bits - 1)) - 1;
+}
+
+void Ieee_Unpack(enum IeeeFormat fmt, uint64_t bits, struct IeeeFields *fields)
+{
+	struct IeeeLayout const *layout = &layouts[fmt];
+	fields->mant = bits & (((uint64_t)1 << layout->mant_bits) - 1);
+	fields->exp = (bits >> layout->mant_bits) & ((1 << layout->exp_bits) - 1);
+	fields->sign = (bits >> (layout->mant_bits + layout->exp_bits)) & 1;
+}
+
+uint64_t Ieee_Pack(enum IeeeFormat fmt, struct IeeeFields const *fields)
+{
+	struct IeeeLayout const *layout = &layouts[fmt];
+	uint64_t bits = fields->mant & (((uint64_t)1 << layout->mant_bits) - 1);
+	bits |= (uint64_t)(fields->exp & ((1 << layout->exp_bits) - 1)) << layout->mant_bits;
+	bits |= (uint64_t)(fields->sign & 1) << (layout->mant_bits + layout->exp_bits);
+	return bits;
+}
+
+/** Sets bound to (mv + offset) * scale, where num is mv * scale. */
+static void OffsetBound(struct Big *bound, struct Big const *num, struct Big const *scale, int8_t offset)
+{
+	*bound = *num;
+	for (; offset > 0; --offset) {
+		BigAdd(bound, scale);
+	}
+	for (; offset < 0; ++offset) {
+		BigSub(bound, scale);
+	}
+}
+
+/**
+ * Returns (mv + offset) * scale / den, rounded down, where num is mv * scale.
+ * Sets exact to whether there is no remainder.
+ */
+static uint64_t DivBound(struct Big const *num, struct Big const *scale, int8_t offset, struct Big const *den, uint8_t *exact)
+{
+	struct Big bound;
+	OffsetBound(&bound, num, scale, offset);
+	return BigDiv64(&bound, den, exact);
+}
+
+/**
+ * Returns (mv + offset) * scale / 2^shift, rounded down, where num is mv * scale.
+ * Sets exact to whether nothing was rounded off.
+ */
+static uint64_t ShiftBound(struct Big const *num, struct Big const *scale, int8_t offset, uint16_t shift, uint8_t *exact)
+{
+	struct Big bound;
+	OffsetBound(&bound, num, scale, offset);
+	return BigShiftRight64(&bound, shift, exact);
+}
+
+void Ieee_ToDecimal(enum IeeeFormat fmt, uint64_t bits, struct IeeeDecimal *dec)
+{
+	struct IeeeLayout const *layout = &layouts[fmt];
+	struct IeeeFields fields;
+	Ieee_Unpack(fmt, bits, &fields);
+
+	dec->sign = fields.sign;
+	dec->digits = 0;
+	dec->exp = 0;
+	if (fields.exp == (1 << layout->exp_bits) - 1) {
+		dec->kind = fields.mant ? IeeeNan : IeeeInf;
+		return;
+	} else if (!fields.exp && !fields.mant) {
+		dec->kind = IeeeZero;
+		return;
+	}
+	dec->kind = IeeeFinite;
+
+	// the number is m2 * 2^e2, with two more bits so the bounds halfway to the
+	// neighbouring numbers are integers: mv = 4 * m2 lies between mm and mp
+	int16_t const bias = Ieee_GetBias(fmt);
+	int16_t e2;
+	uint64_t m2;
+	if (fields.exp == 0) {
+		// subnormal
+		e2 = 1 - bias - layout->mant_bits - 2;
+		m2 = fields.mant;
+	} else {
+		e2 = fields.exp - bias - layout->mant_bits - 2;
+		m2 = ((uint64_t)1 << layout->mant_bits) | fields.mant;
+	}
+	// round-to-even reads the bounds back as this number if its mantissa is even
+	uint8_t const accept_bounds = !(m2 & 1);
+	// the bound below is closer at the bottom of each power of two
+	int8_t const mm_offset = (fields.mant != 0 || fields.exp <= 1) ? -2 : -1;
+
+	// vr, vp, and vm are mv, mp, and mm * 2^e2 / 10^e10, with e10 chosen like Ryu so
+	// the loop below removes at least one digit unless the bounds are exact
+	struct Big num, scale;
+	uint64_t vr, vp, vm;
+	uint8_t vr_exact, vp_exact, vm_exact;
+	int16_t e10;
+	if (e2 >= 0) {
+		uint16_t const q = Log10Pow2(e2) - (e2 > 3);
+		e10 = q;
+		// m * 2^e2 / 10^q = m * 2^(e2 - q) / 5^q
+		BigSet(&scale, 1);
+		BigShiftLeft(&scale, e2 - q);
+		num = scale;
+		BigMul64(&num, 4 * m2);
+		struct Big den;
+		BigSet(&den, 1);
+		BigMulPow5(&den, q);
+		vr = DivBound(&num, &scale, 0, &den, &vr_exact);
+		vp = DivBound(&num, &scale, 2, &den, &vp_exact);
+		vm = DivBound(&num, &scale, mm_offset, &den, &vm_exact);
+	} else {
+		uint16_t const q = Log10Pow5(-e2) - (-e2 > 1);
+		e10 = q + e2;
+		// m * 2^e2 / 10^(q + e2) = m * 5^(-e2 - q) / 2^q
+		BigSet(&scale, 1);
+		BigMulPow5(&scale, -e2 - q);
+		num = scale;
+		BigMul64(&num, 4 * m2);
+		vr = ShiftBound(&num, &scale, 0, q, &vr_exact);
+		vp = ShiftBound(&num, &scale, 2, q, &vp_exact);
+		vm = ShiftBound(&num, &scale, mm_offset, q, &vm_exact);
+	}
+
+	// an exact bound is only a valid output if it reads back as this number
+	uint8_t vm_trailing_zeros = accept_bounds && vm_exact;
+	uint8_t vr_trailing_zeros = vr_exact;
+	if (!accept_bounds && vp_exact) {
+		--vp;
+	}
+
+	// remove digits while the bounds still differ, tracking the digits removed from vr
+	// to round it, and whether every digit removed from vm and vr was 0
+	uint8_t last_removed = 0;
+	while (vp / 10 > vm / 10) {
+		vm_trailing_zeros &= (vm % 10 == 0);
+		vr_trailing_zeros &= (last_removed == 0);
+		last_removed = vr % 10;
+		vr /= 10;
+		vp /= 10;
+		vm /= 10;
+		++e10;
+	}
+	if (vm_trailing_zeros) {
+		// vm itself is a valid output, so zeros may be removed down to it
+		while (vm % 10 == 0) {
+			vr_trailing_zeros &= (last_removed == 0);
+			last_removed = vr % 10;
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			++e10;
+		}
+	}
+	if (vr_trailing_zeros && last_removed == 5 && vr % 2 == 0) {
+		// exactly halfway, round to even
+		last_removed = 4;
+	}
+
+	// round up if vr is the excluded lower bound, or the removed digits were at least half
+	dec->digits = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed >= 5);
+	dec->exp = e10;
+}
+
+/** Writes the digits of a number and returns how many there are. */
+static uint8_t DigitsToStr(uint64_t digits, char *str)
+{
+	uint8_t len = 0;
+	uint32_t low = digits;
+	if (digits >= DIGITS_CHUNK_SCALE) {
+		// one 64-bit division splits the digits into two chunks that fit in a word
+		uint32_t const high = digits / DIGITS_CHUNK_SCALE;
+		low = digits - (uint64_t)high * DIGITS_CHUNK_SCALE;
+		len = Radix_CountDigits(high, 10);
+		Radix_ToStr(high, 10, str, len);
+		// the low chunk keeps its leading zeros
+		memset(str + len, '0', DIGITS_CHUNK);
+		Radix_ToStr(low, 10, str + len, DIGITS_CHUNK);
+		return len + DIGITS_CHUNK;
+	}
+	len = Radix_CountDigits(low, 10);
+	Radix_ToStr(low, 10, str, len);
+	return len;
+}
+
+/**
+ * Rounds a string of digits to len digits, half up.
+ * Returns 1 if the digits carried into a new leading digit, leaving "1" followed by zeros.
+ */
+static uint8_t RoundDigits(char *digits, uint8_t count, uint8_t len)
+{
+	if (count <= len || digits[len] < '5') {
+		return 0;
+	}
+	for (uint8_t i = len; i > 0; --i) {
+		if (digits[i - 1] != '9') {
+			++digits[i - 1];
+			return 0;
+		}
+		digits[i - 1] = '0';
+	}
+	digits[0] = '1';
+	return 1;
+}
+
+/** Writes a finite decimal in plain or scientific notation, returning its length. */
+static uint8_t DecimalToStr(struct IeeeDecimal const *dec, char *str, uint8_t len)
+{
+	char digits[DIGITS_MAX + 1];
+	uint8_t count = DigitsToStr(dec->digits, digits);
+	// digits before the decimal point, or minus the zeros after it
+	int16_t point = count + dec->exp;
+
+	// plain notation if every integer digit fits, with up to 3 zeros after the point
+	if (point >= -3 && (dec->exp >= 0 ? point <= len : point < len)) {
+		// round off the fraction digits that don't fit after the point, or "0." and zeros
+		uint8_t const keep = len - ((point > 0) ? 1 : 2 - point);
+		if (dec->exp < 0 && count > keep) {
+			if (RoundDigits(digits, count, keep)) {
+				++point;
+				count = 1;
+			} else {
+				count = keep;
+			}
+		}
+		// drop the zeros left by rounding
+		while (count > 1 && count > point && digits[count - 1] == '0') {
+			--count;
+		}
+
+		if (point >= count) {
+			memcpy(str, digits, count);
+			memset(str + count, '0', point - count);
+			return point;
+		} else if (point > 0) {
+			memcpy(str, digits, point);
+			str[point] = '.';
+			memcpy(str + point + 1, digits + point, count - point);
+			return count + 1;
+		} else {
+			str[0] = '0';
+			str[1] = '.';
+			memset(str + 2, '0', -point);
+			memcpy(str + 2 - point, digits, count);
+			return 2 - point + count;
+		}
+	}
+
+	// scientific notation, keeping as many digits as fit; rounding up to a new
+	// leading digit raises the exponent, which may need one more character
+	uint8_t sci_len = 0;
+	for (uint8_t pass = 0; pass < 2; ++pass) {
+		int16_t const exp10 = point - 1;
+		uint8_t const exp_len = (exp10 < 0) + Radix_CountDigits(exp10 < 0 ? -exp10 : exp10, 10);
+		// first digit, 'e', and the exponent, then the point and the other digits if they fit
+		uint8_t keep = count;
+		if (count > 1 && 1 + 1 + exp_len + 1 + (count - 1) > len) {
+			keep = (len > 3 + exp_len) ? len - 2 - exp_len : 1;
+		}
+		if (RoundDigits(digits, count, keep)) {
+			++point;
+			count = 1;
+			continue;
+		}
+		count = keep;
+		// drop the zeros left by rounding
+		while (count > 1 && digits[count - 1] == '0') {
+			--count;
+		}
+
+		str[sci_len++] = digits[0];
+		if (count > 1) {
+			str[sci_len++] = '.';
+			memcpy(str + sci_len, digits + 1, count - 1);
+			sci_len += count - 1;
+		}
+		str[sci_len++] = 'e';
+		if (exp10 < 0) {
+			str[sci_len++] = '-';
+		}
+		Radix_ToStr(exp10 < 0 ? -exp10 : exp10, 10, str + sci_len, exp_len - (exp10 < 0));
+		sci_len += exp_len - (exp10 < 0);
+		break;
+	}
+	return sci_len;
+}
+
+uint8_t Ieee_ToStr(enum IeeeFormat fmt, uint64_t bits, char *str, uint8_t len)
+{
+	struct IeeeDecimal dec;
+	Ieee_ToDecimal(fmt, bits, &dec);
+
+	uint8_t sign_len = 0;
+	if (dec.sign && dec.kind != IeeeNan && len) {
+		str[sign_len++] = '-';
+	}
+
+	char const *word;
+	switch (dec.kind) {
+		case IeeeFinite:
+			return sign_len + DecimalToStr(&dec, str + sign_len, len - sign_len);
+		case IeeeZero:
+			word = "0";
+			break;
+		case IeeeInf:
+			word = "inf";
+			break;
+		default:
+			word = "nan";
+			break;
+	}
+	uint8_t word_len = strlen(word);
+	if (word_len > len - sign_len) {
+		word_len = len - sign_len;
+	}
+	memcpy(str + sign_len, word, word_len);
+	return sign_len + word_len;
+}
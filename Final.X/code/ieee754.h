@@ -0,0 +1,86 @@
+/*
+ * Module to inspect IEEE 754 binary floating-point numbers.
+ *
+ * Only integer arithmetic is used: the fields are unpacked with shifts, and the
+ * decimal value is the shortest that converts back to the same number, found
+ * like Ryu does with the bounds worked out in exact multiprecision integers.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/** Floating-point formats. */
+enum IeeeFormat {
+	// binary16: 1 sign, 5 exponent, and 10 mantissa bits
+	IeeeHalf,
+	// binary32: 1 sign, 8 exponent, and 23 mantissa bits
+	IeeeSingle,
+	// binary64: 1 sign, 11 exponent, and 52 mantissa bits
+	IeeeDouble,
+	IEEE_FORMAT_COUNT
+};
+
+/** The fields of a floating-point number. */
+struct IeeeFields {
+	uint8_t sign;
+	// biased exponent
+	uint16_t exp;
+	// mantissa without the implicit leading bit
+	uint64_t mant;
+};
+
+/** Kinds of floating-point numbers. */
+enum IeeeKind {
+	IeeeFinite,
+	IeeeZero,
+	IeeeInf,
+	IeeeNan
+};
+
+/** A floating-point number in decimal: digits * 10^exp. */
+struct IeeeDecimal {
+	uint8_t kind;
+	uint8_t sign;
+	uint64_t digits;
+	int16_t exp;
+};
+
+/**
+ * Returns the width of a format in bits.
+ */
+uint8_t Ieee_GetWidth(enum IeeeFormat fmt);
+/**
+ * Returns the width of the exponent field of a format in bits.
+ */
+uint8_t Ieee_GetExpBits(enum IeeeFormat fmt);
+/**
+ * Returns the width of the mantissa field of a format in bits.
+ */
+uint8_t Ieee_GetMantBits(enum IeeeFormat fmt);
+/**
+ * Returns the exponent bias of a format.
+ */
+int16_t Ieee_GetBias(enum IeeeFormat fmt);
+/**
+ * Splits the bit pattern of a number into its fields.
+ */
+void Ieee_Unpack(enum IeeeFormat fmt, uint64_t bits, struct IeeeFields *fields);
+/**
+ * Returns the bit pattern of a number with the given fields, each truncated to its width.
+ */
+uint64_t Ieee_Pack(enum IeeeFormat fmt, struct IeeeFields const *fields);
+/**
+ * Converts a number to the shortest decimal that converts back to it,
+ * choosing the closest to the exact value if there are several.
+ */
+void Ieee_ToDecimal(enum IeeeFormat fmt, uint64_t bits, struct IeeeDecimal *dec);
+/**
+ * Writes a number in decimal to str, such as "-1.5", "0.001", or "6.1035156e-5",
+ * using at most len characters. The digits are rounded if the shortest decimal
+ * doesn't fit. Returns the number of characters written; str is not terminated.
+ */
+uint8_t Ieee_ToStr(enum IeeeFormat fmt, uint64_t bits, char *str, uint8_t len);
@@ -49,6 +49,34 @@ void Input_Process(void)
 	swt = SWT_GetGroupValue();
 }
 
+void Input_GetState(struct InputState *state)
+{
+	state->key = key;
+	state->btn = btn;
+	state->swt = swt;
+}
+void Input_GetLastState(struct InputState *state)
+{
+	state->key = last_key;
+	state->btn = last_btn;
+	state->swt = last_swt;
+}
+void Input_Inject(struct InputState const *state)
+{
+	last_key = key;
+	last_btn = btn;
+	last_swt = swt;
+	key = state->key;
+	btn = state->btn;
+	swt = state->swt;
+}
+void Input_SetState(struct InputState const *state)
+{
+	key = last_key = state->key;
+	btn = last_btn = state->btn;
+	swt = last_swt = state->swt;
+}
+
 uint8_t Input_IsNewKey(void)
 {
 	return key != last_key;
@@ -69,6 +97,12 @@ uint8_t Input_GetNewBtn(uint8_t btn_num)
 	// return whether the given button is pressed AND last was not
 	return (btn & mask) && !(last_btn & mask);
 }
+uint8_t Input_GetReleasedBtn(uint8_t btn_num)
+{
+	uint8_t const mask = 1 << btn_num;
+	// return whether the given button is not pressed AND last was
+	return !(btn & mask) && (last_btn & mask);
+}
 uint8_t Input_IsNewBtnGroup(void)
 {
 	return btn != last_btn;
@@ -9,6 +9,14 @@
 
 #include <stdint.h>
 
+/** A snapshot of the pressed key, buttons, and switches. */
+struct InputState {
+	// pressed key, -1 if none
+	int8_t key;
+	uint8_t btn;
+	uint8_t swt;
+};
+
 /**
  * Initializes the Input module.
  * 
@@ -19,6 +27,23 @@ void Input_Init(void);
  * Processes input, updating keys, buttons, and switches.
  */
 void Input_Process(void);
+/**
+ * Gets the current key, buttons, and switches.
+ */
+void Input_GetState(struct InputState *state);
+/**
+ * Gets the input state from before the current one.
+ */
+void Input_GetLastState(struct InputState *state);
+/**
+ * Replaces the input with the given state, as if Input_Process had read it,
+ * so changes from the current state are new presses and releases.
+ */
+void Input_Inject(struct InputState const *state);
+/**
+ * Sets the input to the given state with no changes, so nothing is newly pressed or released.
+ */
+void Input_SetState(struct InputState const *state);
 
 /**
  * Returns whether the pressed key has changed.
@@ -37,6 +62,10 @@ uint8_t Input_GetBtn(uint8_t btn_num);
  * Returns whether the given button is newly pressed (rising edge).
  */
 uint8_t Input_GetNewBtn(uint8_t btn_num);
+/**
+ * Returns whether the given button is newly released (falling edge).
+ */
+uint8_t Input_GetReleasedBtn(uint8_t btn_num);
 /**
  * Returns whether the pressed buttons has changed.
  */
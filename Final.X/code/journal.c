@@ -0,0 +1,200 @@
+/*
+ * Module to keep an undo/redo journal of the calculator state.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "journal.h"
+#include <string.h>
+
+// Entry header: 2 bits per operand for the number of bytes stored, from JOURNAL_NUM_LENS,
+// then a flag for each 1-byte field that changed
+#define JOURNAL_NUM_BITS 2
+#define JOURNAL_NUM_MASK 0x03
+#define JOURNAL_NUM_IDX 0x10
+#define JOURNAL_OP 0x20
+#define JOURNAL_BASE 0x40
+#define JOURNAL_OVF 0x80
+
+// Number of bytes stored for an operand by its code in the header
+static uint8_t const num_lens[4] = {0, 1, 2, 4};
+
+/** Wraps an offset into the journal ring. */
+static uint16_t Wrap(uint16_t pos)
+{
+	return pos & (JOURNAL_BUFFER_SIZE - 1);
+}
+
+/** Returns the code in the header for the number of bytes of an operand's XOR. */
+static uint8_t NumCode(uint32_t delta)
+{
+	if (delta == 0) {
+		return 0;
+	} else if (delta <= 0xFF) {
+		return 1;
+	} else if (delta <= 0xFFFF) {
+		return 2;
+	}
+	return 3;
+}
+
+/** Returns the length of an entry from its header. */
+static uint8_t EntryLen(uint8_t header)
+{
+	uint8_t len = 2;
+	for (uint8_t i = 0; i < 2; ++i) {
+		len += num_lens[(header >> (JOURNAL_NUM_BITS * i)) & JOURNAL_NUM_MASK];
+	}
+	// one byte for each changed 1-byte field
+	for (uint8_t flags = header & ~0x0F; flags; flags &= flags - 1) {
+		++len;
+	}
+	return len;
+}
+
+/** Returns the header of the change between two states, 0 if none. */
+static uint8_t MakeHeader(struct JournalState const *from, struct JournalState const *to)
+{
+	uint8_t header = 0;
+	for (uint8_t i = 0; i < 2; ++i) {
+		header |= NumCode(from->nums[i] ^ to->nums[i]) << (JOURNAL_NUM_BITS * i);
+	}
+	if (from->num_idx != to->num_idx) {
+		header |= JOURNAL_NUM_IDX;
+	}
+	if (from->op != to->op) {
+		header |= JOURNAL_OP;
+	}
+	if (from->base != to->base) {
+		header |= JOURNAL_BASE;
+	}
+	if (from->ovf != to->ovf) {
+		header |= JOURNAL_OVF;
+	}
+	return header;
+}
+
+/** XORs the change of the entry whose payload starts at pos into a state. */
+static void ApplyEntry(struct Journal const *journal, uint8_t header, uint16_t pos, struct JournalState *state)
+{
+	for (uint8_t i = 0; i < 2; ++i) {
+		uint8_t const len = num_lens[(header >> (JOURNAL_NUM_BITS * i)) & JOURNAL_NUM_MASK];
+		// least significant byte first
+		for (uint8_t b = 0; b < len; ++b) {
+			state->nums[i] ^= (uint32_t)journal->buf[pos] << (8 * b);
+			pos = Wrap(pos + 1);
+		}
+	}
+	uint8_t *const fields[] = {&state->num_idx, &state->op, &state->base, &state->ovf};
+	for (uint8_t i = 0; i < 4; ++i) {
+		if (header & (JOURNAL_NUM_IDX << i)) {
+			*fields[i] ^= journal->buf[pos];
+			pos = Wrap(pos + 1);
+		}
+	}
+}
+
+void Journal_Init(struct Journal *journal)
+{
+	memset(journal, 0, sizeof(*journal));
+}
+
+uint8_t Journal_GetEntryLen(struct JournalState const *from, struct JournalState const *to)
+{
+	uint8_t const header = MakeHeader(from, to);
+	return header ? EntryLen(header) : 0;
+}
+
+void Journal_Record(struct Journal *journal, struct JournalState const *from, struct JournalState const *to)
+{
+	uint8_t const header = MakeHeader(from, to);
+	if (!header) {
+		return;
+	}
+	uint8_t entry[JOURNAL_MAX_ENTRY_LEN];
+	uint8_t len = 0;
+
+	entry[len++] = header;
+	for (uint8_t i = 0; i < 2; ++i) {
+		uint32_t delta = from->nums[i] ^ to->nums[i];
+		for (uint8_t b = num_lens[NumCode(delta)]; b; --b) {
+			entry[len++] = delta;
+			delta >>= 8;
+		}
+	}
+	uint8_t const deltas[] = {
+		from->num_idx ^ to->num_idx, from->op ^ to->op, from->base ^ to->base, from->ovf ^ to->ovf
+	};
+	for (uint8_t i = 0; i < 4; ++i) {
+		if (header & (JOURNAL_NUM_IDX << i)) {
+			entry[len++] = deltas[i];
+		}
+	}
+	entry[len++] = header;
+
+	// a new change replaces the changes that could be redone
+	journal->redo_used = 0;
+	journal->redo_count = 0;
+
+	// drop the oldest changes until the entry fits
+	while (JOURNAL_BUFFER_SIZE - journal->undo_used < len) {
+		uint8_t const old_len = EntryLen(journal->buf[journal->tail]);
+		journal->tail = Wrap(journal->tail + old_len);
+		journal->undo_used -= old_len;
+		--journal->undo_count;
+	}
+
+	for (uint8_t i = 0; i < len; ++i) {
+		journal->buf[Wrap(journal->cursor + i)] = entry[i];
+	}
+	journal->cursor = Wrap(journal->cursor + len);
+	journal->undo_used += len;
+	++journal->undo_count;
+}
+
+uint8_t Journal_Undo(struct Journal *journal, struct JournalState *state)
+{
+	if (!journal->undo_count) {
+		return 0;
+	}
+	// the header at the end of the entry gives its length
+	uint8_t const header = journal->buf[Wrap(journal->cursor - 1)];
+	uint8_t const len = EntryLen(header);
+	uint16_t const start = Wrap(journal->cursor - len);
+	ApplyEntry(journal, header, Wrap(start + 1), state);
+
+	journal->cursor = start;
+	journal->undo_used -= len;
+	journal->redo_used += len;
+	--journal->undo_count;
+	++journal->redo_count;
+	return 1;
+}
+
+uint8_t Journal_Redo(struct Journal *journal, struct JournalState *state)
+{
+	if (!journal->redo_count) {
+		return 0;
+	}
+	uint8_t const header = journal->buf[journal->cursor];
+	uint8_t const len = EntryLen(header);
+	ApplyEntry(journal, header, Wrap(journal->cursor + 1), state);
+
+	journal->cursor = Wrap(journal->cursor + len);
+	journal->undo_used += len;
+	journal->redo_used -= len;
+	--journal->redo_count;
+	++journal->undo_count;
+	return 1;
+}
+
+uint16_t Journal_GetUndoCount(struct Journal const *journal)
+{
+	return journal->undo_count;
+}
+
+uint16_t Journal_GetUndoUsed(struct Journal const *journal)
+{
+	return journal->undo_used;
+}
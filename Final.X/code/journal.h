@@ -0,0 +1,77 @@
+/*
+ * Module to keep an undo/redo journal of the calculator state.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Size of the journal ring in bytes; must be a power of 2
+#define JOURNAL_BUFFER_SIZE 512
+// Longest entry: two header bytes, two 4-byte operands, and four 1-byte fields
+#define JOURNAL_MAX_ENTRY_LEN 14
+
+/** The part of the calculator state that changes can be undone for. */
+struct JournalState {
+	uint32_t nums[2];
+	uint8_t num_idx;
+	uint8_t op;
+	uint8_t base;
+	// overflow status bits
+	uint8_t ovf;
+};
+
+/**
+ * A fixed-size ring of changes to the state.
+ *
+ * Each entry stores the XOR of the fields that changed, so the same entry
+ * undoes and redoes a change. Operands only store the bytes that changed.
+ * The header byte is stored at both ends of an entry, so entries can be read
+ * in either direction.
+ */
+struct Journal {
+	uint8_t buf[JOURNAL_BUFFER_SIZE];
+	// offset of the oldest entry
+	uint16_t tail;
+	// offset after the newest entry that can be undone, where redoing starts
+	uint16_t cursor;
+	// number of bytes of the entries that can be undone, and of those that can be redone
+	uint16_t undo_used;
+	uint16_t redo_used;
+	// number of entries that can be undone and redone
+	uint16_t undo_count;
+	uint16_t redo_count;
+};
+
+/**
+ * Clears the journal.
+ */
+void Journal_Init(struct Journal *journal);
+/**
+ * Adds the change between two states, dropping the changes that could be redone,
+ * and the oldest changes if full. Does nothing if the states are the same.
+ */
+void Journal_Record(struct Journal *journal, struct JournalState const *from, struct JournalState const *to);
+/**
+ * Undoes the newest change on a state. Returns 0 if there is nothing to undo.
+ */
+uint8_t Journal_Undo(struct Journal *journal, struct JournalState *state);
+/**
+ * Redoes the last undone change on a state. Returns 0 if there is nothing to redo.
+ */
+uint8_t Journal_Redo(struct Journal *journal, struct JournalState *state);
+/**
+ * Returns the number of changes that can be undone.
+ */
+uint16_t Journal_GetUndoCount(struct Journal const *journal);
+/**
+ * Returns the number of bytes used by the changes that can be undone.
+ */
+uint16_t Journal_GetUndoUsed(struct Journal const *journal);
+/**
+ * Returns the number of bytes the change between two states takes in the journal, 0 if none.
+ */
+uint8_t Journal_GetEntryLen(struct JournalState const *from, struct JournalState const *to);
@@ -0,0 +1,153 @@
+/*
+ * Module to record the input into macros and replay them.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "macro.h"
+#include "input.h"
+#include "calculator.h"
+#include "coretimer.h"
+#include <string.h>
+
+static enum MacroState {
+	MacroIdle,
+	// waiting for the keys and buttons to be released to start recording
+	MacroArmed,
+	MacroRecording,
+	// waiting for the keys and buttons to be released to replay
+	MacroPending
+} state;
+
+static struct InputState events[MACRO_SLOT_COUNT][MACRO_EVENT_COUNT];
+static uint8_t lens[MACRO_SLOT_COUNT];
+
+// slot being recorded or replayed
+static uint8_t slot_idx;
+// number of states recorded so far
+static uint8_t rec_len;
+// number of states recorded up to the last time every key and button was released
+static uint8_t idle_len;
+
+// input states replayed by the last replay, and the core timer ticks it took
+static uint32_t replay_events;
+static uint32_t replay_ticks;
+
+/** Returns whether no key or button is pressed. */
+static uint8_t IsIdle(struct InputState const *input)
+{
+	return input->key < 0 && input->btn == 0;
+}
+
+void Macro_Init(void)
+{
+	memset(events, 0, sizeof(events));
+	memset(lens, 0, sizeof(lens));
+	state = MacroIdle;
+	replay_events = 0;
+	replay_ticks = 0;
+}
+
+/** Runs the calculator on each state of the macro being replayed, then goes back to the real input. */
+static void Replay(struct InputState const *input)
+{
+	struct InputState const *macro = events[slot_idx];
+	uint8_t const len = lens[slot_idx];
+
+	uint32_t const start = CoreTimer_Read();
+	for (uint8_t i = 0; i < len; ++i) {
+		Input_Inject(&macro[i]);
+		Calculator_Process();
+	}
+	replay_ticks = CoreTimer_Read() - start;
+	replay_events = len;
+
+	// the calculator carries on from the real input, with nothing newly pressed
+	Input_SetState(input);
+	state = MacroIdle;
+}
+
+void Macro_Process(void)
+{
+	struct InputState input;
+	Input_GetState(&input);
+
+	switch (state) {
+		case MacroIdle:
+			break;
+		case MacroArmed:
+			// the keys and buttons that started the recording aren't part of it;
+			// the first state is where the replay starts from
+			if (IsIdle(&input)) {
+				events[slot_idx][0] = input;
+				rec_len = 1;
+				idle_len = 1;
+				state = MacroRecording;
+			}
+			break;
+		case MacroRecording:
+			if (!Input_IsNewKey() && !Input_IsNewBtnGroup() && !Input_IsNewSwtGroup()) {
+				break;
+			}
+			if (rec_len == MACRO_EVENT_COUNT) {
+				// the slot is full, keep what fits
+				Macro_Stop();
+				break;
+			}
+			events[slot_idx][rec_len++] = input;
+			if (IsIdle(&input)) {
+				idle_len = rec_len;
+			}
+			break;
+		case MacroPending:
+			if (IsIdle(&input)) {
+				Replay(&input);
+			}
+			break;
+	}
+}
+
+void Macro_Record(uint8_t slot)
+{
+	if (slot >= MACRO_SLOT_COUNT) {
+		return;
+	}
+	slot_idx = slot;
+	lens[slot] = 0;
+	state = MacroArmed;
+}
+
+void Macro_Stop(void)
+{
+	if (state == MacroRecording) {
+		lens[slot_idx] = idle_len;
+	}
+	if (state == MacroArmed || state == MacroRecording) {
+		state = MacroIdle;
+	}
+}
+
+void Macro_Play(uint8_t slot)
+{
+	if (slot >= MACRO_SLOT_COUNT || !lens[slot] || state != MacroIdle) {
+		return;
+	}
+	slot_idx = slot;
+	state = MacroPending;
+}
+
+uint8_t Macro_IsRecording(void)
+{
+	return state == MacroArmed || state == MacroRecording;
+}
+
+uint8_t Macro_GetLen(uint8_t slot)
+{
+	return (slot < MACRO_SLOT_COUNT) ? lens[slot] : 0;
+}
+
+uint32_t Macro_GetReplayRate(void)
+{
+	return CoreTimer_GetRate(replay_events, replay_ticks);
+}
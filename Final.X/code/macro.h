@@ -0,0 +1,56 @@
+/*
+ * Module to record the input into macros and replay them.
+ *
+ * A macro is the list of input states that changed while it was recorded. Replaying
+ * injects each state into the Input module and runs the calculator on it, all within
+ * one loop, so the LCD only shows the result once the macro finishes.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Number of macro slots
+#define MACRO_SLOT_COUNT 4
+// Most input states in a macro; a key press and its release are two states
+#define MACRO_EVENT_COUNT 128
+
+/**
+ * Initializes the Macro module, emptying every slot.
+ */
+void Macro_Init(void);
+/**
+ * Records the input if a macro is recording, or replays a macro if one was started.
+ * Call this after Input_Process and before Calculator_Process.
+ */
+void Macro_Process(void);
+
+/**
+ * Starts recording a macro into a slot, replacing what it held.
+ * Recording starts once every key and button is released.
+ */
+void Macro_Record(uint8_t slot);
+/**
+ * Stops recording, keeping the input up to the last time every key and button was
+ * released, so the keys pressed to stop aren't part of the macro.
+ */
+void Macro_Stop(void);
+/**
+ * Starts replaying the macro in a slot once every key and button is released.
+ */
+void Macro_Play(uint8_t slot);
+/**
+ * Returns whether a macro is recording or waiting to start recording.
+ */
+uint8_t Macro_IsRecording(void);
+/**
+ * Returns the number of input states in the macro in a slot.
+ */
+uint8_t Macro_GetLen(uint8_t slot);
+/**
+ * Returns the input states replayed per second by the last replay, or 0 if not measured.
+ */
+uint32_t Macro_GetReplayRate(void);
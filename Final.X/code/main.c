@@ -24,36 +24,9 @@
 #pragma config JTAGEN = OFF             // JTAG Enable (JTAG Disabled)
 
 #include "config.h"
-#include "peripherals/led.h"
-#include "calculator.h"
-#include "input.h"
-#include "output.h"
+#include "app.h"
 #include "utils.h"
 
-/** Function to initialize all the program modules. Call this once on reset. */
-static void App_Init()
-{
-	// Initialize the LED peripheral
-	LED_Init();
-	// Initialize the input module
-	Input_Init();
-	// Initialize the output module
-	Output_Init();
-	// Initialize the calculator module
-	Calculator_Init();
-}
-
-/** Function to process all the program modules. Call this in a loop. */
-static void App_Process()
-{
-	// Process inputs
-	Input_Process();
-	// Process the calculator
-	Calculator_Process();
-	// Process outputs
-	Output_Process();
-}
-
 int main()
 {
 	// Initialize modules
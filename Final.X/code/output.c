@@ -12,6 +12,12 @@
 
 static char lcd[2][17] = {0};
 static uint8_t update_lcd[2] = {0};
+// what the LCD is currently showing, so only the cells that changed are written
+static char lcd_shown[2][17] = {0};
+
+static uint8_t glyphs[LCD_GLYPH_COUNT][LCD_GLYPH_ROWS] = {0};
+// bit mask of the glyphs that changed
+static uint8_t update_glyphs = 0;
 
 struct RgbColor {
 	uint8_t r;
@@ -30,18 +36,55 @@ void Output_Init(void)
 	// reset LCD string
 	memset(&lcd, 0, sizeof(lcd));
 	memset(&update_lcd, 0, sizeof(update_lcd));
+	// the LCD starts out blank, so the first update writes every cell
+	memset(&lcd_shown, ' ', sizeof(lcd_shown));
+
+	// reset the glyphs
+	memset(&glyphs, 0, sizeof(glyphs));
+	update_glyphs = 0;
 
 	// reset RGB color
 	memset(&rgb_color, 0, sizeof(rgb_color));
 }
 
+/** Writes the cells of a line of the LCD that differ from what it shows. */
+static void WriteLcdChanges(uint8_t idxLine)
+{
+	char const *line = lcd[idxLine];
+	char *shown = lcd_shown[idxLine];
+	// the cell the LCD writes to next, none yet
+	uint8_t pos = LCD_BUFFER_STRLEN;
+
+	for (uint8_t i = 0; i < LCD_BUFFER_STRLEN && line[i]; ++i) {
+		if (line[i] == shown[i]) {
+			continue;
+		}
+		if (pos != i) {
+			// the write position only moves forward by one, so jump to this cell
+			uint8_t const addr = (idxLine == 0 ? 0 : 0x40) + i;
+			LCD_SetWriteDdramPosition(addr);
+		}
+		LCD_WriteDataByte(line[i]);
+		shown[i] = line[i];
+		pos = i + 1;
+	}
+}
+
 void Output_Process(void)
 {
+	// update the custom glyphs; the cells showing them change without being rewritten
+	for (uint8_t i = 0; update_glyphs; ++i) {
+		if (update_glyphs & (1 << i)) {
+			LCD_WriteBytesAtPosCgram(glyphs[i], LCD_GLYPH_ROWS, i * LCD_GLYPH_ROWS);
+			update_glyphs &= ~(1 << i);
+		}
+	}
+
 	// update the LCD output
 	for (int i = 0; i < sizeof(update_lcd) / sizeof(*update_lcd); ++i) {
 		if (update_lcd[i]) {
-			// update this line of the LCD
-			LCD_WriteStringAtPos(lcd[i], i, 0);
+			// update the cells of this line that changed
+			WriteLcdChanges(i);
 		}
 		update_lcd[i] = 0;
 	}
@@ -64,6 +107,14 @@ void Output_SignalLcdUpdate(uint8_t idxLine)
 	update_lcd[idxLine] = 1;
 }
 
+void Output_SetLcdGlyph(uint8_t idxGlyph, uint8_t const *rows)
+{
+	if (memcmp(glyphs[idxGlyph], rows, LCD_GLYPH_ROWS)) {
+		memcpy(glyphs[idxGlyph], rows, LCD_GLYPH_ROWS);
+		update_glyphs |= 1 << idxGlyph;
+	}
+}
+
 void Output_SetRgbColor(uint8_t r, uint8_t g, uint8_t b)
 {
 	rgb_color.r = r;
@@ -12,6 +12,14 @@
 #define LCD_BUFFER_STRLEN 16
 #define LCD_BUFFER_COUNT 2
 
+// Number of custom LCD glyphs
+#define LCD_GLYPH_COUNT 8
+// Character code of the first custom glyph; codes 8-15 show the same glyphs as 0-7,
+// which keeps 0 free for the end of the LCD buffer strings
+#define LCD_GLYPH_CHAR 0x08
+// Number of rows in a glyph, each using the low 5 bits
+#define LCD_GLYPH_ROWS 8
+
 /**
  * Initializes the Output module.
  * 
@@ -32,6 +40,12 @@ char *Output_GetLcdBuffer(uint8_t idxLine);
  */
 void Output_SignalLcdUpdate(uint8_t idxLine);
 
+/**
+ * Sets the rows of a custom LCD glyph, shown by the character LCD_GLYPH_CHAR + idxGlyph.
+ * The LCD is only updated if the glyph changed.
+ */
+void Output_SetLcdGlyph(uint8_t idxGlyph, uint8_t const *rows);
+
 /**
  * Sets the color of the RGB LED.
  */
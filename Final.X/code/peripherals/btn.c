@@ -23,8 +23,6 @@
 /* ************************************************************************** */
 /* Section: Included Files                                                    */
 /* ************************************************************************** */
-#include <xc.h>
-#include <sys/attribs.h>
 #include "config.h"
 #include "peripherals/btn.h"
 
@@ -49,16 +47,11 @@
 static void BTN_ConfigurePins()
 {
     // Configure BTNs as digital inputs.
-    tris_BTN_BTNU = 1;
-    tris_BTN_BTNL = 1;
-    tris_BTN_BTNC = 1;
-    tris_BTN_BTNR = 1;
-    tris_BTN_BTND = 1;
-
-    // disable analog (set pins as digital))
-    ansel_BTN_BTNU = 0;
-    ansel_BTN_BTNL = 0;
-    ansel_BTN_BTNR = 0;
+    Hal_PinMode(pin_BTN_BTNU, HalInput);
+    Hal_PinMode(pin_BTN_BTNL, HalInput);
+    Hal_PinMode(pin_BTN_BTNC, HalInput);
+    Hal_PinMode(pin_BTN_BTNR, HalInput);
+    Hal_PinMode(pin_BTN_BTND, HalInput);
 }
 
 /* ------------------------------------------------------------ */
@@ -112,27 +105,27 @@ unsigned char BTN_GetValue(unsigned char btn)
         case 'U': 
         case 'u': 
         case 0:
-            bResult = prt_BTN_BTNU;
+            bResult = Hal_PinRead(pin_BTN_BTNU);
             break;
         case 'L': 
         case 'l': 
         case 1:
-            bResult = prt_BTN_BTNL;
+            bResult = Hal_PinRead(pin_BTN_BTNL);
             break;
         case 'C': 
         case 'c': 
         case 2:
-            bResult = prt_BTN_BTNC;
+            bResult = Hal_PinRead(pin_BTN_BTNC);
             break;
         case 'R': 
         case 'r': 
         case 3:
-            bResult = prt_BTN_BTNR;
+            bResult = Hal_PinRead(pin_BTN_BTNR);
             break;
         case 'D': 
         case 'd': 
         case 4:
-            bResult = prt_BTN_BTND;
+            bResult = Hal_PinRead(pin_BTN_BTND);
             break;
     }
 
@@ -6,36 +6,21 @@
  */
 
 #include "peripherals/keypad.h"
+#include "profile.h"
 
 void Keypad_Init(void)
 {
-	KEYPAD_COL1_ANSEL = 0; // disable analog input
-	KEYPAD_COL1_RP = 0; // disable remappable pin
-	KEYPAD_COL1_TRIS = 0; // set pin as output
-
-    KEYPAD_COL2_RP = 0; // disable remappable pin
-    KEYPAD_COL2_TRIS = 0; // set pin as output
-
-	KEYPAD_COL3_RP = 0; // disable remappable pin
-	KEYPAD_COL3_TRIS = 0; // set pin as output
-
-	KEYPAD_COL4_RP = 0; // disable remappable pin
-	KEYPAD_COL4_TRIS = 0; // set pin as output
-
-	KEYPAD_ROW1_ANSEL = 0; // disable analog input
-	KEYPAD_ROW1_RP = 0; // disable remappable pin
-	KEYPAD_ROW1_TRIS = 1; // set pin as input
-
-	KEYPAD_ROW2_ANSEL = 0; // disable analog input
-	KEYPAD_ROW2_RP = 0; // disable remappable pin
-	KEYPAD_ROW2_TRIS = 1; // set pin as input
-
-	KEYPAD_ROW3_ANSEL = 0; // disable analog input
-	KEYPAD_ROW3_RP = 0; // disable remappable pin
-	KEYPAD_ROW3_TRIS = 1; // set pin as input
-
-	KEYPAD_ROW4_RP = 0; // disable remappable pin
-	KEYPAD_ROW4_TRIS = 1; // set pin as input
+	// remappable pins keep their default (IO) function from reset
+	Hal_PinMode(KEYPAD_COL1, HalOutput); // set pin as digital output
+	Hal_PinMode(KEYPAD_COL2, HalOutput); // set pin as digital output
+	Hal_PinMode(KEYPAD_COL3, HalOutput); // set pin as digital output
+	Hal_PinMode(KEYPAD_COL4, HalOutput); // set pin as digital output
+
+	// the rows read high unless a pressed button connects them to an active column
+	Hal_PinMode(KEYPAD_ROW1, HalInputPullUp); // set pin as digital input
+	Hal_PinMode(KEYPAD_ROW2, HalInputPullUp); // set pin as digital input
+	Hal_PinMode(KEYPAD_ROW3, HalInputPullUp); // set pin as digital input
+	Hal_PinMode(KEYPAD_ROW4, HalInputPullUp); // set pin as digital input
 }
 
 static uint8_t const keys[4][4] = {
@@ -56,34 +41,35 @@ static uint8_t GetRow(uint8_t cols)
 	uint8_t retval = 0;
 
 	/* set the columns specified; logic low activates the column */
-	KEYPAD_COL1 = ~(cols >> 0) & 0x1;
-	KEYPAD_COL2 = ~(cols >> 1) & 0x1;
-	KEYPAD_COL3 = ~(cols >> 2) & 0x1;
-	KEYPAD_COL4 = ~(cols >> 3) & 0x1;
+	Hal_PinWrite(KEYPAD_COL1, ~(cols >> 0) & 0x1);
+	Hal_PinWrite(KEYPAD_COL2, ~(cols >> 1) & 0x1);
+	Hal_PinWrite(KEYPAD_COL3, ~(cols >> 2) & 0x1);
+	Hal_PinWrite(KEYPAD_COL4, ~(cols >> 3) & 0x1);
 
 	/* find the first row with a pressed button; logic low when pressed */
-	if (!KEYPAD_ROW1) {
+	if (!Hal_PinRead(KEYPAD_ROW1)) {
 		retval = 1;
-	} else if (!KEYPAD_ROW2) {
+	} else if (!Hal_PinRead(KEYPAD_ROW2)) {
 		retval = 2;
-	} else if (!KEYPAD_ROW3) {
+	} else if (!Hal_PinRead(KEYPAD_ROW3)) {
 		retval = 3;
-	} else if (!KEYPAD_ROW4) {
+	} else if (!Hal_PinRead(KEYPAD_ROW4)) {
 		retval = 4;
 	} else {
 		retval = 0;
 	}
 
 	/* disable all columns */
-	KEYPAD_COL1 = 1;
-	KEYPAD_COL2 = 1;
-	KEYPAD_COL3 = 1;
-	KEYPAD_COL4 = 1;
+	Hal_PinWrite(KEYPAD_COL1, 1);
+	Hal_PinWrite(KEYPAD_COL2, 1);
+	Hal_PinWrite(KEYPAD_COL3, 1);
+	Hal_PinWrite(KEYPAD_COL4, 1);
 
 	return retval;
 }
 
-int8_t Keypad_GetKey(void)
+/** Scans the keypad for the key pressed, or -1 if none is. */
+static int8_t ScanKey(void)
 {
 	/* get the first active row with all columns active */
 	uint8_t const row = GetRow(0xF);
@@ -120,3 +106,11 @@ int8_t Keypad_GetKey(void)
 		return -1;
 	}
 }
+
+int8_t Keypad_GetKey(void)
+{
+	PROFILE_START(ProbeKeypad);
+	int8_t const key = ScanKey();
+	PROFILE_END(ProbeKeypad);
+	return key;
+}
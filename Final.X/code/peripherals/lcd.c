@@ -21,11 +21,10 @@
 /* ************************************************************************** */
 /* Section: Included Files                                                    */
 /* ************************************************************************** */
-#include <xc.h>
-#include <sys/attribs.h>
 #include <string.h>
 #include "peripherals/lcd.h"
 #include "utils.h"
+#include "profile.h"
 /* ************************************************************************** */
 
 /* ------------------------------------------------------------ */
@@ -49,24 +48,13 @@
 static void LCD_ConfigurePins()
 {
     // set control pins as digital outputs.
-    tris_LCD_DISP_RS = 0;
-    tris_LCD_DISP_RW = 0;
-    tris_LCD_DISP_EN = 0;
+    // remapable pins keep their default (IO) function from reset
+    Hal_PinMode(pin_LCD_DISP_RS, HalOutput);
+    Hal_PinMode(pin_LCD_DISP_RW, HalOutput);
+    Hal_PinMode(pin_LCD_DISP_EN, HalOutput);
     
-    // disable analog (set pins as digital))
-    ansel_LCD_DISP_RS = 0;
-    
-    // default (IO) function for remapable pins
-    rp_LCD_DISP_RS = 0;
-    rp_LCD_DISP_RW = 0;
-    rp_LCD_DISP_EN = 0;
-    
-    // make data pins digital (disable analog)
-    ansel_LCD_DB2 = 0;
-    ansel_LCD_DB4 = 0;
-    ansel_LCD_DB5 = 0;
-    ansel_LCD_DB6 = 0;
-    ansel_LCD_DB7 = 0;
+    // make data pins digital inputs (disable analog)
+    Hal_PortMode(port_LCD_DATA, msk_LCD_DATA, HalInput);
 }
 
 /* ------------------------------------------------------------ */
@@ -104,8 +92,7 @@ void LCD_Init()
 **		This function writes a byte to the LCD. 
 **      It implements the parallel write using LCD_DISP_RS, LCD_DISP_RW, LCD_DISP_EN, 
 **      LCD_DISP_RS pins, and data pins. 
-**      For a better performance, the data pins are accessed using a pointer to 
-**      the register byte where they are allocated.
+**      For a better performance, the data pins are written together as one port.
 **      This is a low-level function called by LCD write functions, so user should avoid calling it directly.
 **      The function uses pin related definitions from config.h file.
 **      
@@ -115,27 +102,26 @@ void LCD_WriteByte(unsigned char bData)
 {
     DelayAprox100Us(5);  
 	// Configure IO Port data pins as output.
-   tris_LCD_DATA &= ~msk_LCD_DATA;
+    Hal_PortMode(port_LCD_DATA, msk_LCD_DATA, HalOutput);
     DelayAprox100Us(5);  
 	// clear RW
-	lat_LCD_DISP_RW = 0;
+	Hal_PinWrite(pin_LCD_DISP_RW, 0);
 
-    // access data as contiguous 8 bits, using pointer to the LSB byte of LATE register
-    unsigned char *pLCDData = (unsigned char *)(0xBF886430);
-    *pLCDData = bData;
+    // access data as contiguous 8 bits of the port
+    Hal_PortWrite(port_LCD_DATA, msk_LCD_DATA, bData);
 
     DelayAprox100Us(10);   
 
 	// Set En
-	lat_LCD_DISP_EN = 1;    
+	Hal_PinWrite(pin_LCD_DISP_EN, 1);    
 
     DelayAprox100Us(5);
 	// Clear En
-	lat_LCD_DISP_EN = 0;
+	Hal_PinWrite(pin_LCD_DISP_EN, 0);
 
     DelayAprox100Us(5);
 	// Set RW
-	lat_LCD_DISP_RW = 1;
+	Hal_PinWrite(pin_LCD_DISP_RW, 1);
 }
 
 /* ------------------------------------------------------------ */
@@ -160,21 +146,21 @@ unsigned char LCD_ReadByte()
 {
     unsigned char bData;
 	// Configure IO Port data pins as input.
-    tris_LCD_DATA |= msk_LCD_DATA;
+    Hal_PortMode(port_LCD_DATA, msk_LCD_DATA, HalInput);
 	// Set RW
-	lat_LCD_DISP_RW = 1;
+	Hal_PinWrite(pin_LCD_DISP_RW, 1);
 
 	// set RW
-	lat_LCD_DISP_RW = 1;    
+	Hal_PinWrite(pin_LCD_DISP_RW, 1);    
     
 	// Set En
-	lat_LCD_DISP_EN = 1;
+	Hal_PinWrite(pin_LCD_DISP_EN, 1);
 
     DelayAprox100Us(50);   
 
     // Clear En
-	lat_LCD_DISP_EN = 0;
-  	bData = (unsigned char)(prt_LCD_DATA & (unsigned int)msk_LCD_DATA);
+	Hal_PinWrite(pin_LCD_DISP_EN, 0);
+  	bData = (unsigned char)(Hal_PortRead(port_LCD_DATA) & (unsigned int)msk_LCD_DATA);
 	return bData;
 }
 
@@ -196,7 +182,7 @@ unsigned char LCD_ReadByte()
 unsigned char LCD_ReadStatus()
 {
 	// Clear RS
-	lat_LCD_DISP_RS = 0;
+	Hal_PinWrite(pin_LCD_DISP_RS, 0);
     
 	unsigned char bStatus = LCD_ReadByte();
 	return bStatus;
@@ -221,7 +207,7 @@ unsigned char LCD_ReadStatus()
 void LCD_WriteCommand(unsigned char bCmd)
 { 
 	// Clear RS
-	lat_LCD_DISP_RS = 0;
+	Hal_PinWrite(pin_LCD_DISP_RS, 0);
 
 	// Write command byte
 	LCD_WriteByte(bCmd);
@@ -246,11 +232,13 @@ void LCD_WriteCommand(unsigned char bCmd)
 */
 void LCD_WriteDataByte(unsigned char bData)
 {
+	PROFILE_START(ProbeLcdByte);
 	// Set RS 
-	lat_LCD_DISP_RS = 1;
+	Hal_PinWrite(pin_LCD_DISP_RS, 1);
 
 	// Write data byte
 	LCD_WriteByte(bData);
+	PROFILE_END(ProbeLcdByte);
 }
 
 
@@ -435,6 +423,7 @@ void LCD_CursorShift(unsigned char fRight)
 */
 void LCD_WriteStringAtPos(char *szLn, unsigned char idxLine, unsigned char idxPos)
 {
+	PROFILE_START(ProbeLcdString);
 	// crop string to 0x27 chars
 	int len = strlen(szLn);
 	if(len > 0x27)
@@ -453,6 +442,7 @@ void LCD_WriteStringAtPos(char *szLn, unsigned char idxLine, unsigned char idxPo
 		LCD_WriteDataByte(szLn[bIdx]);
 		bIdx++;
 	}
+	PROFILE_END(ProbeLcdString);
 }
 
 /* ------------------------------------------------------------ */
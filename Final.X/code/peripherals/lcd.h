@@ -14,24 +14,30 @@
 
 #pragma once
 
+#include "hal/hal.h"
+
 #define tris_LCD_DISP_RS    TRISBbits.TRISB15
 #define lat_LCD_DISP_RS     LATBbits.LATB15
 #define ansel_LCD_DISP_RS   ANSELBbits.ANSB15
 #define rp_LCD_DISP_RS      RPB15R
+#define pin_LCD_DISP_RS     HAL_PIN(HalPortB, 15)
 
 
 #define tris_LCD_DISP_RW    TRISDbits.TRISD5
 #define  lat_LCD_DISP_RW    LATDbits.LATD5
 #define rp_LCD_DISP_RW      RPD5R
+#define pin_LCD_DISP_RW     HAL_PIN(HalPortD, 5)
 
 #define tris_LCD_DISP_EN    TRISDbits.TRISD4
 #define  lat_LCD_DISP_EN    LATDbits.LATD4
 #define rp_LCD_DISP_EN      RPD4R
+#define pin_LCD_DISP_EN     HAL_PIN(HalPortD, 4)
 
 #define tris_LCD_DATA       TRISE
 #define lat_LCD_DATA        LATE
 #define prt_LCD_DATA        PORTE
 #define msk_LCD_DATA        0xFF
+#define port_LCD_DATA       HalPortE
 #define  lat_LCD_DATA_ADDR   0xBF886440
 #define ansel_LCD_DB2        ANSELEbits.ANSE2
 #define ansel_LCD_DB4        ANSELEbits.ANSE4
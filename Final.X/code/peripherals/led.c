@@ -23,8 +23,6 @@
 /* ************************************************************************** */
 /* Section: Included Files                                                    */
 /* ************************************************************************** */
-#include <xc.h>
-#include <sys/attribs.h>
 #include "config.h"
 #include "peripherals/led.h"
 
@@ -49,7 +47,7 @@
 static void LED_ConfigurePins()
 {
     // Configure LEDs as digital outputs.
-    tris_LEDS_GRP &= ~msk_LEDS_GRP;
+    Hal_PortMode(port_LEDS_GRP, msk_LEDS_GRP, HalOutput);
 }
 
 /* ------------------------------------------------------------ */
@@ -141,7 +139,7 @@ void LED_SetValue(unsigned char bNo, unsigned char bVal)
 void LED_ToggleValue(unsigned char bNo)
 {
     if (bNo == (bNo & 0x07)) {
-        latinv_LEDS_GRP = (1<<bNo);
+        Hal_PortToggle(port_LEDS_GRP, 1<<bNo);
     }
 }
 
@@ -164,8 +162,7 @@ void LED_ToggleValue(unsigned char bNo)
 */
 void LED_SetGroupValue(unsigned char bVal)
 {
-    unsigned char *pLedData = (unsigned char *)lat_LEDS_GRP_ADDR;
-    *pLedData = bVal;    
+    Hal_PortWrite(port_LEDS_GRP, msk_LEDS_GRP, bVal);
 }
 
 
@@ -38,14 +38,14 @@
 **      The bVal parameter specifies the value for the LED (0 for off, 1 for on). 
 **          
 */
-#define LEDS_Led0SetValue(val) lat_LEDS_LED0 = val
-#define LEDS_Led1SetValue(val) lat_LEDS_LED1 = val
-#define LEDS_Led2SetValue(val) lat_LEDS_LED2 = val
-#define LEDS_Led3SetValue(val) lat_LEDS_LED3 = val
-#define LEDS_Led4SetValue(val) lat_LEDS_LED4 = val
-#define LEDS_Led5SetValue(val) lat_LEDS_LED5 = val
-#define LEDS_Led6SetValue(val) lat_LEDS_LED6 = val
-#define LEDS_Led7SetValue(val) lat_LEDS_LED7 = val
+#define LEDS_Led0SetValue(val) Hal_PinWrite(HAL_PIN(port_LEDS_GRP, 0), val)
+#define LEDS_Led1SetValue(val) Hal_PinWrite(HAL_PIN(port_LEDS_GRP, 1), val)
+#define LEDS_Led2SetValue(val) Hal_PinWrite(HAL_PIN(port_LEDS_GRP, 2), val)
+#define LEDS_Led3SetValue(val) Hal_PinWrite(HAL_PIN(port_LEDS_GRP, 3), val)
+#define LEDS_Led4SetValue(val) Hal_PinWrite(HAL_PIN(port_LEDS_GRP, 4), val)
+#define LEDS_Led5SetValue(val) Hal_PinWrite(HAL_PIN(port_LEDS_GRP, 5), val)
+#define LEDS_Led6SetValue(val) Hal_PinWrite(HAL_PIN(port_LEDS_GRP, 6), val)
+#define LEDS_Led7SetValue(val) Hal_PinWrite(HAL_PIN(port_LEDS_GRP, 7), val)
 
 // function prototypes
 void LED_Init();
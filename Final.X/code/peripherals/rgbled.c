@@ -21,8 +21,6 @@
 /* ************************************************************************** */
 /* Section: Included Files                                                    */
 /* ************************************************************************** */
-#include <xc.h>
-#include <sys/attribs.h>
 #include "config.h"
 #include "peripherals/rgbled.h"
 
@@ -40,9 +38,10 @@ volatile unsigned char bColR, bColG, bColB;
 **      The resulted carry bits are assigned to the digital pins corresponding to each color (LED8_R, LED8_G and LED8_B) 
 **      Carry occurs often for large values and rarely for small values.
 **      Carry bit is cleared in the accumulator.
+**      The HAL calls it from the Timer5 interrupt, and clears the interrupt flag.
 **          
 */
-void __ISR(_TIMER_5_VECTOR, ipl2) Timer5ISR(void) 
+static void Timer5ISR(void) 
 {  
    static unsigned short sAccR = 0, sAccG = 0, sAccB = 0;
     
@@ -52,20 +51,18 @@ void __ISR(_TIMER_5_VECTOR, ipl2) Timer5ISR(void)
     sAccB += bColB;
 
     // take the 9'th bit (addition carry) as the PDM
-    lat_LED8_R = (sAccR & 0x100) ? 1: 0;    
-    lat_LED8_G = (sAccG & 0x100) ? 1: 0;
-    lat_LED8_B = (sAccB & 0x100) ? 1: 0;
+    Hal_PinWrite(pin_LED8_R, sAccR & 0x100);    
+    Hal_PinWrite(pin_LED8_G, sAccG & 0x100);
+    Hal_PinWrite(pin_LED8_B, sAccB & 0x100);
     
     // filter only 8 bits in the accumulator
     sAccR &= 0xFF;
     sAccG &= 0xFF;
     sAccB &= 0xFF;
-    
-    IFS0bits.T5IF = 0;     // clear interrupt flag
 }
 
-// Timer period in seconds
-#define TMR_TIME    0.0003 // 300 us for each tick
+// Timer period in microseconds
+#define TMR_TIME_US 300 // 300 us for each tick
 
 /* ------------------------------------------------------------ */
 /***	Timer5Setup
@@ -79,22 +76,13 @@ void __ISR(_TIMER_5_VECTOR, ipl2) Timer5ISR(void)
 **	Description:
 **		This function configures the Timer5 to be used by RGBLED module.
 **      The timer will generate interrupts every 300 microseconds.
-**      The period constant is computed using TMR_TIME definition (located in this source file)
-**      and peripheral bus frequency definition (PB_FRQ, located in config.h).
+**      The period is given by TMR_TIME_US definition (located in this source file),
+**      and the HAL computes the period register from it.
 **          
 */
 static void RGBLED_Timer5Setup()
 {
-   PR5 = (int)(((float)(TMR_TIME * PB_FRQ) / 256) + 0.5);   //set period register, generates one interrupt every 300 us                     //             set period register, generates one interrupt every 300 us
-  TMR5 = 0;                           //    initialize count to 0
-  T5CONbits.TCKPS = 3;                //    1:256 prescaler value
-  T5CONbits.TGATE = 0;                //    not gated input (the default)
-  T5CONbits.TCS = 0;                  //    PCBLK input (the default)
-  IPC5bits.T5IP = 2;                  //    INT step 4: priority
-  IPC5bits.T5IS = 0;                  //    subpriority
-  IFS0bits.T5IF = 0;                  //    clear interrupt flag
-  IEC0bits.T5IE = 1;                  //    enable interrupt
-  T5CONbits.ON = 1;                   //    turn on Timer5
+  Hal_TimerStart(TMR_TIME_US, Timer5ISR);  //    generates one interrupt every 300 us
   macro_enable_interrupts();          //    enable interrupts at CPU
 }
 
@@ -118,21 +106,14 @@ static void RGBLED_ConfigurePins()
     // Configure RGBLEDs as digital outputs.
 
 //    rp_LED8_R = 0x0B; // LED8_R RPD2 is OC3 - for PWM usage
-    rp_LED8_R = 0;      // no remapable
-    tris_LED8_R = 0;    // output
+    Hal_PinMode(pin_LED8_R, HalOutput);    // output, no remapable from reset
   
     //RPD12R 1011 = OC5
 //   rp_LED8_G = 0x0B; // LED8_G RPD12 is OC5 - for PWM usage
-    rp_LED8_G = 0;      // no remapable
-    tris_LED8_G = 0;    // output
+    Hal_PinMode(pin_LED8_G, HalOutput);    // output, no remapable from reset
  
 //    rp_LED8_B = 0x0B; // LED8_B RPD3 is OC4 - for PWM usage
-    rp_LED8_B = 0;      // no remapable
-    tris_LED8_B = 0;    // output
-    
-    // disable analog (set pins as digital))
-    ansel_LED8_R = 0;
-    ansel_LED8_B = 0;
+    Hal_PinMode(pin_LED8_B, HalOutput);    // output, no remapable from reset
 }
 
 /* ------------------------------------------------------------ */
@@ -153,9 +134,9 @@ void RGBLED_Init()
 {
     RGBLED_ConfigurePins();
     RGBLED_Timer5Setup();
-    lat_LED8_R = 0;
-    lat_LED8_G = 0;
-    lat_LED8_B = 0;
+    Hal_PinWrite(pin_LED8_R, 0);
+    Hal_PinWrite(pin_LED8_G, 0);
+    Hal_PinWrite(pin_LED8_B, 0);
                           
     /*
      // configure Timer2 - for PWM usage
@@ -258,11 +239,11 @@ void RGBLED_SetValueGrouped(unsigned int uiValRGB)
 void RGBLED_Close()
 {
     // stop the timer
-      T5CONbits.ON = 0;   // turn off Timer5
+      Hal_TimerStop();   // turn off Timer5
     // turn off colors
-    lat_LED8_R = 0;
-    lat_LED8_G = 0;
-    lat_LED8_B = 0;
+    Hal_PinWrite(pin_LED8_R, 0);
+    Hal_PinWrite(pin_LED8_G, 0);
+    Hal_PinWrite(pin_LED8_B, 0);
 }
 
 
@@ -22,8 +22,6 @@
 /* ************************************************************************** */
 /* Section: Included Files                                                    */
 /* ************************************************************************** */
-#include <xc.h>
-#include <sys/attribs.h>
 #include "config.h"
 #include "peripherals/swt.h"
 
@@ -47,19 +45,14 @@
 static void SWT_ConfigurePins()
 {
     // Configure SWTs as digital inputs.
-    tris_SWT_SWT0 = 1;
-    tris_SWT_SWT1 = 1;
-    tris_SWT_SWT2 = 1;
-    tris_SWT_SWT3 = 1;
-    tris_SWT_SWT4 = 1;
-    tris_SWT_SWT5 = 1;
-    tris_SWT_SWT6 = 1;
-    tris_SWT_SWT7 = 1;
-
-    // disable analog (set pins as digital))
-    ansel_SWT_SWT5 = 0;
-    ansel_SWT_SWT6 = 0;
-    ansel_SWT_SWT7 = 0;    
+    Hal_PinMode(pin_SWT_SWT0, HalInput);
+    Hal_PinMode(pin_SWT_SWT1, HalInput);
+    Hal_PinMode(pin_SWT_SWT2, HalInput);
+    Hal_PinMode(pin_SWT_SWT3, HalInput);
+    Hal_PinMode(pin_SWT_SWT4, HalInput);
+    Hal_PinMode(pin_SWT_SWT5, HalInput);
+    Hal_PinMode(pin_SWT_SWT6, HalInput);
+    Hal_PinMode(pin_SWT_SWT7, HalInput);
 }
 
 /***	SWT_Init
@@ -103,28 +96,28 @@ unsigned char SWT_GetValue(unsigned char bNo)
 
     switch (bNo) {
         case 0: 
-            bResult = prt_SWT_SWT0;
+            bResult = Hal_PinRead(pin_SWT_SWT0);
             break;
         case 1: 
-            bResult = prt_SWT_SWT1;
+            bResult = Hal_PinRead(pin_SWT_SWT1);
             break;
         case 2: 
-            bResult = prt_SWT_SWT2;
+            bResult = Hal_PinRead(pin_SWT_SWT2);
             break;
         case 3: 
-            bResult = prt_SWT_SWT3;
+            bResult = Hal_PinRead(pin_SWT_SWT3);
             break;
         case 4: 
-            bResult = prt_SWT_SWT4;
+            bResult = Hal_PinRead(pin_SWT_SWT4);
             break;
         case 5: 
-            bResult = prt_SWT_SWT5;
+            bResult = Hal_PinRead(pin_SWT_SWT5);
             break;
         case 6: 
-            bResult = prt_SWT_SWT6;
+            bResult = Hal_PinRead(pin_SWT_SWT6);
             break;
         case 7: 
-            bResult = prt_SWT_SWT7;
+            bResult = Hal_PinRead(pin_SWT_SWT7);
             break;
     }
 
@@ -0,0 +1,65 @@
+/*
+ * Module to profile the program with probes, which time a span of code with the
+ * core timer and keep statistics of the times in a fixed table in RAM.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "profile.h"
+
+#if defined(PROFILE)
+
+#include "bitops.h"
+#include <string.h>
+
+static char const *const names[PROFILE_PROBE_COUNT] = {
+	"App_Process",
+	"Input_Process",
+	"Recorder_Process",
+	"Macro_Process",
+	"Calculator_Process",
+	"Output_Process",
+	"LCD_WriteStringAtPos",
+	"LCD_WriteDataByte",
+	"Keypad_GetKey"
+};
+
+struct ProfileStats profile_stats[PROFILE_PROBE_COUNT];
+
+void Profile_Add(enum ProfileProbe probe, uint32_t ticks)
+{
+	struct ProfileStats *stats = &profile_stats[probe];
+	if (!stats->count || ticks < stats->min) {
+		stats->min = ticks;
+	}
+	if (ticks > stats->max) {
+		stats->max = ticks;
+	}
+	++stats->count;
+	stats->total += ticks;
+
+	// the bucket is the number of significant bits
+	uint8_t bucket = 32 - Bits_Clz(ticks, 32);
+	if (bucket >= PROFILE_BUCKET_COUNT) {
+		bucket = PROFILE_BUCKET_COUNT - 1;
+	}
+	++stats->buckets[bucket];
+}
+
+void Profile_Reset(void)
+{
+	memset(profile_stats, 0, sizeof(profile_stats));
+}
+
+struct ProfileStats const *Profile_GetStats(enum ProfileProbe probe)
+{
+	return &profile_stats[probe];
+}
+
+char const *Profile_GetName(enum ProfileProbe probe)
+{
+	return names[probe];
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*
+ * Module to profile the program with probes, which time a span of code with the
+ * core timer and keep statistics of the times in a fixed table in RAM.
+ *
+ * Each probe keeps the number of times it ran, the least, most, and total ticks, and
+ * a histogram of the ticks by power of 2. The probes are compiled in only when PROFILE
+ * is defined, for example with -DPROFILE or in the preprocessor macros of the project;
+ * otherwise the probes, the table, and the functions compile to nothing. The table can be read with the
+ * debugger from profile_stats, or printed on a PC by host/replay.c.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include "hal/hal.h"
+#include <stdint.h>
+
+// Buckets of the histogram: bucket 0 counts times of 0 ticks, bucket b counts times
+// from 2^(b - 1) to 2^b - 1 ticks, and the last also counts longer times
+#define PROFILE_BUCKET_COUNT 24
+
+// Spans of code timed by the probes
+enum ProfileProbe {
+	// a whole loop of App_Process, and each module it runs
+	ProbeApp,
+	ProbeInput,
+	ProbeRecorder,
+	ProbeMacro,
+	ProbeCalculator,
+	ProbeOutput,
+	// writes of a string and of a byte to the LCD; the Output module writes
+	// only the bytes that changed
+	ProbeLcdString,
+	ProbeLcdByte,
+	// scans of the keypad
+	ProbeKeypad,
+	PROFILE_PROBE_COUNT
+};
+
+/** Statistics of the times a probe measured, in core timer ticks. */
+struct ProfileStats {
+	uint32_t count;
+	uint32_t min;
+	uint32_t max;
+	uint64_t total;
+	uint32_t buckets[PROFILE_BUCKET_COUNT];
+};
+
+#if defined(PROFILE)
+/** Starts timing a span of code with a probe. Ends with PROFILE_END in the same block. */
+#define PROFILE_START(probe) uint32_t const profile_start_##probe = Hal_CoreTimerRead()
+/** Ends timing a span of code with a probe, and adds the time to its statistics. */
+#define PROFILE_END(probe) Profile_Add(probe, Hal_CoreTimerRead() - profile_start_##probe)
+
+extern struct ProfileStats profile_stats[PROFILE_PROBE_COUNT];
+
+/**
+ * Adds a time in ticks to the statistics of a probe.
+ */
+void Profile_Add(enum ProfileProbe probe, uint32_t ticks);
+/**
+ * Clears the statistics of every probe.
+ */
+void Profile_Reset(void);
+/**
+ * Returns the statistics of a probe.
+ */
+struct ProfileStats const *Profile_GetStats(enum ProfileProbe probe);
+/**
+ * Returns the name of a probe.
+ */
+char const *Profile_GetName(enum ProfileProbe probe);
+#else
+#define PROFILE_START(probe) (void)0
+#define PROFILE_END(probe) (void)0
+#endif
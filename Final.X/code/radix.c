@@ -0,0 +1,154 @@
+/*
+ * Module to convert numbers to and from digits in any radix from 2 to 36.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "radix.h"
+#include <string.h>
+
+/**
+ * Division by a constant.
+ * For a power of two, the quotient is num >> shift.
+ * Otherwise, shift is ceil(log2(radix)) and magic is the low 32 bits of the
+ * 33-bit reciprocal 2^(32 + shift) / radix, rounded up (Granlund and Montgomery),
+ * which gives the exact quotient for every 32-bit number.
+ */
+struct RadixDivisor {
+	uint32_t magic;
+	uint8_t shift;
+};
+
+// Divisor of a power of two radix
+#define POW2(shift) {0, (shift)}
+// Divisor of any other radix; the compiler works out the reciprocal
+#define RECIP(radix, shift) {(uint32_t)((((uint64_t)1 << 32) * ((1u << (shift)) - (radix))) / (radix) + 1), (shift)}
+
+static struct RadixDivisor const divisors[RADIX_MAX - RADIX_MIN + 1] = {
+	POW2(1), RECIP(3, 2), POW2(2), RECIP(5, 3), RECIP(6, 3), RECIP(7, 3), POW2(3),
+	RECIP(9, 4), RECIP(10, 4), RECIP(11, 4), RECIP(12, 4), RECIP(13, 4), RECIP(14, 4), RECIP(15, 4), POW2(4),
+	RECIP(17, 5), RECIP(18, 5), RECIP(19, 5), RECIP(20, 5), RECIP(21, 5), RECIP(22, 5), RECIP(23, 5),
+	RECIP(24, 5), RECIP(25, 5), RECIP(26, 5), RECIP(27, 5), RECIP(28, 5), RECIP(29, 5), RECIP(30, 5),
+	RECIP(31, 5), POW2(5),
+	RECIP(33, 6), RECIP(34, 6), RECIP(35, 6), RECIP(36, 6)
+};
+
+static char const digit_chars[RADIX_MAX + 1] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+uint32_t Radix_DivMod(uint32_t num, uint8_t radix, uint8_t *digit)
+{
+	struct RadixDivisor const *div = &divisors[radix - RADIX_MIN];
+	uint32_t quot;
+
+	if (!div->magic) {
+		quot = num >> div->shift;
+	} else {
+		// high word of the product; averaging with num adds the 33rd bit of the reciprocal
+		// without overflowing
+		uint32_t const t = ((uint64_t)num * div->magic) >> 32;
+		quot = (t + ((num - t) >> 1)) >> (div->shift - 1);
+	}
+
+	*digit = num - quot * radix;
+	return quot;
+}
+
+uint8_t Radix_CountDigits(uint32_t num, uint8_t radix)
+{
+	uint8_t count = 0;
+	uint8_t digit;
+	do {
+		num = Radix_DivMod(num, radix, &digit);
+		++count;
+	} while (num);
+	return count;
+}
+
+uint8_t Radix_AppendDigit(uint32_t *num, uint8_t radix, uint8_t digit, uint32_t max)
+{
+	if (digit >= radix) {
+		return 0;
+	}
+	uint64_t const next = (uint64_t)*num * radix + digit;
+	if (next > max) {
+		return 0;
+	}
+	*num = next;
+	return 1;
+}
+
+char Radix_DigitToChar(uint8_t digit)
+{
+	return digit_chars[digit];
+}
+
+int8_t Radix_CharToDigit(char c)
+{
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	} else if (c >= 'A' && c <= 'Z') {
+		return c - 'A' + 10;
+	} else if (c >= 'a' && c <= 'z') {
+		return c - 'a' + 10;
+	} else {
+		return -1;
+	}
+}
+
+void Radix_ToStr(uint32_t num, uint8_t radix, char *str, uint8_t len)
+{
+	uint8_t digit;
+	// set the digits from the right of the string
+	for (uint8_t i = len; i > 0; --i) {
+		num = Radix_DivMod(num, radix, &digit);
+		str[i - 1] = digit_chars[digit];
+		if (!num) {
+			break;
+		}
+	}
+}
+
+/** Returns the largest power of a radix that fits in a word, setting digits to its exponent. */
+static uint32_t WordOfDigits(uint8_t radix, uint8_t *digits)
+{
+	uint32_t scale = radix;
+	*digits = 1;
+	while (scale <= 0xFFFFFFFF / radix) {
+		scale *= radix;
+		++*digits;
+	}
+	return scale;
+}
+
+uint8_t Radix_CountDigits64(uint64_t num, uint8_t radix)
+{
+	uint8_t digits;
+	uint32_t const scale = WordOfDigits(radix, &digits);
+	uint8_t count = 0;
+	while (num >> 32) {
+		num /= scale;
+		count += digits;
+	}
+	return count + Radix_CountDigits(num, radix);
+}
+
+void Radix_ToStr64(uint64_t num, uint8_t radix, char *str, uint8_t len)
+{
+	uint8_t digits;
+	uint32_t const scale = WordOfDigits(radix, &digits);
+	// split off a word of digits at a time from the right until the rest fits in a word
+	while (num >> 32) {
+		uint64_t const quot = num / scale;
+		uint8_t const word_len = (digits < len) ? digits : len;
+		// the word keeps its leading zeros
+		memset(str + len - word_len, '0', word_len);
+		Radix_ToStr(num - quot * scale, radix, str + len - word_len, word_len);
+		if (len == word_len) {
+			return;
+		}
+		len -= word_len;
+		num = quot;
+	}
+	Radix_ToStr(num, radix, str, len);
+}
@@ -0,0 +1,55 @@
+/*
+ * Module to convert numbers to and from digits in any radix from 2 to 36.
+ *
+ * Digits are found without a hardware divide: power-of-two radices use shifts,
+ * and the others multiply by a precomputed reciprocal. 64-bit numbers take one
+ * 64-bit division for each word of digits above their low 32 bits.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define RADIX_MIN 2
+#define RADIX_MAX 36
+
+/**
+ * Divides a number by a radix, returning the quotient and setting digit to the remainder.
+ */
+uint32_t Radix_DivMod(uint32_t num, uint8_t radix, uint8_t *digit);
+/**
+ * Returns the number of digits of a number in a radix, at least 1.
+ */
+uint8_t Radix_CountDigits(uint32_t num, uint8_t radix);
+/**
+ * Appends a digit to a number, setting num to num * radix + digit.
+ * Returns 0 and leaves num unchanged if the digit is not valid for the radix
+ * or the result would exceed max.
+ */
+uint8_t Radix_AppendDigit(uint32_t *num, uint8_t radix, uint8_t digit, uint32_t max);
+/**
+ * Returns the character of a digit.
+ */
+char Radix_DigitToChar(uint8_t digit);
+/**
+ * Returns the value of a digit character, or -1 if it is not a digit.
+ * Letters may be upper or lower case.
+ */
+int8_t Radix_CharToDigit(char c);
+/**
+ * Writes the digits of a number right-aligned in the first len characters of str.
+ * Only the lowest len digits are written if the number has more.
+ * The characters left of the digits are not changed.
+ */
+void Radix_ToStr(uint32_t num, uint8_t radix, char *str, uint8_t len);
+/**
+ * Returns the number of digits of a 64-bit number in a radix, at least 1.
+ */
+uint8_t Radix_CountDigits64(uint64_t num, uint8_t radix);
+/**
+ * Writes the digits of a 64-bit number like Radix_ToStr.
+ */
+void Radix_ToStr64(uint64_t num, uint8_t radix, char *str, uint8_t len);
@@ -0,0 +1,141 @@
+/*
+ * Module to record every input sample from reset, so a session can be replayed
+ * exactly on a PC.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "recorder.h"
+
+// Bits of the first byte of a record
+#define FIELD_KEY 0x01
+#define FIELD_BTN 0x02
+#define FIELD_SWT 0x04
+#define COUNT_CONTINUES 0x08
+#define COUNT_SHIFT 4
+
+// Longest record: the first byte, 28 more bits of count, and three fields
+#define MAX_RECORD_LEN 8
+
+static uint8_t recording[RECORDER_BUFFER_SIZE];
+static uint16_t len;
+static uint8_t full;
+// samples recorded, and the sample of the last record
+static uint32_t samples;
+static uint32_t last_record;
+static struct InputState last_state;
+
+/** Writes the count of samples recorded to the start of the recording. */
+static void WriteHeader(void)
+{
+	for (uint8_t i = 0; i < RECORDER_HEADER_LEN; ++i) {
+		recording[i] = samples >> (8 * i);
+	}
+}
+
+void Recorder_Init(void)
+{
+	len = RECORDER_HEADER_LEN;
+	full = 0;
+	samples = 0;
+	last_record = 0;
+	last_state.key = -1;
+	last_state.btn = 0;
+	last_state.swt = 0;
+	WriteHeader();
+}
+
+void Recorder_Process(void)
+{
+	if (full) {
+		return;
+	}
+	struct InputState state;
+	Input_GetState(&state);
+	++samples;
+
+	uint8_t fields = 0;
+	fields |= (state.key != last_state.key) ? FIELD_KEY : 0;
+	fields |= (state.btn != last_state.btn) ? FIELD_BTN : 0;
+	fields |= (state.swt != last_state.swt) ? FIELD_SWT : 0;
+	if (fields) {
+		if (len + MAX_RECORD_LEN > RECORDER_BUFFER_SIZE) {
+			// keep the recording up to the sample before this one
+			--samples;
+			full = 1;
+			return;
+		}
+		uint32_t count = samples - last_record;
+		uint8_t byte = fields | (count << COUNT_SHIFT);
+		count >>= 8 - COUNT_SHIFT;
+		recording[len++] = byte | (count ? COUNT_CONTINUES : 0);
+		while (count) {
+			byte = count & 0x7F;
+			count >>= 7;
+			recording[len++] = byte | (count ? 0x80 : 0);
+		}
+		if (fields & FIELD_KEY) {
+			recording[len++] = state.key;
+		}
+		if (fields & FIELD_BTN) {
+			recording[len++] = state.btn;
+		}
+		if (fields & FIELD_SWT) {
+			recording[len++] = state.swt;
+		}
+		last_record = samples;
+		last_state = state;
+	}
+	WriteHeader();
+}
+
+uint8_t const *Recorder_GetData(uint16_t *data_len)
+{
+	*data_len = len;
+	return recording;
+}
+
+uint32_t Recorder_GetSampleCount(uint8_t const *data)
+{
+	uint32_t count = 0;
+	for (uint8_t i = 0; i < RECORDER_HEADER_LEN; ++i) {
+		count |= (uint32_t)data[i] << (8 * i);
+	}
+	return count;
+}
+
+uint16_t Recorder_ReadRecord(uint8_t const *data, uint16_t data_len, uint16_t pos, uint32_t *count, struct InputState *state)
+{
+	if (pos >= data_len) {
+		return 0;
+	}
+	uint8_t const first = data[pos++];
+	*count = first >> COUNT_SHIFT;
+	uint8_t shift = 8 - COUNT_SHIFT;
+	uint8_t more = first & COUNT_CONTINUES;
+	while (more) {
+		if (pos >= data_len) {
+			return 0;
+		}
+		*count |= (uint32_t)(data[pos] & 0x7F) << shift;
+		more = data[pos++] & 0x80;
+		shift += 7;
+	}
+
+	// the record is cut off if any of its fields are missing
+	uint16_t const fields_end = pos + !!(first & FIELD_KEY) + !!(first & FIELD_BTN) + !!(first & FIELD_SWT);
+	if (fields_end > data_len) {
+		return 0;
+	}
+	if (first & FIELD_KEY) {
+		state->key = data[pos++];
+	}
+	if (first & FIELD_BTN) {
+		state->btn = data[pos++];
+	}
+	if (first & FIELD_SWT) {
+		state->swt = data[pos++];
+	}
+	return pos;
+}
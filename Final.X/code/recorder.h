@@ -0,0 +1,51 @@
+/*
+ * Module to record every input sample from reset, so a session can be replayed
+ * exactly on a PC.
+ *
+ * The recording starts with the number of samples recorded, 4 bytes little-endian.
+ * Each sample that differs from the one before adds a record of the samples since
+ * the last record and the fields that changed, so samples that change nothing take
+ * no room. The first byte of a record holds the changed fields in its low 3 bits,
+ * whether the count continues in bit 3, and the low 4 bits of the count above them.
+ * The rest of the count follows 7 bits a byte, low bits first, with bit 7 set while
+ * it continues. Then come the key, buttons, and switches that changed, a byte each.
+ * The samples before the first start as no key, buttons, or switches.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include "input.h"
+#include <stdint.h>
+
+// Size of the recording in bytes, enough for hours of typing
+#define RECORDER_BUFFER_SIZE 8192
+// Size of the count of samples at the start of a recording
+#define RECORDER_HEADER_LEN 4
+
+/**
+ * Initializes the Recorder module, starting an empty recording.
+ */
+void Recorder_Init(void);
+/**
+ * Records the input sample. Call this right after Input_Process, before anything
+ * changes the input. Stops recording once the recording is full.
+ */
+void Recorder_Process(void);
+/**
+ * Returns the recording, and sets its length.
+ */
+uint8_t const *Recorder_GetData(uint16_t *len);
+
+/**
+ * Returns the number of samples in a recording.
+ */
+uint32_t Recorder_GetSampleCount(uint8_t const *data);
+/**
+ * Reads the record at an offset into a recording, changing state to the sample it
+ * holds and setting the samples since the last record. Returns the offset of the
+ * next record, or 0 at the end of the recording or if the record is cut off.
+ */
+uint16_t Recorder_ReadRecord(uint8_t const *data, uint16_t len, uint16_t pos, uint32_t *count, struct InputState *state);
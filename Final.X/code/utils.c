@@ -16,9 +16,8 @@
 /* ************************************************************************** */
 /* Section: Included Files                                                    */
 /* ************************************************************************** */
-#include <xc.h>
-#include <sys/attribs.h>
 #include "utils.h"
+#include "hal/hal.h"
 /* ************************************************************************** */
 
 /* ------------------------------------------------------------ */
@@ -41,27 +40,12 @@
 **      of microseconds. This delay is not precise.
 **		
 **	Note:
-**		This routine is written with the assumption that the
-**		system clock is 40 MHz.
+**		The delay is implemented by the HAL. On the PIC32 it is a loop
+**		written with the assumption that the system clock is 40 MHz.
 */
 void DelayAprox100Us( unsigned int  t100usDelay )
 {
-    volatile int j;
-    while ( 0 < t100usDelay )
-    {
-        t100usDelay--;
-        j = 14;
-        while ( 0 < j )
-        {
-            j--;
-        }   // end while 
-        asm volatile("nop"); // do nothing
-        asm volatile("nop"); // do nothing
-        asm volatile("nop"); // do nothing
-        asm volatile("nop"); // do nothing
-        asm volatile("nop"); // do nothing
-         
-    }   // end while
+    Hal_Delay100Us(t100usDelay);
 }
 
 /* *****************************************************************************
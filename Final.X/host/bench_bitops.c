@@ -0,0 +1,186 @@
+/*
+ * Host benchmark of the bit manipulation functions against naive bit loops.
+ *
+ * Checks every function against its naive version on random inputs, then
+ * times both over the same inputs.
+ *
+ * Build and run from this directory:
+ *   cc -O2 -I../code -o bench_bitops bench_bitops.c ../code/bitops.c
+ *   ./bench_bitops
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "bitops.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Number of random inputs
+#define INPUT_COUNT 4096
+// Number of passes over the inputs when timing
+#define PASS_COUNT 2000
+// Width used for the width-dependent functions
+#define WIDTH 16
+
+static uint32_t inputs[INPUT_COUNT];
+
+/** Naive popcount, one bit at a time. */
+static uint32_t NaivePopcount(uint32_t x)
+{
+	uint32_t n = 0;
+	for (uint8_t i = 0; i < 32; ++i) {
+		n += (x >> i) & 1;
+	}
+	return n;
+}
+
+/** Naive count leading zeros, one bit at a time. */
+static uint32_t NaiveClz(uint32_t x)
+{
+	uint32_t n = 0;
+	for (int8_t i = WIDTH - 1; i >= 0 && !((x >> i) & 1); --i) {
+		++n;
+	}
+	return n;
+}
+
+/** Naive count leading ones, one bit at a time. */
+static uint32_t NaiveClo(uint32_t x)
+{
+	return NaiveClz(~x);
+}
+
+/** Naive count trailing zeros, one bit at a time. */
+static uint32_t NaiveCtz(uint32_t x)
+{
+	uint32_t n = 0;
+	for (uint8_t i = 0; i < WIDTH && !((x >> i) & 1); ++i) {
+		++n;
+	}
+	return n;
+}
+
+/** Naive parity, one bit at a time. */
+static uint32_t NaiveParity(uint32_t x)
+{
+	return NaivePopcount(x) & 1;
+}
+
+/** Naive bit reverse, one bit at a time. */
+static uint32_t NaiveReverse(uint32_t x)
+{
+	uint32_t rev = 0;
+	for (uint8_t i = 0; i < WIDTH; ++i) {
+		rev = (rev << 1) | ((x >> i) & 1);
+	}
+	return rev;
+}
+
+/** Naive byte swap, one byte at a time. */
+static uint32_t NaiveByteSwap(uint32_t x)
+{
+	uint32_t swap = 0;
+	for (uint8_t i = 0; i < WIDTH / 8; ++i) {
+		swap = (swap << 8) | ((x >> (8 * i)) & 0xFF);
+	}
+	return swap;
+}
+
+// Wrappers so every function has the same signature
+static uint32_t FastPopcount(uint32_t x) { return Bits_Popcount(x); }
+static uint32_t FastClz(uint32_t x) { return Bits_Clz(x, WIDTH); }
+static uint32_t FastClo(uint32_t x) { return Bits_Clo(x, WIDTH); }
+static uint32_t FastCtz(uint32_t x) { return Bits_Ctz(x, WIDTH); }
+static uint32_t FastParity(uint32_t x) { return Bits_Parity(x); }
+static uint32_t FastReverse(uint32_t x) { return Bits_Reverse(x, WIDTH); }
+static uint32_t FastByteSwap(uint32_t x) { return Bits_ByteSwap(x, WIDTH); }
+
+/** A function and its naive version. */
+struct Bench {
+	char const *name;
+	uint32_t (*fast)(uint32_t);
+	uint32_t (*naive)(uint32_t);
+	// whether the function only uses the low WIDTH bits
+	uint8_t is_width;
+};
+
+static struct Bench const benches[] = {
+	{"popcount", FastPopcount, NaivePopcount, 0},
+	{"clz", FastClz, NaiveClz, 1},
+	{"clo", FastClo, NaiveClo, 1},
+	{"ctz", FastCtz, NaiveCtz, 1},
+	{"parity", FastParity, NaiveParity, 0},
+	{"reverse", FastReverse, NaiveReverse, 1},
+	{"byteswap", FastByteSwap, NaiveByteSwap, 1},
+};
+
+/** Returns the current time in seconds. */
+static double Now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/** Returns the nanoseconds per call of a function over every input. */
+static double Time(uint32_t (*fn)(uint32_t), uint8_t is_width)
+{
+	uint32_t const mask = is_width ? (1u << WIDTH) - 1 : 0xFFFFFFFF;
+	// the sum keeps the calls from being optimized out
+	volatile uint32_t sink;
+	uint32_t sum = 0;
+
+	double const start = Now();
+	for (uint32_t pass = 0; pass < PASS_COUNT; ++pass) {
+		for (uint32_t i = 0; i < INPUT_COUNT; ++i) {
+			sum += fn(inputs[i] & mask);
+		}
+	}
+	double const end = Now();
+
+	sink = sum;
+	(void)sink;
+	return (end - start) * 1e9 / ((double)PASS_COUNT * INPUT_COUNT);
+}
+
+int main(void)
+{
+	int failed = 0;
+
+	srand(1);
+	for (uint32_t i = 0; i < INPUT_COUNT; ++i) {
+		inputs[i] = ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+	}
+	// include the edge cases
+	inputs[0] = 0;
+	inputs[1] = 0xFFFFFFFF;
+	inputs[2] = 1;
+	inputs[3] = 0x8000;
+
+	for (size_t b = 0; b < sizeof(benches) / sizeof(*benches); ++b) {
+		struct Bench const *bench = &benches[b];
+		uint32_t const mask = bench->is_width ? (1u << WIDTH) - 1 : 0xFFFFFFFF;
+		for (uint32_t i = 0; i < INPUT_COUNT; ++i) {
+			uint32_t const x = inputs[i] & mask;
+			if (bench->fast(x) != bench->naive(x)) {
+				printf("%s mismatch on 0x%08X: %u != %u\n", bench->name, x, bench->fast(x), bench->naive(x));
+				failed = 1;
+				break;
+			}
+		}
+	}
+	if (failed) {
+		return 1;
+	}
+
+	printf("%-10s %10s %10s %8s\n", "function", "ns/call", "naive", "speedup");
+	for (size_t b = 0; b < sizeof(benches) / sizeof(*benches); ++b) {
+		struct Bench const *bench = &benches[b];
+		double const fast = Time(bench->fast, bench->is_width);
+		double const naive = Time(bench->naive, bench->is_width);
+		printf("%-10s %10.2f %10.2f %7.1fx\n", bench->name, fast, naive, naive / fast);
+	}
+	return 0;
+}
@@ -0,0 +1,205 @@
+/*
+ * Host benchmark of the sweep mode expressions.
+ *
+ * Checks the stack machine against applying the operators directly on random
+ * expressions, words, and values of x, and the search against a plain loop.
+ * Then reports the evaluations per second of one value at a time and of a search.
+ *
+ * Build and run from this directory:
+ *   cc -O2 -I../code -o bench_expr bench_expr.c ../code/expr.c ../code/bitops.c ../code/radix.c
+ *   ./bench_expr
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "expr.h"
+#include "bitops.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Number of random expressions checked
+#define EXPR_COUNT 4096
+// Number of values of x checked for each expression
+#define X_COUNT 256
+// Most operators in a random expression
+#define MAX_OPS 12
+// Number of evaluations when timing
+#define BENCH_COUNT (1 << 24)
+
+/** An expression as the list of operators and constants it was built from. */
+struct Chain {
+	uint8_t count;
+	enum ExprOp ops[MAX_OPS];
+	uint32_t constants[MAX_OPS];
+};
+
+/** Returns a random 32-bit number. */
+static uint32_t Rand32(void)
+{
+	return ((uint32_t)rand() << 16) ^ (rand() & 0xFFFF);
+}
+
+/** Applies each operator of a chain in turn. Returns 0 if it divides by 0. */
+static int Reference(struct Chain const *chain, uint32_t x, uint8_t width, uint32_t *result)
+{
+	uint32_t const mask = 0xFFFFFFFF >> (32 - width);
+	uint32_t value = x & mask;
+	for (uint8_t i = 0; i < chain->count; ++i) {
+		uint32_t const rhs = chain->constants[i];
+		switch (chain->ops[i]) {
+			case ExprAdd: value += rhs; break;
+			case ExprSub: value -= rhs; break;
+			case ExprMult: value *= rhs; break;
+			case ExprDiv:
+				if (!rhs) {
+					return 0;
+				}
+				value /= rhs;
+				break;
+			case ExprAnd: value &= rhs; break;
+			case ExprOr: value |= rhs; break;
+			case ExprXor: value ^= rhs; break;
+			case ExprPopcount: value = Bits_Popcount(value); break;
+			case ExprClz: value = Bits_Clz(value, width); break;
+			case ExprClo: value = Bits_Clo(value, width); break;
+			case ExprCtz: value = Bits_Ctz(value, width); break;
+			case ExprParity: value = Bits_Parity(value); break;
+			case ExprBitReverse: value = Bits_Reverse(value, width); break;
+			case ExprByteSwap: value = Bits_ByteSwap(value, width); break;
+			default: break;
+		}
+		value &= mask;
+	}
+	*result = value;
+	return 1;
+}
+
+/** Builds a random expression that fits, as a chain and as bytecode. */
+static void RandomExpr(uint8_t width, struct Chain *chain, struct Expr *expr)
+{
+	uint32_t const mask = 0xFFFFFFFF >> (32 - width);
+	Expr_Init(expr);
+	chain->count = 0;
+	uint8_t const count = rand() % (MAX_OPS + 1);
+	for (uint8_t i = 0; i < count; ++i) {
+		enum ExprOp const op = rand() % EXPR_OP_COUNT;
+		// small constants are common, and use the short encodings
+		uint32_t constant = Rand32() >> (rand() % 32);
+		constant &= mask;
+		uint8_t const ok = (op < ExprPopcount) ? Expr_AppendBinary(expr, op, constant) : Expr_AppendUnary(expr, op);
+		if (ok) {
+			chain->ops[chain->count] = op;
+			chain->constants[chain->count] = constant;
+			++chain->count;
+		}
+	}
+}
+
+/** Returns the current time in seconds. */
+static double Now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/** Prints the evaluations per second of an expression, one value at a time and searching. */
+static void Bench(char const *name, struct Expr const *expr)
+{
+	// the sum keeps the calls from being optimized out
+	volatile uint32_t sink;
+	uint32_t sum = 0;
+
+	double start = Now();
+	for (uint32_t x = 0; x < BENCH_COUNT; ++x) {
+		uint32_t result;
+		Expr_Eval(expr, x, 32, &result);
+		sum += result;
+	}
+	double const eval_time = Now() - start;
+
+	// a target that is never reached makes the search try every x
+	uint8_t found;
+	start = Now();
+	sum += Expr_Search(expr, 0, BENCH_COUNT, 32, 0xFFFFFFFF, &found);
+	double const search_time = Now() - start;
+
+	sink = sum;
+	(void)sink;
+	printf("%-16s %12.0f %12.0f\n", name, BENCH_COUNT / eval_time, BENCH_COUNT / search_time);
+}
+
+int main(void)
+{
+	static uint8_t const widths[] = {8, 16, 32};
+	int failed = 0;
+
+	srand(1);
+	for (uint32_t i = 0; i < EXPR_COUNT && !failed; ++i) {
+		uint8_t const width = widths[i % 3];
+		struct Chain chain;
+		struct Expr expr;
+		RandomExpr(width, &chain, &expr);
+
+		for (uint32_t j = 0; j < X_COUNT; ++j) {
+			uint32_t const x = Rand32() & (0xFFFFFFFF >> (32 - width));
+			uint32_t expected, result;
+			int const ok = Reference(&chain, x, width, &expected);
+			if (Expr_Eval(&expr, x, width, &result) != ok || (ok && result != expected)) {
+				char str[255];
+				uint8_t const len = Expr_ToStr(&expr, 16, str, sizeof(str));
+				printf("%.*s at x = 0x%X (%u bits): 0x%X != 0x%X\n", len, str, x, width, result, expected);
+				failed = 1;
+				break;
+			}
+		}
+
+		// the search must find the same first x as trying each in turn
+		if (width <= 16 && !failed) {
+			uint32_t const mask = 0xFFFFFFFF >> (32 - width);
+			uint32_t const start = Rand32() & mask;
+			uint32_t target;
+			Reference(&chain, (start + 100) & mask, width, &target);
+			uint32_t expected = start;
+			int expected_found = 0;
+			for (uint32_t n = 0; n <= mask; ++n, expected = (expected + 1) & mask) {
+				uint32_t value;
+				if (Reference(&chain, expected, width, &value) && value == target) {
+					expected_found = 1;
+					break;
+				}
+			}
+			uint8_t found;
+			uint32_t const x = Expr_Search(&expr, start, mask + 1, width, target, &found);
+			if (found != expected_found || (found && x != expected)) {
+				printf("search from 0x%X for 0x%X: 0x%X != 0x%X\n", start, target, x, expected);
+				failed = 1;
+			}
+		}
+	}
+	if (failed) {
+		return 1;
+	}
+	printf("%u expressions checked\n", EXPR_COUNT);
+
+	printf("%-16s %12s %12s\n", "expression", "eval/s", "search/s");
+	struct Expr expr;
+	Expr_Init(&expr);
+	Bench("x", &expr);
+	Expr_AppendBinary(&expr, ExprMult, 3);
+	Expr_AppendBinary(&expr, ExprAnd, 0xFF);
+	Expr_AppendUnary(&expr, ExprPopcount);
+	Expr_AppendBinary(&expr, ExprAdd, 1);
+	Bench("P(x*3&FF)+1", &expr);
+	Expr_Init(&expr);
+	Expr_AppendBinary(&expr, ExprXor, 0xDEADBEEF);
+	Expr_AppendBinary(&expr, ExprMult, 0x9E3779B9);
+	Expr_AppendUnary(&expr, ExprByteSwap);
+	Expr_AppendBinary(&expr, ExprDiv, 7);
+	Expr_AppendUnary(&expr, ExprBitReverse);
+	Expr_AppendUnary(&expr, ExprClz);
+	Bench("L(R(S(hash)/7))", &expr);
+	return 0;
+}
@@ -0,0 +1,375 @@
+/*
+ * Host benchmark suite of the firmware's hot paths.
+ *
+ * Times the number formatting in each base, the operation of each operator, steps
+ * of the calculator typing a digit and running an operation, Keypad_GetKey against
+ * the PmodKYPD model, Output_Process against the HD44780 model, and a whole
+ * App_Process loop, all in virtual time so delays don't sleep. Each benchmark is
+ * warmed up, then timed in many samples of a batch of calls, and reports the median
+ * and 99th percentile time per call, and the calls per second. The results can be
+ * written as JSON, and two result files compared to flag the benchmarks whose median
+ * grew by more than a threshold, so an optimization can be shown to help and not hurt.
+ *
+ * Build and run from this directory, or with make host-bench from Final.X:
+ *   cc -O2 -I../code -o bench_firmware bench_firmware.c hd44780.c pmodkypd.c \
+ *     $(find ../code -name '*.c' ! -name main.c ! -name hal_pic32.c)
+ *   ./bench_firmware [results.json]
+ *   ./bench_firmware compare old.json new.json [percent]
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "calculator.h"
+#include "hd44780.h"
+#include "pmodkypd.h"
+#include "app.h"
+#include "config.h"
+#include "peripherals/keypad.h"
+#include "hal/hal_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Batches run before timing
+#define WARMUP_BATCHES 16
+// Batches timed
+#define SAMPLE_COUNT 201
+// Least time of a batch, so the clock's resolution doesn't matter
+#define MIN_BATCH_NS 20000
+// Operands cycled through
+#define VALUE_COUNT 1024
+#define MAX_BENCHES 64
+#define NAME_LEN 32
+// Default growth of a median flagged as a regression, in percent
+#define THRESHOLD_PERCENT 5.0
+// Buttons by their bits in the input state
+#define BTN_C_MASK (1 << 2)
+#define BTN_R_MASK (1 << 3)
+
+/** A benchmark: a call run with a parameter, such as the base, and the call's index. */
+struct Bench {
+	char name[NAME_LEN];
+	void (*setup)(uint32_t param);
+	void (*run)(uint32_t param, uint32_t i);
+	uint32_t param;
+};
+
+/** What a benchmark measured, in ns per call. */
+struct Result {
+	char name[NAME_LEN];
+	double median_ns;
+	double p99_ns;
+	double ops_per_s;
+};
+
+static struct CalcState bench_calc;
+static struct CalcEvent bench_event;
+static uint32_t values[VALUE_COUNT];
+// keeps results so the calls aren't optimized out
+static volatile uint32_t sink;
+
+static char const *const op_names[] = {
+	"add", "sub", "mult", "div", "and", "or", "xor", "popcount", "clz", "clo", "ctz", "parity", "bitreverse", "byteswap"
+};
+
+/** Returns the current time in ns. */
+static uint64_t NowNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/** Starts a calculator with 16-bit words in hex, as after reset. */
+static void SetUpCalc(uint32_t param)
+{
+	(void)param;
+	struct CalcDelta delta;
+	Calc_Init(&bench_calc, &delta);
+	memset(&bench_event, 0, sizeof(bench_event));
+	bench_event.input.key = -1;
+	bench_event.last.key = -1;
+}
+
+static void RunNumToStr(uint32_t base, uint32_t i)
+{
+	char str[LCD_BUFFER_STRLEN];
+	Calc_NumToStr(&bench_calc, values[i % VALUE_COUNT], base, str, LCD_BUFFER_STRLEN - 1);
+	sink = str[LCD_BUFFER_STRLEN - 2];
+}
+
+static void RunRunOp(uint32_t op, uint32_t i)
+{
+	uint8_t is_ovf;
+	uint8_t div_0_err;
+	// no divisions by 0, which take the error path
+	uint32_t const rhs = values[(i + 1) % VALUE_COUNT] | 1;
+	sink = Calc_RunOp(&bench_calc, op, values[i % VALUE_COUNT], rhs, &is_ovf, &div_0_err);
+}
+
+/** Runs a step of the bench calculator on a sample of the input. */
+static void StepCalc(int8_t key, uint8_t btn)
+{
+	struct CalcDelta delta;
+	bench_event.last = bench_event.input;
+	bench_event.input.key = key;
+	bench_event.input.btn = btn;
+	Calc_Step(&bench_calc, &bench_event, &delta);
+	sink = bench_calc.nums[bench_calc.num_idx];
+}
+
+static void RunStepDigit(uint32_t param, uint32_t i)
+{
+	(void)param;
+	// a digit pressed then released, and the operand cleared with R after 4 digits,
+	// the most a 16-bit hex operand takes
+	if (i % 10 == 8) {
+		StepCalc(-1, BTN_R_MASK);
+	} else {
+		StepCalc((i & 1) ? -1 : (int8_t)((i >> 1) % 16), 0);
+	}
+}
+
+static void RunStepOperation(uint32_t param, uint32_t i)
+{
+	(void)param;
+	// a digit and C for each operand, so every 8 steps run an operation on 2 operands
+	switch (i % 4) {
+		case 0:
+			StepCalc(1 + values[i % VALUE_COUNT] % 15, 0);
+			break;
+		case 2:
+			StepCalc(-1, BTN_C_MASK);
+			break;
+		default:
+			StepCalc(-1, 0);
+			break;
+	}
+}
+
+static void SetUpKeypad(uint32_t param)
+{
+	(void)param;
+	HalSim_SetRealTime(0);
+	Keypad_Init();
+	PmodKypd_Init();
+}
+
+static void RunKeypad(uint32_t param, uint32_t i)
+{
+	(void)param;
+	// no key every other scan, like a key being tapped
+	PmodKypd_SetPressed((i & 1) ? PMODKYPD_KEY((i >> 1) % 16) : 0);
+	sink = Keypad_GetKey();
+}
+
+static void SetUpOutput(uint32_t param)
+{
+	(void)param;
+	HalSim_SetRealTime(0);
+	Hd44780_Init();
+	Output_Init();
+}
+
+static void RunOutput(uint32_t param, uint32_t i)
+{
+	(void)param;
+	// an operand typed a digit at a time on the second line
+	char *line = Output_GetLcdBuffer(1);
+	snprintf(line, LCD_BUFFER_STRLEN + 1, "+0x%13X", values[i % VALUE_COUNT]);
+	Output_SignalLcdUpdate(1);
+	Output_Process();
+}
+
+static void SetUpApp(uint32_t param)
+{
+	(void)param;
+	HalSim_SetRealTime(0);
+	Hd44780_Init();
+	PmodKypd_Init();
+	PmodKypd_SetPressed(0);
+	App_Init();
+}
+
+static void RunApp(uint32_t param, uint32_t i)
+{
+	(void)param;
+	// a key held for 8 loops out of 16, through the debouncing
+	PmodKypd_SetPressed((i & 8) ? PMODKYPD_KEY((i >> 4) % 16) : 0);
+	App_Process();
+}
+
+/** Runs a batch of calls, and returns the ns it took. */
+static uint64_t RunBatch(struct Bench const *bench, uint32_t count, uint32_t *i)
+{
+	uint64_t const start = NowNs();
+	for (uint32_t n = 0; n < count; ++n, ++*i) {
+		bench->run(bench->param, *i);
+	}
+	return NowNs() - start;
+}
+
+static int CompareDoubles(void const *a, void const *b)
+{
+	double const x = *(double const *)a;
+	double const y = *(double const *)b;
+	return (x > y) - (x < y);
+}
+
+/** Warms up and times a benchmark. */
+static void RunBench(struct Bench const *bench, struct Result *result)
+{
+	static double samples[SAMPLE_COUNT];
+	uint32_t i = 0;
+	bench->setup(bench->param);
+
+	// grow the batch until it takes long enough to time
+	uint32_t count = 1;
+	while (RunBatch(bench, count, &i) < MIN_BATCH_NS) {
+		count *= 2;
+	}
+	for (uint32_t n = 0; n < WARMUP_BATCHES; ++n) {
+		RunBatch(bench, count, &i);
+	}
+
+	double total_ns = 0;
+	for (uint32_t n = 0; n < SAMPLE_COUNT; ++n) {
+		uint64_t const ns = RunBatch(bench, count, &i);
+		samples[n] = (double)ns / count;
+		total_ns += ns;
+	}
+	qsort(samples, SAMPLE_COUNT, sizeof(*samples), CompareDoubles);
+
+	memcpy(result->name, bench->name, sizeof(result->name));
+	result->median_ns = samples[SAMPLE_COUNT / 2];
+	result->p99_ns = samples[SAMPLE_COUNT * 99 / 100];
+	result->ops_per_s = (double)count * SAMPLE_COUNT / total_ns * 1e9;
+}
+
+/** Writes results as JSON, a benchmark a line. */
+static int WriteJson(char const *path, struct Result const *results, uint32_t count)
+{
+	FILE *file = fopen(path, "w");
+	if (!file) {
+		return 0;
+	}
+	fprintf(file, "{\n  \"benchmarks\": [\n");
+	for (uint32_t i = 0; i < count; ++i) {
+		fprintf(file, "    {\"name\": \"%s\", \"median_ns\": %.3f, \"p99_ns\": %.3f, \"ops_per_s\": %.1f}%s\n",
+				results[i].name, results[i].median_ns, results[i].p99_ns, results[i].ops_per_s,
+				(i + 1 < count) ? "," : "");
+	}
+	fprintf(file, "  ]\n}\n");
+	return !fclose(file);
+}
+
+/** Reads results written by WriteJson, and returns how many there are, or -1 if the file can't be read. */
+static int ReadJson(char const *path, struct Result *results)
+{
+	FILE *file = fopen(path, "r");
+	if (!file) {
+		return -1;
+	}
+	char line[256];
+	int count = 0;
+	while (count < MAX_BENCHES && fgets(line, sizeof(line), file)) {
+		struct Result *result = &results[count];
+		if (sscanf(line, " {\"name\": \"%31[^\"]\", \"median_ns\": %lf, \"p99_ns\": %lf, \"ops_per_s\": %lf",
+				result->name, &result->median_ns, &result->p99_ns, &result->ops_per_s) == 4) {
+			++count;
+		}
+	}
+	fclose(file);
+	return count;
+}
+
+/** Compares the medians of two result files, and returns 1 if any grew by more than the threshold. */
+static int Compare(char const *old_path, char const *new_path, double threshold)
+{
+	static struct Result old_results[MAX_BENCHES];
+	static struct Result new_results[MAX_BENCHES];
+	int const old_count = ReadJson(old_path, old_results);
+	int const new_count = ReadJson(new_path, new_results);
+	if (old_count < 0 || new_count < 0) {
+		printf("can't read %s\n", old_count < 0 ? old_path : new_path);
+		return 2;
+	}
+
+	int regressions = 0;
+	printf("%-20s %12s %12s %9s\n", "benchmark", "old ns", "new ns", "change");
+	for (int i = 0; i < new_count; ++i) {
+		struct Result const *new_result = &new_results[i];
+		struct Result const *old_result = NULL;
+		for (int j = 0; j < old_count && !old_result; ++j) {
+			if (!strcmp(old_results[j].name, new_result->name)) {
+				old_result = &old_results[j];
+			}
+		}
+		if (!old_result) {
+			printf("%-20s %12s %12.1f %9s\n", new_result->name, "-", new_result->median_ns, "new");
+			continue;
+		}
+		double const change = (new_result->median_ns / old_result->median_ns - 1) * 100;
+		uint8_t const is_regression = change > threshold;
+		regressions += is_regression;
+		printf("%-20s %12.1f %12.1f %+8.1f%%%s\n", new_result->name, old_result->median_ns, new_result->median_ns,
+				change, is_regression ? "  regression" : "");
+	}
+	printf("%d regressions above %.1f%%\n", regressions, threshold);
+	return regressions ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc > 1 && !strcmp(argv[1], "compare")) {
+		if (argc < 4) {
+			printf("usage: %s compare old.json new.json [percent]\n", argv[0]);
+			return 2;
+		}
+		return Compare(argv[2], argv[3], (argc > 4) ? atof(argv[4]) : THRESHOLD_PERCENT);
+	}
+
+	static struct Bench benches[MAX_BENCHES];
+	uint32_t bench_count = 0;
+	for (uint8_t base = RADIX_MIN; base <= RADIX_MAX; ++base) {
+		struct Bench *bench = &benches[bench_count++];
+		snprintf(bench->name, sizeof(bench->name), "NumToStr/%u", base);
+		bench->setup = SetUpCalc;
+		bench->run = RunNumToStr;
+		bench->param = base;
+	}
+	benches[bench_count++] = (struct Bench){"Calc_Step/digit", SetUpCalc, RunStepDigit, 0};
+	benches[bench_count++] = (struct Bench){"Calc_Step/operation", SetUpCalc, RunStepOperation, 0};
+	for (uint8_t op = Add; op <= ByteSwap; ++op) {
+		struct Bench *bench = &benches[bench_count++];
+		snprintf(bench->name, sizeof(bench->name), "RunOp/%s", op_names[op]);
+		bench->setup = SetUpCalc;
+		bench->run = RunRunOp;
+		bench->param = op;
+	}
+	benches[bench_count++] = (struct Bench){"Keypad_GetKey", SetUpKeypad, RunKeypad, 0};
+	benches[bench_count++] = (struct Bench){"Output_Process", SetUpOutput, RunOutput, 0};
+	benches[bench_count++] = (struct Bench){"App_Process", SetUpApp, RunApp, 0};
+
+	// the same operands every run, within the 16-bit word
+	srand(1);
+	for (uint32_t i = 0; i < VALUE_COUNT; ++i) {
+		values[i] = rand() & 0xFFFF;
+	}
+
+	static struct Result results[MAX_BENCHES];
+	printf("%-20s %12s %12s %14s\n", "benchmark", "median ns", "p99 ns", "ops/s");
+	for (uint32_t i = 0; i < bench_count; ++i) {
+		RunBench(&benches[i], &results[i]);
+		printf("%-20s %12.1f %12.1f %14.0f\n", results[i].name, results[i].median_ns, results[i].p99_ns,
+				results[i].ops_per_s);
+	}
+
+	if (argc > 1 && !WriteJson(argv[1], results, bench_count)) {
+		printf("can't write %s\n", argv[1]);
+		return 2;
+	}
+	return 0;
+}
@@ -0,0 +1,160 @@
+/*
+ * Host benchmark of the history of operations.
+ *
+ * Pushes operations of several mixes into the history, and after each push checks
+ * that History_Get returns every operation still kept as it was pushed, across the
+ * keyframes and as the oldest blocks are dropped when the ring wraps around.
+ * Then reports, for each mix, how many operations 2 KB keeps and their bytes each.
+ *
+ * Build and run from this directory:
+ *   cc -O2 -I../code -o bench_history bench_history.c ../code/history.c
+ *   ./bench_history
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "history.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Number of operations pushed for each mix, enough to wrap the ring many times
+#define PUSH_COUNT 8192
+// Number of operators, as in enum Operator
+#define OP_COUNT 14
+
+/** Mixes of operations, from the cheapest to encode to the most expensive. */
+enum Mix {
+	// each operation goes on from the last result with a small operand
+	MixChained,
+	// the same operation is repeated on the last result, as with = again
+	MixRepeated,
+	// small operands typed fresh each time
+	MixSmall,
+	// any 32-bit operands, operator, and base, with some errors
+	MixWide,
+	// a random pick of the others
+	MixMixed,
+	MIX_COUNT
+};
+
+static char const *const mix_names[MIX_COUNT] = {"chained", "repeated", "small", "wide", "mixed"};
+
+/** Returns a random 32-bit number. */
+static uint32_t Rand32(void)
+{
+	return ((uint32_t)rand() << 16) ^ (uint32_t)rand();
+}
+
+/** Makes the next operation of a mix, given the last one. */
+static void NextEntry(enum Mix mix, struct HistoryEntry const *last, struct HistoryEntry *entry)
+{
+	if (mix == MixMixed) {
+		mix = rand() % MixMixed;
+	}
+	*entry = *last;
+	switch (mix) {
+		case MixChained:
+			entry->lhs = last->result;
+			entry->rhs = rand() % 100;
+			break;
+		case MixRepeated:
+			entry->lhs = last->result;
+			break;
+		case MixSmall:
+			entry->lhs = rand() % 1000;
+			entry->rhs = rand() % 1000;
+			entry->op = rand() % 4;
+			break;
+		case MixWide:
+		default:
+			entry->lhs = Rand32();
+			entry->rhs = Rand32();
+			entry->op = rand() % OP_COUNT;
+			entry->base = 2 + rand() % 35;
+			break;
+	}
+	entry->is_err = (mix == MixWide) && rand() % 16 == 0;
+	// any result does for the history, as long as it's kept
+	entry->result = entry->is_err ? 0 : entry->lhs * 3 + entry->rhs;
+}
+
+/** Returns whether two operations are the same. */
+static uint8_t IsSameEntry(struct HistoryEntry const *a, struct HistoryEntry const *b)
+{
+	return a->lhs == b->lhs && a->rhs == b->rhs && a->result == b->result && a->op == b->op && a->base == b->base
+		&& a->is_err == b->is_err;
+}
+
+/**
+ * Pushes the operations of a mix, checking the history after each push.
+ * Returns 0 if an operation doesn't read back, and sets the average number kept
+ * and bytes used once the ring is full.
+ */
+static uint8_t RunMix(enum Mix mix, double *kept, double *used)
+{
+	static struct History hist;
+	static struct HistoryEntry pushed[PUSH_COUNT];
+	uint64_t full_count = 0;
+	uint64_t full_kept = 0;
+	uint64_t full_used = 0;
+	uint8_t has_wrapped = 0;
+
+	History_Init(&hist);
+	struct HistoryEntry last = {.base = 16};
+	for (uint32_t i = 0; i < PUSH_COUNT; ++i) {
+		NextEntry(mix, &last, &pushed[i]);
+		last = pushed[i];
+		History_Push(&hist, &pushed[i]);
+
+		uint16_t const count = History_GetCount(&hist);
+		if (count == 0 || count > i + 1) {
+			printf("%s, push %u: %u operations kept\n", mix_names[mix], i, count);
+			return 0;
+		}
+		for (uint16_t age = 0; age < count; ++age) {
+			struct HistoryEntry entry;
+			if (!History_Get(&hist, age, &entry) || !IsSameEntry(&entry, &pushed[i - age])) {
+				printf("%s, push %u: operation of age %u doesn't read back\n", mix_names[mix], i, age);
+				return 0;
+			}
+		}
+		struct HistoryEntry entry;
+		if (History_Get(&hist, count, &entry)) {
+			printf("%s, push %u: an operation older than the history reads back\n", mix_names[mix], i);
+			return 0;
+		}
+
+		has_wrapped |= count < i + 1;
+		if (has_wrapped) {
+			++full_count;
+			full_kept += count;
+			full_used += hist.used;
+		}
+	}
+	*kept = full_count ? (double)full_kept / full_count : 0;
+	*used = full_count ? (double)full_used / full_count : 0;
+	return 1;
+}
+
+int main(void)
+{
+	double kept[MIX_COUNT];
+	double used[MIX_COUNT];
+
+	srand(1);
+	for (enum Mix mix = 0; mix < MIX_COUNT; ++mix) {
+		if (!RunMix(mix, &kept[mix], &used[mix])) {
+			return 1;
+		}
+	}
+	printf("%u operations of each mix checked\n", PUSH_COUNT);
+
+	printf("%-10s %14s %14s\n", "mix", "kept/2 KB", "bytes/entry");
+	for (enum Mix mix = 0; mix < MIX_COUNT; ++mix) {
+		printf("%-10s %14.0f %14.2f\n", mix_names[mix], kept[mix], used[mix] / kept[mix]);
+	}
+	printf("full copy  %14zu\n", sizeof(struct HistoryEntry));
+	return 0;
+}
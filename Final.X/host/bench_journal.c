@@ -0,0 +1,193 @@
+/*
+ * Host benchmark of the undo/redo journal.
+ *
+ * Runs random sessions of typing, clearing, and operations through the journal,
+ * checking every undo and redo against a list of full copies of the state.
+ * Then reports the bytes per entry for each kind of change, how many changes
+ * the journal keeps, and the time per undo and redo.
+ *
+ * Build and run from this directory:
+ *   cc -O2 -I../code -o bench_journal bench_journal.c ../code/journal.c
+ *   ./bench_journal
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "journal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Number of changes in each checked session
+#define SESSION_LEN 4096
+// Number of checked sessions
+#define SESSION_COUNT 64
+// Number of undo and redo pairs when timing
+#define BENCH_COUNT (1 << 22)
+
+/** Kinds of changes to the state, like those of the calculator. */
+enum Change {
+	// a digit typed into the current operand
+	ChangeDigit,
+	// the current operand cleared
+	ChangeClear,
+	// the first operand submitted
+	ChangeSubmit,
+	// an operation run, both operands replaced by the result
+	ChangeResult,
+	// the operator or base switched
+	ChangeMeta,
+	CHANGE_COUNT
+};
+
+static char const *const change_names[CHANGE_COUNT] = {"digit", "clear", "submit", "result", "op/base"};
+
+/** Applies a random change of a kind to a state. */
+static void ApplyChange(enum Change change, struct JournalState *state)
+{
+	uint32_t *num = &state->nums[state->num_idx];
+	switch (change) {
+		case ChangeDigit:
+			if (*num <= 0xFFFFFFF) {
+				*num = *num * 16 + rand() % 16;
+			}
+			break;
+		case ChangeClear:
+			*num = 0;
+			break;
+		case ChangeSubmit:
+			state->num_idx = 1;
+			break;
+		case ChangeResult:
+			state->nums[0] = state->nums[0] * 3 + state->nums[1];
+			state->nums[1] = 0;
+			state->num_idx = 0;
+			state->ovf = rand() % 2 ? 0x04 : 0;
+			break;
+		case ChangeMeta:
+			if (rand() % 2) {
+				state->op = rand() % 7;
+			} else {
+				state->base = (rand() % 2) ? 16 : 10;
+			}
+			break;
+		default:
+			break;
+	}
+}
+
+/** Returns a random kind of change, mostly digits like typing. */
+static enum Change RandomChange(void)
+{
+	int const r = rand() % 16;
+	if (r < 10) {
+		return ChangeDigit;
+	} else if (r < 12) {
+		return ChangeClear;
+	} else if (r < 13) {
+		return ChangeSubmit;
+	} else if (r < 15) {
+		return ChangeResult;
+	}
+	return ChangeMeta;
+}
+
+/** Returns the current time in seconds. */
+static double Now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(void)
+{
+	static struct Journal journal;
+	static struct JournalState states[SESSION_LEN + 1];
+	uint64_t change_bytes[CHANGE_COUNT] = {0};
+	uint64_t change_counts[CHANGE_COUNT] = {0};
+	uint64_t kept = 0;
+	int failed = 0;
+
+	srand(1);
+	for (int session = 0; session < SESSION_COUNT && !failed; ++session) {
+		Journal_Init(&journal);
+		memset(&states[0], 0, sizeof(states[0]));
+		states[0].base = 16;
+		// index of the state the journal is at
+		int pos = 0;
+		// index of the newest state that can be redone to
+		int top = 0;
+
+		for (int i = 0; i < SESSION_LEN && !failed; ++i) {
+			int const action = rand() % 8;
+			if (action == 0 && Journal_GetUndoCount(&journal)) {
+				struct JournalState state = states[pos];
+				Journal_Undo(&journal, &state);
+				--pos;
+				failed = memcmp(&state, &states[pos], sizeof(state)) != 0;
+			} else if (action == 1 && pos < top) {
+				struct JournalState state = states[pos];
+				++pos;
+				failed = !Journal_Redo(&journal, &state) || memcmp(&state, &states[pos], sizeof(state)) != 0;
+			} else {
+				enum Change const change = RandomChange();
+				struct JournalState next = states[pos];
+				ApplyChange(change, &next);
+				uint8_t const len = Journal_GetEntryLen(&states[pos], &next);
+				if (!len) {
+					continue;
+				}
+				Journal_Record(&journal, &states[pos], &next);
+				change_bytes[change] += len;
+				++change_counts[change];
+				states[++pos] = next;
+				top = pos;
+			}
+			if (failed) {
+				printf("session %d, change %d: state doesn't match\n", session, i);
+			}
+		}
+
+		// every change kept can be undone back to where the journal starts
+		uint16_t const count = Journal_GetUndoCount(&journal);
+		kept += count;
+		struct JournalState state = states[pos];
+		for (uint16_t i = 0; i < count && !failed; ++i) {
+			Journal_Undo(&journal, &state);
+			failed = memcmp(&state, &states[pos - i - 1], sizeof(state)) != 0;
+		}
+		if (failed) {
+			printf("session %d: undoing everything doesn't match\n", session);
+		}
+	}
+	if (failed) {
+		return 1;
+	}
+	printf("%u sessions checked\n", SESSION_COUNT);
+
+	uint64_t total_bytes = 0;
+	uint64_t total_count = 0;
+	printf("%-10s %12s\n", "change", "bytes/entry");
+	for (int i = 0; i < CHANGE_COUNT; ++i) {
+		printf("%-10s %12.2f\n", change_names[i], (double)change_bytes[i] / change_counts[i]);
+		total_bytes += change_bytes[i];
+		total_count += change_counts[i];
+	}
+	printf("%-10s %12.2f\n", "average", (double)total_bytes / total_count);
+	printf("full copy  %12zu\n", sizeof(struct JournalState));
+	printf("%.0f changes kept in %d bytes\n", (double)kept / SESSION_COUNT, JOURNAL_BUFFER_SIZE);
+
+	// everything was undone, so redo and undo the oldest change over and over
+	struct JournalState state = states[0];
+	double const start = Now();
+	for (uint32_t i = 0; i < BENCH_COUNT; ++i) {
+		Journal_Redo(&journal, &state);
+		Journal_Undo(&journal, &state);
+	}
+	double const end = Now();
+	printf("%.1f ns per undo or redo\n", (end - start) / (2.0 * BENCH_COUNT) * 1e9);
+	return 0;
+}
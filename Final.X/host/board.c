@@ -0,0 +1,67 @@
+/*
+ * The input and output of the Basys MX3 board, for host programs built with the
+ * Linux HAL and the LCD and keypad models.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "board.h"
+#include "pmodkypd.h"
+#include "config.h"
+#include "hal/hal_sim.h"
+#include <string.h>
+
+// the buttons and switches by their bits in the input state
+static uint8_t const btn_pins[BOARD_BTN_COUNT] = {pin_BTN_BTNU, pin_BTN_BTNL, pin_BTN_BTNC, pin_BTN_BTNR, pin_BTN_BTND};
+static uint8_t const swt_pins[BOARD_SWT_COUNT] = {
+	pin_SWT_SWT0, pin_SWT_SWT1, pin_SWT_SWT2, pin_SWT_SWT3, pin_SWT_SWT4, pin_SWT_SWT5, pin_SWT_SWT6, pin_SWT_SWT7
+};
+
+/** Adds bytes to an FNV-1a hash. */
+static void Hash(uint64_t *hash, void const *data, size_t len)
+{
+	uint8_t const *bytes = data;
+	for (size_t i = 0; i < len; ++i) {
+		*hash = (*hash ^ bytes[i]) * 0x100000001B3ULL;
+	}
+}
+
+void Board_DriveInput(struct InputState const *state)
+{
+	PmodKypd_SetPressed((state->key < 0) ? 0 : PMODKYPD_KEY(state->key));
+	for (uint8_t i = 0; i < BOARD_BTN_COUNT; ++i) {
+		uint8_t const pin = btn_pins[i];
+		HalSim_DrivePins(HAL_PIN_PORT(pin), HAL_PIN_MASK(pin), (state->btn & (1 << i)) ? HAL_PIN_MASK(pin) : 0);
+	}
+	for (uint8_t i = 0; i < BOARD_SWT_COUNT; ++i) {
+		uint8_t const pin = swt_pins[i];
+		HalSim_DrivePins(HAL_PIN_PORT(pin), HAL_PIN_MASK(pin), (state->swt & (1 << i)) ? HAL_PIN_MASK(pin) : 0);
+	}
+}
+
+void Board_InitShown(struct BoardShown *shown)
+{
+	memset(shown, 0, sizeof(*shown));
+	// the FNV-1a offset basis
+	shown->hash = 0xCBF29CE484222325ULL;
+}
+
+uint8_t Board_UpdateShown(struct BoardShown *shown, uint64_t now_ns)
+{
+	char lines[2][HD44780_SHOWN_LEN];
+	Hd44780_GetShownLine(0, lines[0]);
+	Hd44780_GetShownLine(1, lines[1]);
+	uint32_t const leds = HalSim_GetLat(port_LEDS_GRP) & msk_LEDS_GRP;
+	if (!memcmp(lines, shown->lines, sizeof(lines)) && leds == shown->leds) {
+		return 0;
+	}
+
+	memcpy(shown->lines, lines, sizeof(lines));
+	shown->leds = leds;
+	Hash(&shown->hash, &now_ns, sizeof(now_ns));
+	Hash(&shown->hash, shown->lines, sizeof(shown->lines));
+	Hash(&shown->hash, &shown->leds, sizeof(shown->leds));
+	++shown->changes;
+	return 1;
+}
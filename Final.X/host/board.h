@@ -0,0 +1,44 @@
+/*
+ * The input and output of the Basys MX3 board, for host programs built with the
+ * Linux HAL and the LCD and keypad models.
+ *
+ * Drives the keypad, buttons, and switches so the Input module reads a sample, and
+ * keeps what the LCD and LEDs show with a hash of every change, so host programs
+ * that run the same input print the same hash.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include "hd44780.h"
+#include "input.h"
+#include <stdint.h>
+
+// Buttons and switches, by their bits in the input state
+#define BOARD_BTN_COUNT 5
+#define BOARD_SWT_COUNT 8
+
+/** What the LCD and LEDs last showed, and the hash of every change and when it was shown. */
+struct BoardShown {
+	char lines[2][HD44780_SHOWN_LEN];
+	uint32_t leds;
+	uint64_t hash;
+	uint32_t changes;
+};
+
+/**
+ * Drives the keypad model and the pins of the buttons and switches so the Input
+ * module reads a sample.
+ */
+void Board_DriveInput(struct InputState const *state);
+/**
+ * Starts keeping what is shown, with a blank LCD, the LEDs off, and no changes.
+ */
+void Board_InitShown(struct BoardShown *shown);
+/**
+ * Reads what the LCD and LEDs show now, and adds it to the hash with the virtual
+ * time given if it changed. Returns whether it changed.
+ */
+uint8_t Board_UpdateShown(struct BoardShown *shown, uint64_t now_ns);
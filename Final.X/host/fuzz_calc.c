@@ -0,0 +1,285 @@
+/*
+ * Fuzz harness for the calculator's state machine, for libFuzzer.
+ *
+ * Decodes the fuzzer's bytes into input events and runs a calculator on them with
+ * Calc_Step, without the peripherals. After each step it checks that:
+ * - each line of the LCD ends within 16 characters
+ * - the operands fit the word, and the base and operand index are in range
+ * - the operand on the first line has only digits valid for the base, and reads
+ *   back as the operand when its overflow flag says it fits
+ * - the overflow flag of the first operand matches whether it fits on the LCD,
+ *   and the RGB LED is red exactly when an overflow flag is set
+ * The first broken invariant is printed and aborts, so libFuzzer keeps the input.
+ *
+ * Each byte is one input: the top 2 bits pick a key tap, a button tap or hold,
+ * a switch flip, or a key tap with the Fn switch on, and the low bits pick which.
+ *
+ * With clang, build and run from this directory; libFuzzer reports execs per second:
+ *   clang -O1 -g -fsanitize=fuzzer,address,undefined -I../code -o fuzz_calc fuzz_calc.c \
+ *     $(find ../code -name '*.c' ! -name main.c ! -name hal_pic32.c)
+ *   ./fuzz_calc corpus/
+ * Without libFuzzer, FUZZ_STANDALONE builds a main that runs random inputs for a number of
+ * seconds and reports execs per second, or runs the given files once:
+ *   cc -O2 -DFUZZ_STANDALONE -I../code -o fuzz_calc fuzz_calc.c \
+ *     $(find ../code -name '*.c' ! -name main.c ! -name hal_pic32.c)
+ *   ./fuzz_calc [seconds | files...]
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "calculator.h"
+#include "radix.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Most input bytes run, to keep each run short
+#define MAX_INPUT_LEN 4096
+
+// Input kinds, in the top 2 bits of a byte
+#define INPUT_KEY 0x00
+#define INPUT_BTN 0x40
+#define INPUT_SWT 0x80
+#define INPUT_FN_KEY 0xC0
+// Bit of a button input that holds or releases it instead of tapping it
+#define BTN_HOLD 0x20
+
+// the Fn switch
+#define FN_SWT_MASK 0x80
+
+/** A calculator being fuzzed, and the input it was last given. */
+struct Fuzz {
+	struct CalcState calc;
+	struct CalcEvent event;
+	uint32_t steps;
+	// the bytes run, to print if an invariant breaks
+	uint8_t const *data;
+	size_t len;
+};
+
+/** Prints a broken invariant with the state and the input, and aborts. */
+static void Fail(struct Fuzz const *fuzz, char const *invariant)
+{
+	struct CalcState const *calc = &fuzz->calc;
+	fprintf(stderr, "invariant broken after step %u: %s\n", fuzz->steps, invariant);
+	fprintf(stderr, "lcd |%.16s|%.16s|\n", calc->lcd_text[0], calc->lcd_text[1]);
+	fprintf(stderr, "nums %X %X, idx %u, base %u, word %u bits, frac %u bits, ovf %X, err %u\n", calc->nums[0],
+			calc->nums[1], calc->num_idx, calc->num_base, calc->word_bits, calc->frac_bits,
+			calc->overflow_stat.is_ovf, calc->is_err);
+	fprintf(stderr, "input:");
+	for (size_t i = 0; i < fuzz->len; ++i) {
+		fprintf(stderr, " %02X", fuzz->data[i]);
+	}
+	fprintf(stderr, "\n");
+	abort();
+}
+
+/** Returns the length of a base's prefix on the LCD, as the calculator writes it. */
+static uint8_t PrefixLen(uint8_t base)
+{
+	if (base == 2) {
+		return 0;
+	} else if (base == 8 || base == 10 || base == 16) {
+		return 2;
+	}
+	return (base < 10 ? 1 : 2) + 1;
+}
+
+/** Returns whether the first line shows the first operand plainly, with nothing else on it. */
+static uint8_t ShowsPlainNum(struct CalcState const *calc)
+{
+	return !calc->is_err && !calc->ieee_on && !calc->field_on && !calc->sweep_state && !calc->checksum_on
+			&& !calc->hist_viewing && !calc->macro_viewing && !(calc->bit_edit && calc->num_idx == 0);
+}
+
+/** Checks the invariants of the state after a step. */
+static void Check(struct Fuzz const *fuzz)
+{
+	struct CalcState const *calc = &fuzz->calc;
+	for (uint8_t i = 0; i < LCD_BUFFER_COUNT; ++i) {
+		if (!memchr(calc->lcd_text[i], 0, LCD_BUFFER_STRLEN + 1)) {
+			Fail(fuzz, "an LCD line isn't terminated within 16 characters");
+		}
+	}
+	if ((calc->nums[0] | calc->nums[1]) & ~calc->word_mask) {
+		Fail(fuzz, "an operand doesn't fit the word");
+	}
+	if (calc->num_idx > 1 || calc->num_base < RADIX_MIN || calc->num_base > RADIX_MAX) {
+		Fail(fuzz, "the operand index or base is out of range");
+	}
+
+	// the overflow flags are only updated by steps that get past an error
+	if (calc->is_err) {
+		return;
+	}
+	if (calc->rgb[0] != (calc->overflow_stat.is_ovf ? 0x1F : 0)) {
+		Fail(fuzz, "the RGB LED doesn't match the overflow flags");
+	}
+	if (!ShowsPlainNum(calc)) {
+		return;
+	}
+
+	uint8_t const base = calc->num_base;
+	uint32_t const num = calc->nums[0] >> calc->frac_bits;
+	uint8_t len = PrefixLen(base) + Radix_CountDigits(num, base);
+	if (calc->frac_bits) {
+		len += 1 + calc->frac_digits[base];
+	}
+	uint8_t const fits = len <= LCD_BUFFER_STRLEN - 1;
+	if (calc->overflow_stat.fields.num1 == fits) {
+		Fail(fuzz, "the first operand's overflow flag doesn't match whether it fits");
+	}
+
+	// the operand is after the first column and the prefix
+	char const *str = calc->lcd_text[0] + 1 + PrefixLen(base);
+	uint32_t value = 0;
+	uint8_t in_frac = 0;
+	for (; *str; ++str) {
+		if (*str == ' ') {
+			continue;
+		} else if (*str == '.' && calc->frac_bits && !in_frac) {
+			in_frac = 1;
+			continue;
+		}
+		int8_t const digit = Radix_CharToDigit(*str);
+		if (digit < 0 || digit >= base) {
+			Fail(fuzz, "the first line has a digit that isn't valid for the base");
+		}
+		if (!in_frac) {
+			value = value * base + digit;
+		}
+	}
+	if (fits && value != num) {
+		Fail(fuzz, "the first line doesn't read back as the first operand");
+	}
+}
+
+/** Runs the calculator on a sample of the input, and checks it. */
+static void Step(struct Fuzz *fuzz, int8_t key, uint8_t btn, uint8_t swt)
+{
+	struct CalcDelta delta;
+	fuzz->event.last = fuzz->event.input;
+	fuzz->event.input.key = key;
+	fuzz->event.input.btn = btn;
+	fuzz->event.input.swt = swt;
+	Calc_Step(&fuzz->calc, &fuzz->event, &delta);
+	++fuzz->steps;
+	Check(fuzz);
+}
+
+int LLVMFuzzerTestOneInput(uint8_t const *data, size_t len)
+{
+	static struct Fuzz fuzz;
+	struct CalcDelta delta;
+
+	if (len > MAX_INPUT_LEN) {
+		len = MAX_INPUT_LEN;
+	}
+	memset(&fuzz.event, 0, sizeof(fuzz.event));
+	fuzz.event.input.key = -1;
+	fuzz.event.last.key = -1;
+	fuzz.steps = 0;
+	fuzz.data = data;
+	fuzz.len = len;
+	Calc_Init(&fuzz.calc, &delta);
+	Check(&fuzz);
+
+	// the buttons held down, and the switches
+	uint8_t btn = 0;
+	uint8_t swt = 0;
+	for (size_t i = 0; i < len; ++i) {
+		uint8_t const byte = data[i];
+		uint8_t const key = byte & 0xF;
+		switch (byte & 0xC0) {
+			case INPUT_KEY:
+				Step(&fuzz, key, btn, swt);
+				Step(&fuzz, -1, btn, swt);
+				break;
+			case INPUT_BTN: {
+				uint8_t const mask = 1 << ((byte & 0x7) % 5);
+				if (byte & BTN_HOLD) {
+					btn ^= mask;
+					Step(&fuzz, -1, btn, swt);
+				} else {
+					Step(&fuzz, -1, btn | mask, swt);
+					Step(&fuzz, -1, btn & ~mask, swt);
+				}
+				break;
+			}
+			case INPUT_SWT:
+				swt ^= 1 << (byte & 0x7);
+				Step(&fuzz, -1, btn, swt);
+				break;
+			default:
+				Step(&fuzz, -1, btn, swt | FN_SWT_MASK);
+				Step(&fuzz, key, btn, swt | FN_SWT_MASK);
+				Step(&fuzz, -1, btn, swt | FN_SWT_MASK);
+				Step(&fuzz, -1, btn, swt);
+				break;
+		}
+	}
+	return 0;
+}
+
+#ifdef FUZZ_STANDALONE
+#include <time.h>
+
+// Default number of seconds to run random inputs for
+#define RUN_S 10
+// Longest random input
+#define RANDOM_LEN 256
+
+/** Returns the current time in seconds. */
+static double Now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv)
+{
+	static uint8_t data[MAX_INPUT_LEN];
+
+	// run the files given, such as inputs saved by libFuzzer
+	if (argc > 1 && !strtod(argv[1], NULL)) {
+		for (int i = 1; i < argc; ++i) {
+			FILE *file = fopen(argv[i], "rb");
+			if (!file) {
+				printf("can't open %s\n", argv[i]);
+				return 1;
+			}
+			size_t const len = fread(data, 1, sizeof(data), file);
+			fclose(file);
+			LLVMFuzzerTestOneInput(data, len);
+		}
+		printf("%d inputs run\n", argc - 1);
+		return 0;
+	}
+
+	double const seconds = (argc > 1) ? strtod(argv[1], NULL) : RUN_S;
+	uint32_t seed = 1;
+	uint64_t execs = 0;
+	uint64_t bytes = 0;
+	double const start = Now();
+	double now = start;
+	while (now - start < seconds) {
+		for (int i = 0; i < 256; ++i) {
+			seed = seed * 1103515245 + 12345;
+			size_t const len = 1 + (seed >> 16) % RANDOM_LEN;
+			for (size_t j = 0; j < len; ++j) {
+				seed = seed * 1103515245 + 12345;
+				data[j] = seed >> 16;
+			}
+			LLVMFuzzerTestOneInput(data, len);
+			++execs;
+			bytes += len;
+		}
+		now = Now();
+	}
+	printf("%llu random inputs in %.1f s: %.0f execs/s, %.0f input bytes/s\n", (unsigned long long)execs,
+			now - start, execs / (now - start), bytes / (now - start));
+	return 0;
+}
+#endif
@@ -0,0 +1,303 @@
+/*
+ * Cycle-approximate model of the HD44780 LCD controller, for host programs
+ * built with the Linux HAL.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "hd44780.h"
+#include "hal/hal_sim.h"
+#include "peripherals/lcd.h"
+#include <stdio.h>
+#include <string.h>
+
+// Bus timing limits at 3 V, in nanoseconds
+#define T_CYC_E 1000
+#define PW_EH 450
+#define T_AS 60
+#define T_AH 20
+#define T_DSW 195
+#define T_H 10
+// Execution times with the 270 kHz oscillator, in nanoseconds
+#define T_EXEC_LONG 1520000
+#define T_EXEC 37000
+// time for the address counter to move after a data write or read
+#define T_ADD 4000
+// Time from power on until the controller takes instructions
+#define T_POWER_ON 40000000
+
+// Violations of each kind printed before they are only counted
+#define REPORT_LIMIT 4
+
+static char const *const violation_names[HD44780_VIOLATION_COUNT] = {
+	"address setup", "address hold", "E pulse width", "E cycle", "data setup", "data hold", "busy"
+};
+
+/** The controller and the levels it last saw on its pins. */
+struct Hd44780 {
+	char ddram[2][HD44780_LINE_LEN];
+	uint8_t cgram[HD44780_CGRAM_LEN];
+	// address counter, into CGRAM if cgram_mode is set
+	uint8_t ac;
+	uint8_t cgram_mode;
+	// entry mode: move right, and shift the display with the cursor
+	uint8_t increment;
+	uint8_t shift_with_cursor;
+	uint8_t display_on;
+	// how far the display is shifted left
+	uint8_t shift;
+	uint64_t busy_until;
+
+	// levels on the pins
+	uint8_t rs;
+	uint8_t rw;
+	uint8_t en;
+	uint8_t data;
+	// times the levels last changed
+	uint64_t addr_changed;
+	uint64_t data_changed;
+	uint64_t en_rose;
+	uint64_t en_fell;
+	// whether E has risen yet
+	uint8_t started;
+
+	uint32_t violations[HD44780_VIOLATION_COUNT];
+	uint64_t needed_ns;
+	uint32_t writes;
+};
+
+static struct Hd44780 lcd;
+static uint8_t hooked;
+
+/** Counts a violation, and prints the first few of each kind. */
+static void Violation(enum Hd44780Violation violation, uint64_t now, uint64_t ns)
+{
+	if (lcd.violations[violation]++ < REPORT_LIMIT) {
+		fprintf(stderr, "lcd: %s violated at %.3f us (%llu ns)\n", violation_names[violation], now / 1000.0, (unsigned long long)ns);
+	}
+}
+
+/** Moves the address counter one step in the entry mode's direction. */
+static void MoveAc(uint8_t right)
+{
+	if (lcd.cgram_mode) {
+		lcd.ac = (lcd.ac + (right ? 1 : -1)) & (HD44780_CGRAM_LEN - 1);
+	} else if (right) {
+		// the end of one line runs into the start of the other
+		lcd.ac = (lcd.ac == 0x27) ? 0x40 : (lcd.ac == 0x67) ? 0x00 : lcd.ac + 1;
+	} else {
+		lcd.ac = (lcd.ac == 0x00) ? 0x67 : (lcd.ac == 0x40) ? 0x27 : lcd.ac - 1;
+	}
+}
+
+/** Shifts the display one character left or right. */
+static void ShiftDisplay(uint8_t right)
+{
+	lcd.shift = (lcd.shift + (right ? HD44780_LINE_LEN - 1 : 1)) % HD44780_LINE_LEN;
+}
+
+/** Returns the DDRAM cell the address counter points at. */
+static char *DdramCell(void)
+{
+	return &lcd.ddram[lcd.ac >= 0x40][(lcd.ac & 0x3F) % HD44780_LINE_LEN];
+}
+
+/** Runs an instruction. Returns how long it takes. */
+static uint32_t RunInstruction(uint8_t cmd)
+{
+	if (cmd & 0x80) {
+		lcd.ac = cmd & 0x7F;
+		lcd.cgram_mode = 0;
+	} else if (cmd & 0x40) {
+		lcd.ac = cmd & 0x3F;
+		lcd.cgram_mode = 1;
+	} else if (cmd & 0x20) {
+		// function set: the interface is always 8 bits and 2 lines here
+	} else if (cmd & 0x10) {
+		if (cmd & 0x08) {
+			ShiftDisplay(cmd & mskShiftRL);
+		} else {
+			MoveAc(cmd & mskShiftRL);
+		}
+	} else if (cmd & 0x08) {
+		lcd.display_on = !!(cmd & displaySetOptionDisplayOn);
+	} else if (cmd & 0x04) {
+		lcd.increment = !!(cmd & 0x02);
+		lcd.shift_with_cursor = cmd & 0x01;
+	} else if (cmd & 0x02) {
+		lcd.ac = 0;
+		lcd.cgram_mode = 0;
+		lcd.shift = 0;
+		return T_EXEC_LONG;
+	} else if (cmd & 0x01) {
+		memset(lcd.ddram, ' ', sizeof(lcd.ddram));
+		lcd.ac = 0;
+		lcd.cgram_mode = 0;
+		lcd.shift = 0;
+		lcd.increment = 1;
+		return T_EXEC_LONG;
+	}
+	return T_EXEC;
+}
+
+/** Writes a byte of data to DDRAM or CGRAM. Returns how long it takes. */
+static uint32_t WriteData(uint8_t data)
+{
+	if (lcd.cgram_mode) {
+		lcd.cgram[lcd.ac] = data;
+	} else {
+		*DdramCell() = data;
+		if (lcd.shift_with_cursor) {
+			ShiftDisplay(!lcd.increment);
+		}
+	}
+	MoveAc(lcd.increment);
+	return T_EXEC + T_ADD;
+}
+
+/** Latches a write at the fall of E. */
+static void Write(uint64_t now)
+{
+	if (now < lcd.busy_until) {
+		Violation(Hd44780Busy, now, lcd.busy_until - now);
+		return;
+	}
+	uint32_t const time = lcd.rs ? WriteData(lcd.data) : RunInstruction(lcd.data);
+	lcd.busy_until = now + time;
+	lcd.needed_ns += (time > T_CYC_E) ? time : T_CYC_E;
+	++lcd.writes;
+}
+
+/** Drives the data pins for a read at the rise of E. */
+static void StartRead(uint64_t now)
+{
+	uint8_t value;
+	if (!lcd.rs) {
+		value = ((now < lcd.busy_until) ? mskBStatus : 0) | lcd.ac;
+	} else if (lcd.cgram_mode) {
+		value = lcd.cgram[lcd.ac];
+	} else {
+		value = *DdramCell();
+	}
+	HalSim_DrivePins(port_LCD_DATA, msk_LCD_DATA, value);
+}
+
+/** Checks and runs the edges of E. */
+static void OnEnable(uint8_t en, uint64_t now)
+{
+	if (en) {
+		if (now - lcd.addr_changed < T_AS) {
+			Violation(Hd44780AddrSetup, now, now - lcd.addr_changed);
+		}
+		if (lcd.started && now - lcd.en_rose < T_CYC_E) {
+			Violation(Hd44780Cycle, now, now - lcd.en_rose);
+		}
+		lcd.en_rose = now;
+		lcd.started = 1;
+		if (lcd.rw) {
+			StartRead(now);
+		}
+		return;
+	}
+
+	if (now - lcd.en_rose < PW_EH) {
+		Violation(Hd44780PulseWidth, now, now - lcd.en_rose);
+	}
+	lcd.en_fell = now;
+	if (!lcd.rw) {
+		if (now - lcd.data_changed < T_DSW) {
+			Violation(Hd44780DataSetup, now, now - lcd.data_changed);
+		}
+		Write(now);
+	} else if (lcd.rs && now >= lcd.busy_until) {
+		// reading data moves the address counter like writing it
+		MoveAc(lcd.increment);
+		lcd.busy_until = now + T_ADD;
+	}
+}
+
+/** Samples the LCD pins after a write to a port. */
+static void OnWrite(enum HalPort port)
+{
+	if (port != HAL_PIN_PORT(pin_LCD_DISP_RS) && port != HAL_PIN_PORT(pin_LCD_DISP_EN) && port != port_LCD_DATA) {
+		return;
+	}
+	uint64_t const now = HalSim_GetTimeNs();
+	uint8_t const rs = !!(HalSim_GetLat(HAL_PIN_PORT(pin_LCD_DISP_RS)) & HAL_PIN_MASK(pin_LCD_DISP_RS));
+	uint8_t const rw = !!(HalSim_GetLat(HAL_PIN_PORT(pin_LCD_DISP_RW)) & HAL_PIN_MASK(pin_LCD_DISP_RW));
+	uint8_t const en = !!(HalSim_GetLat(HAL_PIN_PORT(pin_LCD_DISP_EN)) & HAL_PIN_MASK(pin_LCD_DISP_EN));
+	// the data the chip drives; inputs float, so they keep what the LCD last saw
+	uint32_t const outputs = ~HalSim_GetTris(port_LCD_DATA) & msk_LCD_DATA;
+	uint8_t const data = (HalSim_GetLat(port_LCD_DATA) & outputs) | (lcd.data & ~outputs);
+
+	if (rs != lcd.rs || rw != lcd.rw) {
+		if (lcd.en) {
+			Violation(Hd44780AddrSetup, now, 0);
+		} else if (lcd.started && now - lcd.en_fell < T_AH) {
+			Violation(Hd44780AddrHold, now, now - lcd.en_fell);
+		}
+		if (lcd.rw && !rw) {
+			// the LCD stops driving the data pins once it is written to again
+			HalSim_ReleasePins(port_LCD_DATA, msk_LCD_DATA);
+		}
+		lcd.rs = rs;
+		lcd.rw = rw;
+		lcd.addr_changed = now;
+	}
+	if (data != lcd.data) {
+		if (!lcd.en && !lcd.rw && lcd.started && now - lcd.en_fell < T_H) {
+			Violation(Hd44780DataHold, now, now - lcd.en_fell);
+		}
+		lcd.data = data;
+		lcd.data_changed = now;
+	}
+	if (en != lcd.en) {
+		lcd.en = en;
+		OnEnable(en, now);
+	}
+}
+
+void Hd44780_Init(void)
+{
+	memset(&lcd, 0, sizeof(lcd));
+	// DDRAM holds random data on power on, and the datasheet only promises it after a clear
+	memset(lcd.ddram, '?', sizeof(lcd.ddram));
+	lcd.increment = 1;
+	lcd.busy_until = HalSim_GetTimeNs() + T_POWER_ON;
+	if (!hooked) {
+		hooked = HalSim_AddWriteHook(OnWrite);
+	}
+}
+
+void Hd44780_GetShownLine(uint8_t line, char *str)
+{
+	for (uint8_t i = 0; i < HD44780_SHOWN_LEN; ++i) {
+		str[i] = lcd.display_on ? lcd.ddram[line][(i + lcd.shift) % HD44780_LINE_LEN] : ' ';
+	}
+}
+
+uint8_t const *Hd44780_GetCgram(void)
+{
+	return lcd.cgram;
+}
+
+uint32_t Hd44780_GetViolations(enum Hd44780Violation violation)
+{
+	return lcd.violations[violation];
+}
+
+char const *Hd44780_GetViolationName(enum Hd44780Violation violation)
+{
+	return violation_names[violation];
+}
+
+uint64_t Hd44780_GetNeededNs(void)
+{
+	return lcd.needed_ns;
+}
+
+uint32_t Hd44780_GetWriteCount(void)
+{
+	return lcd.writes;
+}
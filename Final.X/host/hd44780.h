@@ -0,0 +1,73 @@
+/*
+ * Cycle-approximate model of the HD44780 LCD controller, for host programs
+ * built with the Linux HAL.
+ *
+ * The model watches the writes to the LCD pins in the simulated registers, and
+ * checks the bus timing in virtual time against the datasheet's limits at 3 V.
+ * It keeps DDRAM, CGRAM, the display shift, and the busy flag, and answers reads.
+ * A write while the controller is busy is dropped, as the real one may drop it.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Characters in a line of DDRAM, and characters shown of each line
+#define HD44780_LINE_LEN 40
+#define HD44780_SHOWN_LEN 16
+// Bytes of CGRAM
+#define HD44780_CGRAM_LEN 64
+
+/** Ways the LCD driver can break the datasheet's timing. */
+enum Hd44780Violation {
+	// RS or RW changed less than tAS before E rose, or while E was high
+	Hd44780AddrSetup,
+	// RS or RW changed less than tAH after E fell
+	Hd44780AddrHold,
+	// E was high for less than PWEH
+	Hd44780PulseWidth,
+	// E rose less than tcycE after it last rose
+	Hd44780Cycle,
+	// the data changed less than tDSW before E fell
+	Hd44780DataSetup,
+	// the data changed less than tH after E fell
+	Hd44780DataHold,
+	// a write while the controller was still running an instruction
+	Hd44780Busy,
+	HD44780_VIOLATION_COUNT
+};
+
+/**
+ * Resets the model, as when the LCD is powered on, and starts watching the pins.
+ * The controller is busy for the first 40 ms.
+ */
+void Hd44780_Init(void);
+/**
+ * Writes the characters shown on a line, with the display shift, into str.
+ * The display being off shows spaces. str is not terminated.
+ */
+void Hd44780_GetShownLine(uint8_t line, char *str);
+/**
+ * Returns the CGRAM, which holds the custom glyphs.
+ */
+uint8_t const *Hd44780_GetCgram(void);
+/**
+ * Returns the number of times the timing was broken in a way, since the model was reset.
+ */
+uint32_t Hd44780_GetViolations(enum Hd44780Violation violation);
+/**
+ * Returns the name of a way the timing can be broken.
+ */
+char const *Hd44780_GetViolationName(enum Hd44780Violation violation);
+/**
+ * Returns the least virtual time the instructions and data written since the model
+ * was reset need on the bus, if each were written as soon as the last finished.
+ */
+uint64_t Hd44780_GetNeededNs(void);
+/**
+ * Returns the number of instructions and data bytes written since the model was reset.
+ */
+uint32_t Hd44780_GetWriteCount(void);
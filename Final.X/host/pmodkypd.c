@@ -0,0 +1,153 @@
+/*
+ * Electrical model of the PmodKYPD keypad, for host programs built with the
+ * Linux HAL.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "pmodkypd.h"
+#include "hal/hal_sim.h"
+#include "peripherals/keypad.h"
+
+// Time a bouncing contact stays open or closed, in nanoseconds
+#define BOUNCE_STEP_NS 50000
+
+// the keys at each row and column, as printed on the keypad
+static uint8_t const keys[4][4] = {
+	{0x1, 0x2, 0x3, 0xA},
+	{0x4, 0x5, 0x6, 0xB},
+	{0x7, 0x8, 0x9, 0xC},
+	{0x0, 0xF, 0xE, 0xD}
+};
+
+static uint8_t const row_pins[4] = {KEYPAD_ROW1, KEYPAD_ROW2, KEYPAD_ROW3, KEYPAD_ROW4};
+static uint8_t const col_pins[4] = {KEYPAD_COL1, KEYPAD_COL2, KEYPAD_COL3, KEYPAD_COL4};
+
+static uint16_t pressed;
+static uint32_t bounce_ns;
+// when each key last changed
+static uint64_t changed_at[16];
+static uint32_t contentions;
+// a bit for each row shorting a low column to a high one, to count each short once
+static uint8_t shorted_rows;
+static uint8_t hooked;
+
+/** Returns whether a key's contacts are closed now, bouncing for a while after it changes. */
+static uint8_t IsClosed(uint8_t key, uint64_t now)
+{
+	if (now - changed_at[key] < bounce_ns) {
+		uint32_t const step = (uint32_t)(now / BOUNCE_STEP_NS);
+		return ((step * 2654435761u) ^ (key * 40503u)) >> 31;
+	}
+	return !!(pressed & PMODKYPD_KEY(key));
+}
+
+/** Returns the net a row or column is in, with rows as 0 to 3 and columns as 4 to 7. */
+static uint8_t FindNet(uint8_t const *parents, uint8_t node)
+{
+	while (parents[node] != node) {
+		node = parents[node];
+	}
+	return node;
+}
+
+/** Drives the rows from the columns through the closed keys. */
+static void Update(void)
+{
+	uint64_t const now = HalSim_GetTimeNs();
+	uint8_t parents[8];
+	for (uint8_t i = 0; i < 8; ++i) {
+		parents[i] = i;
+	}
+	for (uint8_t row = 0; row < 4; ++row) {
+		for (uint8_t col = 0; col < 4; ++col) {
+			if (IsClosed(keys[row][col], now)) {
+				parents[FindNet(parents, row)] = FindNet(parents, 4 + col);
+			}
+		}
+	}
+
+	// the columns driven low and high in each net
+	uint8_t low_nets = 0;
+	uint8_t high_nets = 0;
+	for (uint8_t col = 0; col < 4; ++col) {
+		uint8_t const pin = col_pins[col];
+		if (HalSim_GetTris(HAL_PIN_PORT(pin)) & HAL_PIN_MASK(pin)) {
+			// not driven
+			continue;
+		}
+		uint8_t const net = 1 << FindNet(parents, 4 + col);
+		if (HalSim_GetLat(HAL_PIN_PORT(pin)) & HAL_PIN_MASK(pin)) {
+			high_nets |= net;
+		} else {
+			low_nets |= net;
+		}
+	}
+
+	uint8_t shorted = 0;
+	for (uint8_t row = 0; row < 4; ++row) {
+		uint8_t const pin = row_pins[row];
+		uint8_t const net = 1 << FindNet(parents, row);
+		if (net & low_nets) {
+			// a short between columns pulls them to about half way, which reads low
+			HalSim_DrivePins(HAL_PIN_PORT(pin), HAL_PIN_MASK(pin), 0);
+			if (net & high_nets) {
+				shorted |= 1 << row;
+			}
+		} else if (net & high_nets) {
+			HalSim_DrivePins(HAL_PIN_PORT(pin), HAL_PIN_MASK(pin), HAL_PIN_MASK(pin));
+		} else {
+			HalSim_ReleasePins(HAL_PIN_PORT(pin), HAL_PIN_MASK(pin));
+		}
+	}
+	if (shorted & ~shorted_rows) {
+		++contentions;
+	}
+	shorted_rows = shorted;
+}
+
+/** Updates the rows after a write to a port with a column on it. */
+static void OnWrite(enum HalPort port)
+{
+	for (uint8_t col = 0; col < 4; ++col) {
+		if (HAL_PIN_PORT(col_pins[col]) == port) {
+			Update();
+			return;
+		}
+	}
+}
+
+void PmodKypd_Init(void)
+{
+	pressed = 0;
+	bounce_ns = 0;
+	contentions = 0;
+	shorted_rows = 0;
+	if (!hooked) {
+		hooked = HalSim_AddWriteHook(OnWrite);
+	}
+	Update();
+}
+
+void PmodKypd_SetPressed(uint16_t keys)
+{
+	uint64_t const now = HalSim_GetTimeNs();
+	for (uint8_t key = 0; key < 16; ++key) {
+		if ((keys ^ pressed) & PMODKYPD_KEY(key)) {
+			changed_at[key] = now;
+		}
+	}
+	pressed = keys;
+	Update();
+}
+
+void PmodKypd_SetBounce(uint32_t ns)
+{
+	bounce_ns = ns;
+}
+
+uint32_t PmodKypd_GetContentions(void)
+{
+	return contentions;
+}
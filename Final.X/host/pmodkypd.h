@@ -0,0 +1,39 @@
+/*
+ * Electrical model of the PmodKYPD keypad, for host programs built with the
+ * Linux HAL.
+ *
+ * The keypad is a matrix of switches with no diodes: a pressed key joins its row
+ * to its column. After each write to the column pins, the model joins the rows
+ * and columns through every closed key, and drives a row low if it is joined to
+ * a column driven low. Several keys can join rows through other columns, so a
+ * scan can see keys that aren't pressed, as the real keypad does. A key that
+ * changes can bounce, opening and closing for a while in virtual time.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// A key in a set of pressed keys, by its value 0x0 to 0xF
+#define PMODKYPD_KEY(key) ((uint16_t)1 << (key))
+
+/**
+ * Resets the model with no keys pressed, and starts watching the pins.
+ */
+void PmodKypd_Init(void);
+/**
+ * Sets the keys held down. Keys that change bounce if bouncing is on.
+ */
+void PmodKypd_SetPressed(uint16_t keys);
+/**
+ * Sets how long keys bounce after they change, in nanoseconds, 0 for not at all.
+ */
+void PmodKypd_SetBounce(uint32_t bounce_ns);
+/**
+ * Returns the number of times a column driven low and one driven high were
+ * shorted together through pressed keys.
+ */
+uint32_t PmodKypd_GetContentions(void);
@@ -0,0 +1,135 @@
+/*
+ * Host replayer of input recordings made by the Recorder module.
+ *
+ * Runs the whole program in virtual time as main() does, with the LCD and keypad
+ * models, and drives the keypad, buttons, and switches with the recorded sample
+ * before each loop, so the program reads back the same input at the same loop.
+ * Prints each change to what the LCD and LEDs show with its loop number, then a
+ * hash of them all, which is the same as host/sim_session.c prints for the session
+ * that made the recording. Checks that recording the replay gives the same recording.
+ *
+ * A recording can be saved from the board by reading the Recorder module's buffer
+ * with the debugger, up to the length its first 4 bytes give, or made on a PC by
+ * host/sim_session.c.
+ *
+ * Build and run from this directory:
+ *   cc -O2 -I../code -o replay replay.c board.c hd44780.c pmodkypd.c \
+ *     $(find ../code -name '*.c' ! -name main.c ! -name hal_pic32.c)
+ *   ./replay session.bin
+ * Built with -DPROFILE, it also prints what the probes of the Profile module measured.
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "board.h"
+#include "hd44780.h"
+#include "pmodkypd.h"
+#include "app.h"
+#include "recorder.h"
+#include "profile.h"
+#include "coretimer.h"
+#include "utils.h"
+#include "hal/hal_sim.h"
+#include <stdio.h>
+#include <string.h>
+
+/** Runs one loop of the program, and prints what it changed on the LCD and LEDs. */
+static void RunLoop(uint32_t loop, struct BoardShown *shown)
+{
+	uint64_t const now = HalSim_GetTimeNs();
+	App_Process();
+	DelayAprox100Us(10);
+
+	if (Board_UpdateShown(shown, now)) {
+		// glyphs are shown as #, since they aren't text
+		char lines[2][HD44780_SHOWN_LEN];
+		for (uint8_t i = 0; i < 2; ++i) {
+			for (uint8_t j = 0; j < HD44780_SHOWN_LEN; ++j) {
+				lines[i][j] = (shown->lines[i][j] < ' ') ? '#' : shown->lines[i][j];
+			}
+		}
+		printf("%10u |%.*s|%.*s| leds %02X\n", loop, HD44780_SHOWN_LEN, lines[0], HD44780_SHOWN_LEN, lines[1],
+				shown->leds);
+	}
+}
+
+#if defined(PROFILE)
+/** Prints the statistics of each probe in microseconds, and the histogram of its times. */
+static void PrintProfile(void)
+{
+	printf("%-20s %10s %10s %10s %10s\n", "probe", "count", "min us", "mean us", "max us");
+	for (enum ProfileProbe probe = 0; probe < PROFILE_PROBE_COUNT; ++probe) {
+		struct ProfileStats const *stats = Profile_GetStats(probe);
+		double const us_per_tick = 1e6 / CORE_TIMER_FRQ;
+		double const mean = stats->count ? (double)stats->total / stats->count : 0;
+		printf("%-20s %10u %10.2f %10.2f %10.2f\n", Profile_GetName(probe), stats->count, stats->min * us_per_tick,
+				mean * us_per_tick, stats->max * us_per_tick);
+		for (uint8_t b = 0; b < PROFILE_BUCKET_COUNT; ++b) {
+			if (stats->buckets[b]) {
+				// bucket b holds the times below 2^b ticks
+				printf("%20s < %10.2f us: %u\n", "", (1UL << b) * us_per_tick, stats->buckets[b]);
+			}
+		}
+	}
+}
+#endif
+
+int main(int argc, char **argv)
+{
+	static uint8_t data[RECORDER_BUFFER_SIZE];
+	if (argc < 2) {
+		printf("usage: %s recording\n", argv[0]);
+		return 1;
+	}
+	FILE *file = fopen(argv[1], "rb");
+	if (!file) {
+		printf("can't open %s\n", argv[1]);
+		return 1;
+	}
+	uint16_t const len = fread(data, 1, sizeof(data), file);
+	fclose(file);
+	if (len < RECORDER_HEADER_LEN) {
+		printf("%s is too short\n", argv[1]);
+		return 1;
+	}
+	uint32_t const samples = Recorder_GetSampleCount(data);
+
+	HalSim_SetRealTime(0);
+	Hd44780_Init();
+	PmodKypd_Init();
+	struct InputState state = {-1, 0, 0};
+	Board_DriveInput(&state);
+	App_Init();
+
+	struct BoardShown shown;
+	Board_InitShown(&shown);
+	uint32_t loop = 0;
+	uint16_t pos = RECORDER_HEADER_LEN;
+	uint32_t count;
+	while ((pos = Recorder_ReadRecord(data, len, pos, &count, &state))) {
+		// the samples before the record are the same as the one before them
+		for (; count > 1; --count) {
+			RunLoop(++loop, &shown);
+		}
+		Board_DriveInput(&state);
+		RunLoop(++loop, &shown);
+	}
+	while (loop < samples) {
+		RunLoop(++loop, &shown);
+	}
+
+	printf("%u loops, %.1f s, %u changes shown, hash %016llx\n", loop, HalSim_GetTimeNs() * 1e-9, shown.changes,
+			(unsigned long long)shown.hash);
+#if defined(PROFILE)
+	PrintProfile();
+#endif
+
+	uint16_t replay_len;
+	uint8_t const *replay = Recorder_GetData(&replay_len);
+	if (replay_len != len || memcmp(replay, data, len)) {
+		printf("recording the replay gives a different recording\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,230 @@
+/*
+ * Host simulation of keypad scanners against a model of the PmodKYPD.
+ *
+ * Runs scripted sets of pressed keys through the driver's Keypad_GetKey and two
+ * plain scanners, and compares the key each finds with the pressed key the driver
+ * promises: the first by row, then by column. For each scanner it reports the
+ * scans that are wrong, the reads and writes of the ports per scan, and the
+ * shorts between columns its drives cause. Then it presses keys that bounce and
+ * counts how often each scanner's result changes while they settle.
+ *
+ * Build and run from this directory:
+ *   cc -O2 -I../code -o sim_keypad sim_keypad.c pmodkypd.c ../code/peripherals/keypad.c \
+ *     ../code/hal/hal_linux.c
+ *   ./sim_keypad
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "pmodkypd.h"
+#include "peripherals/keypad.h"
+#include "hal/hal_sim.h"
+#include <stdio.h>
+
+#define KEY PMODKYPD_KEY
+
+// How long a bouncing key bounces, and how often it is scanned while it does
+#define BOUNCE_NS 5000000
+#define BOUNCE_SCAN_100US 5
+#define BOUNCE_SCANS 40
+
+static uint8_t const keys[4][4] = {
+	{0x1, 0x2, 0x3, 0xA},
+	{0x4, 0x5, 0x6, 0xB},
+	{0x7, 0x8, 0x9, 0xC},
+	{0x0, 0xF, 0xE, 0xD}
+};
+
+static uint8_t const row_pins[4] = {KEYPAD_ROW1, KEYPAD_ROW2, KEYPAD_ROW3, KEYPAD_ROW4};
+static uint8_t const col_pins[4] = {KEYPAD_COL1, KEYPAD_COL2, KEYPAD_COL3, KEYPAD_COL4};
+
+/**
+ * Returns the first key found driving one column at a time, stopping at the first
+ * column with a key, so it prefers columns over rows.
+ */
+static int8_t ScanColumns(void)
+{
+	for (uint8_t col = 0; col < 4; ++col) {
+		Hal_PinWrite(col_pins[col], 0);
+		for (uint8_t row = 0; row < 4; ++row) {
+			if (!Hal_PinRead(row_pins[row])) {
+				Hal_PinWrite(col_pins[col], 1);
+				return keys[row][col];
+			}
+		}
+		Hal_PinWrite(col_pins[col], 1);
+	}
+	return -1;
+}
+
+/** Returns the first key by row, then column, reading all rows of all columns. */
+static int8_t ScanMatrix(void)
+{
+	uint8_t pressed_rows[4];
+	for (uint8_t col = 0; col < 4; ++col) {
+		Hal_PinWrite(col_pins[col], 0);
+		pressed_rows[col] = 0;
+		for (uint8_t row = 0; row < 4; ++row) {
+			pressed_rows[col] |= !Hal_PinRead(row_pins[row]) << row;
+		}
+		Hal_PinWrite(col_pins[col], 1);
+	}
+	for (uint8_t row = 0; row < 4; ++row) {
+		for (uint8_t col = 0; col < 4; ++col) {
+			if (pressed_rows[col] & (1 << row)) {
+				return keys[row][col];
+			}
+		}
+	}
+	return -1;
+}
+
+/** A scanner to compare, and what it did over the scenarios. */
+struct Scanner {
+	char const *name;
+	int8_t (*scan)(void);
+	uint32_t wrong;
+	uint32_t single_wrong;
+	uint64_t accesses;
+	uint32_t scans;
+	uint32_t bounce_changes;
+};
+
+static struct Scanner scanners[] = {
+	{"driver", Keypad_GetKey, 0, 0, 0, 0, 0},
+	{"columns", ScanColumns, 0, 0, 0, 0, 0},
+	{"matrix", ScanMatrix, 0, 0, 0, 0, 0},
+};
+#define SCANNER_COUNT (sizeof(scanners) / sizeof(*scanners))
+
+/** A set of pressed keys to scan. */
+struct Scenario {
+	char const *name;
+	uint16_t keys;
+};
+
+static struct Scenario const scenarios[] = {
+	{"none", 0},
+	{"same row", KEY(0x5) | KEY(0x6)},
+	{"same row, far", KEY(0x1) | KEY(0xA)},
+	{"same column", KEY(0x2) | KEY(0x8)},
+	{"diagonal", KEY(0x1) | KEY(0x5)},
+	{"anti-diagonal", KEY(0x2) | KEY(0x4)},
+	{"ghost corner", KEY(0x5) | KEY(0x6) | KEY(0x9)},
+	{"ghost, top left", KEY(0x2) | KEY(0x3) | KEY(0x5)},
+	{"row of 4", KEY(0x7) | KEY(0x8) | KEY(0x9) | KEY(0xC)},
+	{"every key", 0xFFFF},
+};
+#define SCENARIO_COUNT (sizeof(scenarios) / sizeof(*scenarios))
+
+/** Returns the key the driver promises: the first pressed by row, then column. */
+static int8_t Expected(uint16_t pressed)
+{
+	for (uint8_t row = 0; row < 4; ++row) {
+		for (uint8_t col = 0; col < 4; ++col) {
+			if (pressed & KEY(keys[row][col])) {
+				return keys[row][col];
+			}
+		}
+	}
+	return -1;
+}
+
+/** Scans with a scanner, counting its accesses to the ports. */
+static int8_t Scan(struct Scanner *scanner)
+{
+	uint64_t const start = HalSim_GetAccessCount();
+	int8_t const key = scanner->scan();
+	scanner->accesses += HalSim_GetAccessCount() - start;
+	++scanner->scans;
+	return key;
+}
+
+/** Prints a key, or - for none. */
+static void PrintKey(int8_t key)
+{
+	if (key < 0) {
+		printf(" %8s", "-");
+	} else {
+		printf(" %8X", key);
+	}
+}
+
+int main(void)
+{
+	HalSim_SetRealTime(0);
+	Keypad_Init();
+	PmodKypd_Init();
+
+	// every single key, which every scanner must get right
+	for (uint8_t key = 0; key < 16; ++key) {
+		PmodKypd_SetPressed(KEY(key));
+		for (size_t s = 0; s < SCANNER_COUNT; ++s) {
+			if (Scan(&scanners[s]) != key) {
+				++scanners[s].single_wrong;
+			}
+		}
+	}
+
+	printf("%-16s %8s", "scenario", "expected");
+	for (size_t s = 0; s < SCANNER_COUNT; ++s) {
+		printf(" %8s", scanners[s].name);
+	}
+	printf("\n");
+	for (size_t i = 0; i < SCENARIO_COUNT; ++i) {
+		PmodKypd_SetPressed(scenarios[i].keys);
+		int8_t const expected = Expected(scenarios[i].keys);
+		printf("%-16s", scenarios[i].name);
+		PrintKey(expected);
+		for (size_t s = 0; s < SCANNER_COUNT; ++s) {
+			int8_t const key = Scan(&scanners[s]);
+			PrintKey(key);
+			if (key != expected) {
+				++scanners[s].wrong;
+			}
+		}
+		printf("\n");
+	}
+
+	// press and release a key while it bounces, scanning every so often
+	PmodKypd_SetBounce(BOUNCE_NS);
+	for (size_t s = 0; s < SCANNER_COUNT; ++s) {
+		int8_t last = -1;
+		for (uint16_t keys = KEY(0x5); ; keys = 0) {
+			PmodKypd_SetPressed(keys);
+			for (uint32_t i = 0; i < BOUNCE_SCANS; ++i) {
+				Hal_Delay100Us(BOUNCE_SCAN_100US);
+				int8_t const key = Scan(&scanners[s]);
+				if (key != last) {
+					++scanners[s].bounce_changes;
+					last = key;
+				}
+			}
+			if (!keys) {
+				break;
+			}
+		}
+	}
+
+	printf("\n%-10s %8s %8s %9s %7s %7s\n", "scanner", "single", "multi", "accesses", "shorts", "bounce");
+	int failed = 0;
+	PmodKypd_SetBounce(0);
+	for (size_t s = 0; s < SCANNER_COUNT; ++s) {
+		struct Scanner const *scanner = &scanners[s];
+		// the model counts the shorts, so run the scenarios again with this scanner alone
+		uint32_t const start = PmodKypd_GetContentions();
+		for (size_t i = 0; i < SCENARIO_COUNT; ++i) {
+			PmodKypd_SetPressed(scenarios[i].keys);
+			scanner->scan();
+		}
+		uint32_t const shorts = PmodKypd_GetContentions() - start;
+		printf("%-10s %5u/16 %5u/%zu %9.1f %7u %7u\n", scanner->name, 16 - scanner->single_wrong,
+				(unsigned)(SCENARIO_COUNT - scanner->wrong), SCENARIO_COUNT,
+				(double)scanner->accesses / scanner->scans, shorts, scanner->bounce_changes);
+		failed |= scanner->single_wrong != 0;
+	}
+	printf("(single and multi are the scans right, accesses are per scan, and bounce is how often the key changed\n"
+			"while pressing and releasing one key, 2 without bouncing)\n");
+	return failed;
+}
@@ -0,0 +1,113 @@
+/*
+ * Host simulation of the LCD driver against a model of the HD44780.
+ *
+ * Runs the Output module's LCD updates for a few typical frames with the delays
+ * only advancing virtual time, and checks what the model shows after each one.
+ * Reports any breaks of the datasheet's timing, and for each frame the time the
+ * driver took against the least time the controller needs for the same writes.
+ * Shorter delays in lcd.c are safe as long as this passes.
+ *
+ * Build and run from this directory:
+ *   cc -O2 -I../code -o sim_lcd sim_lcd.c hd44780.c ../code/output.c ../code/utils.c \
+ *     ../code/peripherals/lcd.c ../code/peripherals/rgbled.c ../code/hal/hal_linux.c
+ *   ./sim_lcd
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "hd44780.h"
+#include "output.h"
+#include "hal/hal_sim.h"
+#include <stdio.h>
+#include <string.h>
+
+/** A frame: the lines to show, and a glyph to set if glyph_rows is set. */
+struct Frame {
+	char const *name;
+	char const *lines[LCD_BUFFER_COUNT];
+	uint8_t const *glyph_rows;
+};
+
+static uint8_t const arrow_glyph[LCD_GLYPH_ROWS] = {0x04, 0x0E, 0x15, 0x04, 0x04, 0x04, 0x04, 0x00};
+
+static struct Frame const frames[] = {
+	{"full", {" 0x  1234ABCD   ", "+        Hex 32 "}, NULL},
+	{"digit", {" 0x 1234ABCDE   ", "+        Hex 32 "}, NULL},
+	{"operator", {" 0x 1234ABCDE   ", "*        Hex 32 "}, NULL},
+	{"glyph", {" 0x 1234ABCDE   ", "*  \x08     Hex 32 "}, arrow_glyph},
+	{"clear", {" 0x          0  ", "*        Hex 32 "}, NULL},
+	{"base", {" 0d          0  ", "*        Dec 32 "}, NULL},
+};
+
+/** Prints the violations of each kind so far. Returns their total. */
+static uint32_t PrintViolations(void)
+{
+	uint32_t total = 0;
+	for (int i = 0; i < HD44780_VIOLATION_COUNT; ++i) {
+		uint32_t const count = Hd44780_GetViolations(i);
+		if (count) {
+			printf("  %-14s %u\n", Hd44780_GetViolationName(i), count);
+		}
+		total += count;
+	}
+	return total;
+}
+
+int main(void)
+{
+	int failed = 0;
+
+	HalSim_SetRealTime(0);
+	Hd44780_Init();
+	uint64_t start = HalSim_GetTimeNs();
+	Output_Init();
+	// the RGB LED isn't modeled, and its interrupt would take up virtual time
+	Hal_TimerStop();
+	printf("init took %.1f us\n", (HalSim_GetTimeNs() - start) / 1000.0);
+
+	printf("%-10s %6s %12s %12s %8s\n", "frame", "writes", "took (us)", "needs (us)", "ratio");
+	for (size_t f = 0; f < sizeof(frames) / sizeof(*frames); ++f) {
+		struct Frame const *frame = &frames[f];
+		for (uint8_t i = 0; i < LCD_BUFFER_COUNT; ++i) {
+			char *buffer = Output_GetLcdBuffer(i);
+			if (strcmp(buffer, frame->lines[i])) {
+				strcpy(buffer, frame->lines[i]);
+				Output_SignalLcdUpdate(i);
+			}
+		}
+		if (frame->glyph_rows) {
+			Output_SetLcdGlyph(0, frame->glyph_rows);
+		}
+
+		uint32_t const writes = Hd44780_GetWriteCount();
+		uint64_t const needed = Hd44780_GetNeededNs();
+		start = HalSim_GetTimeNs();
+		Output_Process();
+		uint64_t const took = HalSim_GetTimeNs() - start;
+		uint64_t const needs = Hd44780_GetNeededNs() - needed;
+		printf("%-10s %6u %12.1f %12.1f %8.1f\n", frame->name, Hd44780_GetWriteCount() - writes,
+				took / 1000.0, needs / 1000.0, needs ? (double)took / needs : 0.0);
+
+		for (uint8_t i = 0; i < LCD_BUFFER_COUNT; ++i) {
+			char shown[HD44780_SHOWN_LEN];
+			Hd44780_GetShownLine(i, shown);
+			if (memcmp(shown, frame->lines[i], HD44780_SHOWN_LEN)) {
+				printf("  line %u shows \"%.*s\", not \"%s\"\n", i, HD44780_SHOWN_LEN, shown, frame->lines[i]);
+				failed = 1;
+			}
+		}
+		if (frame->glyph_rows && memcmp(Hd44780_GetCgram(), frame->glyph_rows, LCD_GLYPH_ROWS)) {
+			printf("  glyph 0 doesn't match\n");
+			failed = 1;
+		}
+	}
+
+	printf("timing violations:\n");
+	if (PrintViolations()) {
+		failed = 1;
+	} else {
+		printf("  none\n");
+	}
+	return failed;
+}
@@ -0,0 +1,201 @@
+/*
+ * Host simulation of a long scripted session of the whole program in virtual time.
+ *
+ * Runs the main loop as main() does, with the LCD and keypad models, while a
+ * script presses keys and buttons and flips switches in bursts, like a person.
+ * Delays and the 300 us RGB LED interrupt only advance the virtual clock, so an
+ * hour takes seconds, and every run is the same. The session is run twice in
+ * separate processes to check that both show the same LCD and LEDs at the same
+ * virtual times, and the ratio of virtual time to wall clock time is reported.
+ * The input the first run records can be saved for host/replay.c, which prints
+ * the same hash replaying it.
+ *
+ * Build and run from this directory, optionally with the length of the session in seconds
+ * and a file to save the recording to:
+ *   cc -O2 -I../code -o sim_session sim_session.c board.c hd44780.c pmodkypd.c \
+ *     $(find ../code -name '*.c' ! -name main.c ! -name hal_pic32.c)
+ *   ./sim_session [3600 [session.bin]]
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "board.h"
+#include "hd44780.h"
+#include "pmodkypd.h"
+#include "app.h"
+#include "recorder.h"
+#include "utils.h"
+#include "hal/hal_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+// Default length of the session, in seconds
+#define SESSION_S 3600
+// The script types in bursts, like a person: inputs per burst, time between bursts,
+// time between inputs in a burst, and how long each is held
+#define BURST_LEN 8
+#define BURST_NS 60000000000ULL
+#define ACTION_NS 250000000ULL
+#define HOLD_NS 100000000ULL
+// Switches flipped; the Fn switch is left alone so the session stays in plain use
+#define SESSION_SWT_COUNT (BOARD_SWT_COUNT - 1)
+
+/** What a run did, to compare between runs. */
+struct Result {
+	// hash of each change to the LCD and LEDs, and the virtual time it was shown at
+	uint64_t hash;
+	uint32_t changes;
+	uint64_t loops;
+	uint64_t time_ns;
+	double wall_s;
+};
+
+/** Returns the next number of a fixed sequence, so the script is the same every run. */
+static uint32_t Next(uint32_t *seed)
+{
+	*seed = *seed * 1103515245 + 12345;
+	return *seed >> 16;
+}
+
+/** Presses the next scripted input, or flips a switch. */
+static void Press(uint32_t *seed, struct InputState *input)
+{
+	uint32_t const r = Next(seed);
+	switch (r % 4) {
+		case 0:
+		case 1:
+			input->key = Next(seed) % 16;
+			break;
+		case 2:
+			input->btn |= 1 << (Next(seed) % BOARD_BTN_COUNT);
+			break;
+		default:
+			input->swt ^= 1 << (Next(seed) % SESSION_SWT_COUNT);
+			break;
+	}
+	Board_DriveInput(input);
+}
+
+/** Releases the keys and buttons; the switches stay where they are. */
+static void Release(struct InputState *input)
+{
+	input->key = -1;
+	input->btn = 0;
+	Board_DriveInput(input);
+}
+
+/** Runs the session for a length of virtual time, and saves the recording if given a path. */
+static void RunSession(uint64_t length_ns, char const *save_path, struct Result *result)
+{
+	struct timespec start, end;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	HalSim_SetRealTime(0);
+	Hd44780_Init();
+	PmodKypd_Init();
+	struct InputState input = {-1, 0, 0};
+	Board_DriveInput(&input);
+
+	memset(result, 0, sizeof(*result));
+	struct BoardShown shown;
+	Board_InitShown(&shown);
+	uint32_t seed = 1;
+	uint64_t burst_start = ACTION_NS;
+	uint64_t next_action = burst_start;
+	uint8_t burst_actions = 0;
+	uint64_t release = 0;
+
+	App_Init();
+	while (HalSim_GetTimeNs() < length_ns) {
+		uint64_t const now = HalSim_GetTimeNs();
+		if (now >= next_action) {
+			Press(&seed, &input);
+			release = now + HOLD_NS;
+			if (++burst_actions < BURST_LEN) {
+				next_action += ACTION_NS;
+			} else {
+				burst_actions = 0;
+				burst_start += BURST_NS;
+				next_action = burst_start;
+			}
+		} else if (release && now >= release) {
+			Release(&input);
+			release = 0;
+		}
+
+		App_Process();
+		DelayAprox100Us(10);
+		++result->loops;
+		Board_UpdateShown(&shown, now);
+	}
+
+	result->hash = shown.hash;
+	result->changes = shown.changes;
+	result->time_ns = HalSim_GetTimeNs();
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	result->wall_s = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+
+	if (save_path) {
+		uint16_t len;
+		uint8_t const *data = Recorder_GetData(&len);
+		FILE *file = fopen(save_path, "wb");
+		if (file) {
+			fwrite(data, 1, len, file);
+			fclose(file);
+		}
+	}
+}
+
+/** Runs the session in a new process, since the program's modules only start once. */
+static int RunInChild(uint64_t length_ns, char const *save_path, struct Result *result)
+{
+	int fds[2];
+	if (pipe(fds)) {
+		return 0;
+	}
+	pid_t const pid = fork();
+	if (pid < 0) {
+		return 0;
+	}
+	if (pid == 0) {
+		close(fds[0]);
+		RunSession(length_ns, save_path, result);
+		_exit(write(fds[1], result, sizeof(*result)) != sizeof(*result));
+	}
+	close(fds[1]);
+	ssize_t const len = read(fds[0], result, sizeof(*result));
+	close(fds[0]);
+	int status;
+	waitpid(pid, &status, 0);
+	return len == sizeof(*result) && WIFEXITED(status) && !WEXITSTATUS(status);
+}
+
+int main(int argc, char **argv)
+{
+	uint64_t const length_s = (argc > 1) ? strtoull(argv[1], NULL, 10) : SESSION_S;
+	struct Result results[2];
+
+	for (int i = 0; i < 2; ++i) {
+		char const *save_path = (i == 0 && argc > 2) ? argv[2] : NULL;
+		if (!RunInChild(length_s * 1000000000ULL, save_path, &results[i])) {
+			printf("run %d failed\n", i + 1);
+			return 1;
+		}
+		printf("run %d: %.1f s in %.2f s (%.0fx), %llu loops, %u changes shown, hash %016llx\n", i + 1,
+				results[i].time_ns * 1e-9, results[i].wall_s, results[i].time_ns * 1e-9 / results[i].wall_s,
+				(unsigned long long)results[i].loops, results[i].changes, (unsigned long long)results[i].hash);
+	}
+
+	if (results[0].hash != results[1].hash || results[0].changes != results[1].changes
+			|| results[0].loops != results[1].loops || results[0].time_ns != results[1].time_ns) {
+		printf("the runs differ\n");
+		return 1;
+	}
+	printf("the runs match\n");
+	return 0;
+}
@@ -0,0 +1,388 @@
+/*
+ * Host checks of the calculator on sequences of input.
+ *
+ * Runs each sequence through Calc_Step, without the peripherals, and checks the
+ * state and LCD after it: typing digits, =, the bases, RPN, clearing, two
+ * calculators run side by side, and sequences that once gave the wrong result.
+ *
+ * Build and run from this directory:
+ *   cc -O2 -I../code -o test_calc test_calc.c \
+ *     $(find ../code -name '*.c' ! -name main.c ! -name hal_pic32.c)
+ *   ./test_calc
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "calculator.h"
+#include <stdio.h>
+#include <string.h>
+
+#define BTN_U (1 << 0)
+#define BTN_L (1 << 1)
+#define BTN_C (1 << 2)
+#define BTN_R (1 << 3)
+#define BTN_D (1 << 4)
+#define SWT_FN (1 << 7)
+// Fn keys that switch to RPN, turn the preview on and off, and step the word size
+#define KEY_RPN 0x0
+#define KEY_PREVIEW 0x1
+#define KEY_WORD_SIZE 0xA
+
+/** A calculator, the input event it runs on next, and what changed in its last step. */
+struct Test {
+	struct CalcState calc;
+	struct CalcEvent event;
+	struct CalcDelta delta;
+};
+
+static void Start(struct Test *test)
+{
+	memset(test, 0, sizeof(*test));
+	test->event.input.key = -1;
+	test->event.last.key = -1;
+	Calc_Init(&test->calc, &test->delta);
+}
+
+/** Runs the calculator on a sample of the input. */
+static void Step(struct Test *test, int8_t key, uint8_t btn, uint8_t swt)
+{
+	test->event.last = test->event.input;
+	test->event.input.key = key;
+	test->event.input.btn = btn;
+	test->event.input.swt = swt;
+	Calc_Step(&test->calc, &test->event, &test->delta);
+}
+
+/** Presses and releases a key, with the switches held. */
+static void TapKey(struct Test *test, int8_t key, uint8_t swt)
+{
+	Step(test, key, 0, swt);
+	Step(test, -1, 0, swt);
+}
+
+/** Presses and releases the keys of a string of hexadecimal digits, with the switches held. */
+static void TapKeys(struct Test *test, char const *digits, uint8_t swt)
+{
+	for (; *digits; ++digits) {
+		TapKey(test, (*digits <= '9') ? *digits - '0' : *digits - 'A' + 10, swt);
+	}
+}
+
+/** Presses and releases buttons, with the switches held. */
+static void TapBtn(struct Test *test, uint8_t btn, uint8_t swt)
+{
+	Step(test, -1, btn, swt);
+	Step(test, -1, 0, swt);
+}
+
+/** Steps the word size until it is the given number of bits. */
+static void SetWordBits(struct Test *test, uint8_t word_bits)
+{
+	while (test->calc.word_bits != word_bits) {
+		TapKey(test, KEY_WORD_SIZE, SWT_FN);
+	}
+	Step(test, -1, 0, 0);
+}
+
+/** Returns whether a line of the LCD starts with a string. */
+static uint8_t LcdStartsWith(struct Test const *test, uint8_t line, char const *str)
+{
+	return !memcmp(test->calc.lcd_text[line], str, strlen(str));
+}
+
+/** Returns whether a line of the LCD shows a string. */
+static uint8_t LcdShows(struct Test const *test, uint8_t line, char const *str)
+{
+	return strstr(test->calc.lcd_text[line], str) != NULL;
+}
+
+/** Returns 1 if a check holds, or prints what failed. */
+static uint8_t Check(char const *name, uint8_t holds)
+{
+	if (!holds) {
+		printf("failed: %s\n", name);
+	}
+	return holds;
+}
+
+/** Digits past the largest operand of the word size, or past the LCD, are ignored. */
+static uint8_t CheckDigitLimit(void)
+{
+	uint8_t holds = 1;
+	uint8_t const word_sizes[] = {8, 16, 32};
+	char const *const largest[] = {"0xFF ", "0xFFFF ", "0xFFFFFFFF "};
+	for (uint8_t i = 0; i < sizeof(word_sizes); ++i) {
+		struct Test test;
+		Start(&test);
+		SetWordBits(&test, word_sizes[i]);
+		TapKeys(&test, "FFFFFFFFFF", 0);
+		holds &= Check("hexadecimal digits stop at the word size", test.calc.nums[0] == test.calc.word_mask);
+		holds &= Check("the LCD shows the largest operand", LcdShows(&test, 0, largest[i]));
+	}
+
+	struct Test test;
+	Start(&test);
+	SetWordBits(&test, 8);
+	// hexadecimal down to decimal
+	TapBtn(&test, BTN_D, 0);
+	TapKeys(&test, "256", 0);
+	holds &= Check("a decimal digit that overflows the word is ignored", test.calc.nums[0] == 25);
+
+	Start(&test);
+	SetWordBits(&test, 32);
+	// hexadecimal up to binary
+	TapBtn(&test, BTN_U, 0);
+	for (uint8_t i = 0; i < 20; ++i) {
+		TapKey(&test, 1, 0);
+	}
+	// binary has no prefix, so the operand has 15 digits after the operator column
+	holds &= Check("binary digits stop at the width of the LCD", test.calc.nums[0] == 0x7FFF);
+	return holds;
+}
+
+/** = runs the operation, and a result that overflows the word lights the RGB LED red until the next digit. */
+static uint8_t CheckEqualsOverflow(void)
+{
+	uint8_t holds = 1;
+	struct Test test;
+	Start(&test);
+	SetWordBits(&test, 8);
+	TapKeys(&test, "FF", 0);
+	TapBtn(&test, BTN_C, 0);
+	TapKeys(&test, "2", 0);
+	holds &= Check("the RGB LED is off before =", test.calc.rgb[0] == 0);
+
+	Step(&test, -1, BTN_C, 0);
+	holds &= Check("= wraps the result to the word", test.calc.nums[0] == 0x01 && test.calc.num_idx == 0);
+	holds &= Check("an overflowed result lights the RGB LED red", test.delta.rgb && test.calc.rgb[0] && test.calc.overflow_stat.fields.result);
+	Step(&test, -1, 0, 0);
+
+	TapKeys(&test, "3", 0);
+	holds &= Check("a digit turns the RGB LED off", test.calc.rgb[0] == 0 && !test.calc.overflow_stat.is_ovf);
+	return holds;
+}
+
+/** Dividing by 0 shows an error, which ignores digits until R clears it. */
+static uint8_t CheckDivByZero(void)
+{
+	uint8_t holds = 1;
+	uint8_t const swt = 1 << Div;
+	struct Test test;
+	Start(&test);
+	Step(&test, -1, 0, swt);
+	TapKeys(&test, "5", swt);
+	TapBtn(&test, BTN_C, swt);
+	TapBtn(&test, BTN_C, swt);
+	holds &= Check("dividing by 0 is an error", test.calc.is_err && LcdStartsWith(&test, 0, "Err: div by 0"));
+
+	TapKeys(&test, "7", swt);
+	holds &= Check("digits are ignored until the error is cleared", test.calc.is_err && test.calc.nums[0] == 0);
+
+	TapBtn(&test, BTN_R, swt);
+	TapKeys(&test, "7", swt);
+	holds &= Check("R clears the error", !test.calc.is_err && test.calc.nums[0] == 7 && LcdShows(&test, 0, "0x   7"));
+	return holds;
+}
+
+/** Changing the base keeps the operand being typed, and the next digits are in the new base. */
+static uint8_t CheckBaseChange(void)
+{
+	uint8_t holds = 1;
+	struct Test test;
+	Start(&test);
+	TapKeys(&test, "12", 0);
+	// hexadecimal down to decimal
+	TapBtn(&test, BTN_D, 0);
+	holds &= Check("the operand is shown in the new base", test.calc.num_base == 10 && LcdShows(&test, 0, "0d   18"));
+
+	TapKeys(&test, "3A", 0);
+	holds &= Check("digits are typed in the new base", test.calc.nums[0] == 18 * 10 + 3 && LcdShows(&test, 0, "0d  183"));
+
+	// decimal up to hexadecimal
+	TapBtn(&test, BTN_U, 0);
+	holds &= Check("the operand is shown in the base changed back", LcdShows(&test, 0, "0x  B7"));
+	return holds;
+}
+
+/** RPN pushes X with C, and applies an operator to Y and X as its switch turns on. */
+static uint8_t CheckRpn(void)
+{
+	uint8_t holds = 1;
+	struct Test test;
+	Start(&test);
+	TapKey(&test, KEY_RPN, SWT_FN);
+	Step(&test, -1, 0, 0);
+	holds &= Check("Fn and 0 switch to RPN", test.calc.calc_mode == Rpn && test.calc.num_idx == 1);
+
+	TapKeys(&test, "7", 0);
+	TapBtn(&test, BTN_C, 0);
+	TapKeys(&test, "8", 0);
+	TapBtn(&test, BTN_C, 0);
+	TapKeys(&test, "9", 0);
+	holds &= Check("C pushes X, and the next entry replaces its copy", test.calc.nums[0] == 8 && test.calc.nums[1] == 9);
+
+	Step(&test, -1, 0, 1 << Add);
+	holds &= Check("an operator applies to Y and X, and drops the stack", test.calc.nums[0] == 7 && test.calc.nums[1] == 8 + 9);
+	Step(&test, -1, 0, 0);
+	Step(&test, -1, 0, 1 << Add);
+	holds &= Check("the operator applies again as its switch turns on again", test.calc.nums[0] == 0 && test.calc.nums[1] == 7 + 8 + 9);
+
+	TapKeys(&test, "4", 1 << Add);
+	holds &= Check("an entry after a result pushes the result", test.calc.nums[0] == 7 + 8 + 9 && test.calc.nums[1] == 4);
+	Step(&test, -1, 0, (1 << Add) | (1 << Sub));
+	holds &= Check("another switch turning on applies its operator", test.calc.nums[0] == 0 && test.calc.nums[1] == 7 + 8 + 9 - 4);
+	return holds;
+}
+
+/** L deletes the last digit, and R clears the operand, then both operands. */
+static uint8_t CheckClear(void)
+{
+	uint8_t holds = 1;
+	struct Test test;
+	Start(&test);
+	TapKeys(&test, "123", 0);
+	TapBtn(&test, BTN_L, 0);
+	holds &= Check("L deletes the last digit", test.calc.nums[0] == 0x12);
+
+	TapBtn(&test, BTN_C, 0);
+	TapKeys(&test, "4", 0);
+	TapBtn(&test, BTN_R, 0);
+	holds &= Check("R clears the second operand", test.calc.num_idx == 1 && test.calc.nums[0] == 0x12 && test.calc.nums[1] == 0);
+
+	TapBtn(&test, BTN_R, 0);
+	holds &= Check("R again clears both operands", test.calc.num_idx == 0 && test.calc.nums[0] == 0 && LcdShows(&test, 0, "0x   0"));
+	return holds;
+}
+
+// Samples of the input: 0x12 + 0x34 =, and in decimal RPN, 9 ENTER 2 -
+static struct InputState const std_inputs[] = {
+	{1, 0, 0}, {-1, 0, 0}, {2, 0, 0}, {-1, 0, 0}, {-1, BTN_C, 0}, {-1, 0, 0},
+	{3, 0, 0}, {-1, 0, 0}, {4, 0, 0}, {-1, 0, 0}, {-1, BTN_C, 0}, {-1, 0, 0}
+};
+static struct InputState const rpn_inputs[] = {
+	{KEY_RPN, 0, SWT_FN}, {-1, 0, SWT_FN}, {-1, 0, 0}, {-1, BTN_D, 0}, {-1, 0, 0},
+	{9, 0, 0}, {-1, 0, 0}, {-1, BTN_C, 0}, {-1, 0, 0}, {2, 0, 0}, {-1, 0, 0}, {-1, 0, 1 << Sub}
+};
+
+/** Runs the calculators on their samples of the input, taking turns. */
+static void RunTurns(struct Test *tests, struct InputState const *const *inputs, size_t const *counts, size_t test_count)
+{
+	for (size_t i = 0; ; ++i) {
+		uint8_t ran = 0;
+		for (size_t j = 0; j < test_count; ++j) {
+			if (i < counts[j]) {
+				Step(&tests[j], inputs[j][i].key, inputs[j][i].btn, inputs[j][i].swt);
+				ran = 1;
+			}
+		}
+		if (!ran) {
+			return;
+		}
+	}
+}
+
+/** Returns whether two calculators have the same operands and show the same. */
+static uint8_t IsSameShown(struct CalcState const *a, struct CalcState const *b)
+{
+	return !memcmp(a->nums, b->nums, sizeof(a->nums)) && !memcmp(a->lcd_text, b->lcd_text, sizeof(a->lcd_text))
+		&& !memcmp(a->rgb, b->rgb, sizeof(a->rgb)) && a->leds == b->leds;
+}
+
+/** Two calculators stepped in turns end up as each does when run alone. */
+static uint8_t CheckInterleaved(void)
+{
+	struct InputState const *const inputs[] = {std_inputs, rpn_inputs};
+	size_t const counts[] = {sizeof(std_inputs) / sizeof(*std_inputs), sizeof(rpn_inputs) / sizeof(*rpn_inputs)};
+	struct Test tests[2];
+	struct Test alone[2];
+	for (size_t i = 0; i < 2; ++i) {
+		Start(&tests[i]);
+		Start(&alone[i]);
+		RunTurns(&alone[i], &inputs[i], &counts[i], 1);
+	}
+	RunTurns(tests, inputs, counts, 2);
+
+	uint8_t holds = 1;
+	holds &= Check("the standard calculator runs its operation", tests[0].calc.nums[0] == 0x12 + 0x34);
+	holds &= Check("the RPN calculator runs its operation", tests[1].calc.nums[1] == 9 - 2 && LcdStartsWith(&tests[1], 1, "X0d    7"));
+	for (size_t i = 0; i < 2; ++i) {
+		holds &= Check("a calculator run in turns matches it run alone", IsSameShown(&tests[i].calc, &alone[i].calc));
+	}
+	return holds;
+}
+
+/** Changing the operator in the same sample as = runs the new operator, not the preview. */
+static uint8_t CheckOperatorWithEquals(void)
+{
+	struct Test test;
+	Start(&test);
+	TapKey(&test, KEY_PREVIEW, SWT_FN);
+	Step(&test, -1, 0, 0);
+	TapKey(&test, 5, 0);
+	Step(&test, -1, BTN_C, 0);
+	Step(&test, -1, 0, 0);
+	TapKey(&test, 3, 0);
+	// the preview shows 5 + 3 until the operator and = change together
+	Step(&test, -1, BTN_C, 1 << Mult);
+	return Check("operator changed with = runs the new operator", test.calc.nums[0] == 5 * 3);
+}
+
+/** Taps C in the Fn layer to undo, or with R held to redo. */
+static void TapUndo(struct Test *test, uint8_t redo)
+{
+	uint8_t const held = redo ? BTN_R : 0;
+	Step(test, -1, held, SWT_FN);
+	Step(test, -1, held | BTN_C, SWT_FN);
+	Step(test, -1, held, SWT_FN);
+	Step(test, -1, 0, SWT_FN);
+}
+
+/** Undoing back past a word size that truncated an operand can still be redone. */
+static uint8_t CheckRedoAcrossWordSize(void)
+{
+	struct Test test;
+	Start(&test);
+	// 32-bit words
+	TapKey(&test, KEY_WORD_SIZE, SWT_FN);
+	Step(&test, -1, 0, 0);
+	for (int8_t key = 1; key <= 6; ++key) {
+		TapKey(&test, key, 0);
+	}
+	// 8-bit words truncate the operand, then 16-bit words keep it
+	TapKey(&test, KEY_WORD_SIZE, SWT_FN);
+	TapKey(&test, KEY_WORD_SIZE, SWT_FN);
+	Step(&test, -1, 0, 0);
+	TapKey(&test, 7, 0);
+	uint32_t const typed = test.calc.nums[0];
+
+	for (uint8_t i = 0; i < 3; ++i) {
+		TapUndo(&test, 0);
+	}
+	for (uint8_t i = 0; i < 3; ++i) {
+		TapUndo(&test, 1);
+	}
+	return Check("undone changes across a word size can be redone", typed == 0x567 && test.calc.nums[0] == typed);
+}
+
+int main(void)
+{
+	uint8_t (*const checks[])(void) = {
+		CheckDigitLimit,
+		CheckEqualsOverflow,
+		CheckDivByZero,
+		CheckBaseChange,
+		CheckRpn,
+		CheckClear,
+		CheckInterleaved,
+		CheckOperatorWithEquals,
+		CheckRedoAcrossWordSize
+	};
+	size_t const count = sizeof(checks) / sizeof(*checks);
+	size_t failed = 0;
+	for (size_t i = 0; i < count; ++i) {
+		failed += !checks[i]();
+	}
+	printf("%zu of %zu checks passed\n", count - failed, count);
+	return failed ? 1 : 0;
+}
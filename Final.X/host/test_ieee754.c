@@ -0,0 +1,234 @@
+/*
+ * Host test of the IEEE 754 inspector.
+ *
+ * Converts every binary16 number and a sample of binary32 and binary64 numbers to
+ * their shortest decimal, and checks with the C library that each decimal converts
+ * back to the same number, that no decimal with one digit less does, and that it is
+ * the closest decimal of its length. Then reports the conversions per second.
+ *
+ * Build and run from this directory:
+ *   cc -O2 -I../code -o test_ieee754 test_ieee754.c ../code/ieee754.c ../code/radix.c ../code/bitops.c -lm
+ *   ./test_ieee754
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "ieee754.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Number of binary32 numbers checked, evenly spread over every exponent
+#define SINGLE_SAMPLES (1 << 21)
+// Number of random binary64 numbers checked
+#define DOUBLE_SAMPLES (1 << 18)
+// Number of conversions when timing
+#define BENCH_COUNT (1 << 18)
+
+static char const *const format_names[IEEE_FORMAT_COUNT] = {"binary16", "binary32", "binary64"};
+
+/** Returns a random 64-bit number. */
+static uint64_t Rand64(void)
+{
+	uint64_t r = 0;
+	for (int i = 0; i < 4; ++i) {
+		r = (r << 16) ^ (rand() & 0xFFFF);
+	}
+	return r;
+}
+
+/** Returns the exact value of a binary16 or binary32 number as a double. */
+static double ToDouble(enum IeeeFormat fmt, uint64_t bits)
+{
+	struct IeeeFields fields;
+	Ieee_Unpack(fmt, bits, &fields);
+	int const mant_bits = Ieee_GetMantBits(fmt);
+	int const bias = Ieee_GetBias(fmt);
+	double value;
+	if (fields.exp == 0) {
+		value = ldexp((double)fields.mant, 1 - bias - mant_bits);
+	} else {
+		value = ldexp((double)(fields.mant | ((uint64_t)1 << mant_bits)), fields.exp - bias - mant_bits);
+	}
+	return fields.sign ? -value : value;
+}
+
+/**
+ * Returns whether a decimal string reads back as the given number,
+ * rounding to nearest with ties to even.
+ */
+static int ReadsBack(enum IeeeFormat fmt, uint64_t bits, char const *str)
+{
+	if (fmt == IeeeDouble) {
+		double const value = strtod(str, NULL);
+		uint64_t read;
+		memcpy(&read, &value, sizeof(read));
+		return read == bits;
+	}
+
+	// binary16 and binary32 are exact in a double, and so are the bounds halfway
+	// to their neighbours, so compare with the rounding interval
+	struct IeeeFields fields;
+	Ieee_Unpack(fmt, bits, &fields);
+	double const value = fabs(ToDouble(fmt, bits));
+	int const exp = fields.exp ? fields.exp : 1;
+	double const ulp = ldexp(1, exp - Ieee_GetBias(fmt) - Ieee_GetMantBits(fmt));
+	double const high = value + ulp / 2;
+	// the number below is closer at the bottom of each power of two
+	double const low = value - ((fields.mant == 0 && fields.exp > 1) ? ulp / 4 : ulp / 2);
+	double const read = fabs(strtod(str, NULL));
+	if (fmt == IeeeSingle && strtof(str, NULL) != (float)ToDouble(fmt, bits)) {
+		return 0;
+	}
+	if (fields.mant & 1) {
+		return read > low && read < high;
+	} else {
+		return read >= low && read <= high;
+	}
+}
+
+/** Checks the decimal of a number, printing any failure. Returns whether it passed. */
+static int Check(enum IeeeFormat fmt, uint64_t bits)
+{
+	struct IeeeDecimal dec;
+	Ieee_ToDecimal(fmt, bits, &dec);
+
+	struct IeeeFields fields;
+	Ieee_Unpack(fmt, bits, &fields);
+	if (Ieee_Pack(fmt, &fields) != bits) {
+		printf("%s 0x%llX: fields don't pack back\n", format_names[fmt], (unsigned long long)bits);
+		return 0;
+	}
+	if (dec.kind != IeeeFinite) {
+		return 1;
+	}
+
+	char str[64];
+	snprintf(str, sizeof(str), "%s%llue%d", dec.sign ? "-" : "", (unsigned long long)dec.digits, dec.exp);
+	if (!ReadsBack(fmt, bits, str)) {
+		printf("%s 0x%llX: %s doesn't read back\n", format_names[fmt], (unsigned long long)bits, str);
+		return 0;
+	}
+
+	double value;
+	if (fmt == IeeeDouble) {
+		memcpy(&value, &bits, sizeof(value));
+	} else {
+		value = ToDouble(fmt, bits);
+	}
+	int const count = snprintf(NULL, 0, "%llu", (unsigned long long)dec.digits);
+
+	// the closest decimal with one digit less must not read back
+	char shorter[64];
+	if (count > 1) {
+		snprintf(shorter, sizeof(shorter), "%.*e", count - 2, value);
+		if (ReadsBack(fmt, bits, shorter)) {
+			printf("%s 0x%llX: %s is shorter than %s\n", format_names[fmt], (unsigned long long)bits, shorter, str);
+			return 0;
+		}
+	}
+
+	// the closest decimal of the same length is the output, unless it doesn't read back
+	char closest[64];
+	snprintf(closest, sizeof(closest), "%.*e", count - 1, value);
+	if (strtod(closest, NULL) != strtod(str, NULL) && ReadsBack(fmt, bits, closest)) {
+		printf("%s 0x%llX: %s is closer than %s\n", format_names[fmt], (unsigned long long)bits, closest, str);
+		return 0;
+	}
+
+	// the string on the LCD reads back too, unless it had to be rounded to fit
+	char lcd[16];
+	uint8_t const len = Ieee_ToStr(fmt, bits, lcd, sizeof(lcd) - 1);
+	lcd[len] = '\0';
+	if (count <= 9 && !ReadsBack(fmt, bits, lcd)) {
+		printf("%s 0x%llX: \"%s\" doesn't read back\n", format_names[fmt], (unsigned long long)bits, lcd);
+		return 0;
+	}
+	return 1;
+}
+
+/** Returns the current time in seconds. */
+static double Now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/** Prints the conversions per second of a format over random bit patterns. */
+static void Bench(enum IeeeFormat fmt)
+{
+	uint64_t const mask = (fmt == IeeeDouble) ? ~(uint64_t)0 : ((uint64_t)1 << Ieee_GetWidth(fmt)) - 1;
+	static uint64_t patterns[BENCH_COUNT];
+	for (uint32_t i = 0; i < BENCH_COUNT; ++i) {
+		patterns[i] = Rand64() & mask;
+	}
+
+	// the sum keeps the calls from being optimized out
+	volatile uint64_t sink;
+	uint64_t sum = 0;
+	double const start = Now();
+	for (uint32_t i = 0; i < BENCH_COUNT; ++i) {
+		struct IeeeDecimal dec;
+		Ieee_ToDecimal(fmt, patterns[i], &dec);
+		sum += dec.digits;
+	}
+	double const end = Now();
+
+	sink = sum;
+	(void)sink;
+	printf("%-10s %12.0f\n", format_names[fmt], BENCH_COUNT / (end - start));
+}
+
+int main(void)
+{
+	uint32_t failed = 0;
+
+	for (uint32_t bits = 0; bits <= 0xFFFF; ++bits) {
+		failed += !Check(IeeeHalf, bits);
+	}
+	printf("binary16: all 65536 checked\n");
+
+	// a stride that is odd and not a multiple of the mantissa spacing visits
+	// varied mantissas in every exponent
+	uint32_t const stride = 0xFFFFFFFFu / SINGLE_SAMPLES | 1;
+	uint32_t bits = 0;
+	for (uint32_t i = 0; i < SINGLE_SAMPLES; ++i, bits += stride) {
+		failed += !Check(IeeeSingle, bits);
+	}
+	// the smallest and largest of each kind
+	static uint32_t const single_edges[] = {
+		0x00000001, 0x007FFFFF, 0x00800000, 0x7F7FFFFF, 0x3F800000, 0x3F7FFFFF, 0x3F800001
+	};
+	for (size_t i = 0; i < sizeof(single_edges) / sizeof(*single_edges); ++i) {
+		failed += !Check(IeeeSingle, single_edges[i]);
+	}
+	printf("binary32: %u sampled\n", SINGLE_SAMPLES);
+
+	srand(1);
+	for (uint32_t i = 0; i < DOUBLE_SAMPLES; ++i) {
+		failed += !Check(IeeeDouble, Rand64());
+	}
+	static uint64_t const double_edges[] = {
+		0x0000000000000001, 0x000FFFFFFFFFFFFF, 0x0010000000000000, 0x7FEFFFFFFFFFFFFF,
+		0x3FF0000000000000, 0x3FB999999999999A, 0x4415AF1D78B58C40, 0x44B52D02C7E14AF6
+	};
+	for (size_t i = 0; i < sizeof(double_edges) / sizeof(*double_edges); ++i) {
+		failed += !Check(IeeeDouble, double_edges[i]);
+	}
+	printf("binary64: %u sampled\n", DOUBLE_SAMPLES);
+
+	if (failed) {
+		printf("%u failed\n", failed);
+		return 1;
+	}
+
+	printf("%-10s %12s\n", "format", "conv/s");
+	for (enum IeeeFormat fmt = 0; fmt < IEEE_FORMAT_COUNT; ++fmt) {
+		Bench(fmt);
+	}
+	return 0;
+}
@@ -0,0 +1,446 @@
+/*
+ * Terminal front-end that runs the whole program on a PC.
+ *
+ * Runs App_Process in virtual time with the LCD and keypad models, and draws the
+ * LCD, the 8 LEDs, the RGB LED, the switches, and the buttons with ANSI escapes.
+ * The RGB LED shows the share of time each color's pin was high, as the eye would
+ * see its pulses. Only the cells that changed since the last frame are written, so
+ * a frame that changes nothing writes nothing.
+ *
+ * Interactively, the program runs in step with the wall clock:
+ *   0-9 and a-f    press a key of the keypad
+ *   arrow keys     press U, D, L, or R
+ *   enter, space   press C
+ *   ! @ # $ % ^ & * flip switches 0 to 7 (shift and 1 to 8), switch 7 being Fn
+ *   q              quit
+ * Given a recording from the Recorder module, it replays it as fast as it can,
+ * drawing a frame for every loop, and reports the frames per second after.
+ *
+ * Build and run from this directory:
+ *   cc -O2 -I../code -o tui tui.c board.c hd44780.c pmodkypd.c \
+ *     $(find ../code -name '*.c' ! -name main.c ! -name hal_pic32.c)
+ *   ./tui [session.bin]
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "board.h"
+#include "hd44780.h"
+#include "pmodkypd.h"
+#include "app.h"
+#include "config.h"
+#include "recorder.h"
+#include "utils.h"
+#include "hal/hal_sim.h"
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SCREEN_ROWS 8
+#define SCREEN_COLS 48
+// Longest escape sequence written for a cell
+#define MAX_CELL_OUT 48
+// How long a key or button is held for each press
+#define HOLD_NS 150000000ULL
+// Time between frames when interactive
+#define FRAME_MS 16
+// Color of a cell left to the terminal
+#define COLOR_DEFAULT 0xFFFFFFFF
+
+#define LCD_FG 0x102010
+#define LCD_BG 0x80C040
+#define LED_ON 0x40FF40
+
+/** A character cell of the terminal, with its colors as 0xRRGGBB. */
+struct Cell {
+	char ch;
+	uint32_t fg;
+	uint32_t bg;
+};
+
+// what is drawn, and what the terminal shows
+static struct Cell screen[SCREEN_ROWS][SCREEN_COLS];
+static struct Cell shown[SCREEN_ROWS][SCREEN_COLS];
+static char out[SCREEN_ROWS * SCREEN_COLS * MAX_CELL_OUT];
+static uint64_t out_total;
+
+static struct termios saved_termios;
+static uint8_t is_raw;
+static uint8_t is_set_up;
+
+// the buttons and the keys that flip the switches, by their bits in the input state
+static char const btn_names[BOARD_BTN_COUNT + 1] = "ULCRD";
+static char const swt_keys[BOARD_SWT_COUNT + 1] = "!@#$%^&*";
+
+static uint8_t const rgb_pins[] = {pin_LED8_R, pin_LED8_G, pin_LED8_B};
+// the virtual time each color's pin was high since the last frame
+static uint64_t rgb_on_ns[3];
+static uint64_t rgb_last_ns;
+static uint64_t frame_start_ns;
+static uint8_t rgb_levels;
+
+/** Adds the time since the last write to the RGB LED to the colors that were on. */
+static void RgbHook(enum HalPort port)
+{
+	(void)port;
+	uint64_t const now = HalSim_GetTimeNs();
+	uint8_t levels = 0;
+	for (uint8_t i = 0; i < 3; ++i) {
+		if (rgb_levels & (1 << i)) {
+			rgb_on_ns[i] += now - rgb_last_ns;
+		}
+		if (HalSim_GetLat(HAL_PIN_PORT(rgb_pins[i])) & HAL_PIN_MASK(rgb_pins[i])) {
+			levels |= 1 << i;
+		}
+	}
+	rgb_levels = levels;
+	rgb_last_ns = now;
+}
+
+/** Writes a string into the screen at a cell. */
+static void Put(uint8_t row, uint8_t col, char const *str, uint32_t fg, uint32_t bg)
+{
+	for (; *str && col < SCREEN_COLS; ++str, ++col) {
+		screen[row][col] = (struct Cell){*str, fg, bg};
+	}
+}
+
+/** Draws the board into the screen. */
+static void Draw(struct InputState const *state, uint64_t loops)
+{
+	char str[SCREEN_COLS + 1];
+
+	Put(0, 0, "+----------------+", COLOR_DEFAULT, COLOR_DEFAULT);
+	Put(3, 0, "+----------------+", COLOR_DEFAULT, COLOR_DEFAULT);
+	for (uint8_t line = 0; line < 2; ++line) {
+		char lcd[HD44780_SHOWN_LEN];
+		Hd44780_GetShownLine(line, lcd);
+		Put(line + 1, 0, "|", COLOR_DEFAULT, COLOR_DEFAULT);
+		for (uint8_t i = 0; i < HD44780_SHOWN_LEN; ++i) {
+			// custom glyphs, such as the bit cursor, are shown in reverse
+			uint8_t const is_glyph = (uint8_t)lcd[i] < ' ';
+			screen[line + 1][1 + i] = is_glyph ? (struct Cell){'_', LCD_BG, LCD_FG} : (struct Cell){lcd[i], LCD_FG, LCD_BG};
+		}
+		Put(line + 1, 1 + HD44780_SHOWN_LEN, "|", COLOR_DEFAULT, COLOR_DEFAULT);
+	}
+
+	// the LEDs and switches with 7 on the left, as on the board
+	uint32_t const leds = HalSim_GetLat(port_LEDS_GRP) & msk_LEDS_GRP;
+	Put(4, 0, "LED", COLOR_DEFAULT, COLOR_DEFAULT);
+	Put(5, 0, "SWT", COLOR_DEFAULT, COLOR_DEFAULT);
+	for (uint8_t i = 0; i < 8; ++i) {
+		uint8_t const bit = 7 - i;
+		uint8_t const led = (leds >> bit) & 1;
+		screen[4][4 + i] = (struct Cell){led ? '*' : '.', led ? LED_ON : COLOR_DEFAULT, COLOR_DEFAULT};
+		uint8_t const swt = (state->swt >> bit) & 1;
+		screen[5][4 + i] = (struct Cell){swt ? '1' : '0', swt ? COLOR_DEFAULT : 0x808080, COLOR_DEFAULT};
+	}
+
+	// the share of the frame each color was on, with the block showing its hue
+	uint64_t const now = HalSim_GetTimeNs();
+	RgbHook(HAL_PIN_PORT(pin_LED8_R));
+	uint64_t const frame_ns = now - frame_start_ns;
+	uint8_t duty[3];
+	uint8_t most = 0;
+	for (uint8_t i = 0; i < 3; ++i) {
+		duty[i] = frame_ns ? rgb_on_ns[i] * 100 / frame_ns : 0;
+		most = (duty[i] > most) ? duty[i] : most;
+		rgb_on_ns[i] = 0;
+	}
+	frame_start_ns = now;
+	uint32_t color = 0;
+	for (uint8_t i = 0; i < 3 && most; ++i) {
+		color |= (uint32_t)(duty[i] * 255 / most) << (16 - 8 * i);
+	}
+	Put(4, 14, "RGB", COLOR_DEFAULT, COLOR_DEFAULT);
+	Put(4, 18, "    ", COLOR_DEFAULT, most ? color : COLOR_DEFAULT);
+	snprintf(str, sizeof(str), " %3u%% %3u%% %3u%%", duty[0], duty[1], duty[2]);
+	Put(4, 22, str, COLOR_DEFAULT, COLOR_DEFAULT);
+
+	Put(5, 14, "BTN", COLOR_DEFAULT, COLOR_DEFAULT);
+	for (uint8_t i = 0; i < BOARD_BTN_COUNT; ++i) {
+		uint8_t const held = (state->btn >> i) & 1;
+		screen[5][18 + 2 * i] = (struct Cell){btn_names[i], held ? 0 : COLOR_DEFAULT, held ? LED_ON : COLOR_DEFAULT};
+	}
+	snprintf(str, sizeof(str), "KEY %c", (state->key < 0) ? '-' : "0123456789ABCDEF"[state->key]);
+	Put(5, 30, str, COLOR_DEFAULT, COLOR_DEFAULT);
+
+	snprintf(str, sizeof(str), "%10.3f s %10llu loops", now * 1e-9, (unsigned long long)loops);
+	Put(6, 0, str, COLOR_DEFAULT, COLOR_DEFAULT);
+	Put(7, 0, "0-F keys, arrows/enter btns, !-* swts, q quit", 0x808080, COLOR_DEFAULT);
+}
+
+/** Adds the escape sequence for a color to the output. */
+static size_t PutColor(char *str, uint8_t is_bg, uint32_t color)
+{
+	if (color == COLOR_DEFAULT) {
+		return sprintf(str, "\x1b[%um", is_bg ? 49 : 39);
+	}
+	return sprintf(str, "\x1b[%u;2;%u;%u;%um", is_bg ? 48 : 38, (color >> 16) & 0xFF, (color >> 8) & 0xFF, color & 0xFF);
+}
+
+/** Writes the cells that changed since the last frame to the terminal, in one write. */
+static void Render(void)
+{
+	// the colors and cursor the terminal is left with
+	static uint32_t fg = COLOR_DEFAULT;
+	static uint32_t bg = COLOR_DEFAULT;
+	static int cursor_row = -1;
+	static int cursor_col = -1;
+
+	size_t len = 0;
+	for (uint8_t row = 0; row < SCREEN_ROWS; ++row) {
+		for (uint8_t col = 0; col < SCREEN_COLS; ++col) {
+			struct Cell const *cell = &screen[row][col];
+			if (!memcmp(cell, &shown[row][col], sizeof(*cell))) {
+				continue;
+			}
+			if (row != cursor_row || col != cursor_col) {
+				len += sprintf(out + len, "\x1b[%u;%uH", row + 1, col + 1);
+			}
+			if (cell->fg != fg) {
+				len += PutColor(out + len, 0, cell->fg);
+				fg = cell->fg;
+			}
+			if (cell->bg != bg) {
+				len += PutColor(out + len, 1, cell->bg);
+				bg = cell->bg;
+			}
+			out[len++] = cell->ch;
+			shown[row][col] = *cell;
+			cursor_row = row;
+			cursor_col = col + 1;
+		}
+	}
+	if (len && write(STDOUT_FILENO, out, len) != (ssize_t)len) {
+		return;
+	}
+	out_total += len;
+}
+
+/** Puts the terminal back as it was. */
+static void RestoreTerminal(void)
+{
+	static char const leave[] = "\x1b[0m\x1b[?25h\x1b[?1049l";
+	if (!is_set_up) {
+		return;
+	}
+	is_set_up = 0;
+	if (write(STDOUT_FILENO, leave, sizeof(leave) - 1) < 0) {
+		return;
+	}
+	if (is_raw) {
+		tcsetattr(STDIN_FILENO, TCSAFLUSH, &saved_termios);
+		is_raw = 0;
+	}
+}
+
+static void OnSignal(int sig)
+{
+	RestoreTerminal();
+	_exit(128 + sig);
+}
+
+/** Switches to the alternate screen and hides the cursor, reading keys as they are typed. */
+static void SetUpTerminal(void)
+{
+	if (isatty(STDIN_FILENO) && !tcgetattr(STDIN_FILENO, &saved_termios)) {
+		struct termios raw = saved_termios;
+		raw.c_lflag &= ~(ECHO | ICANON | ISIG);
+		raw.c_iflag &= ~(IXON | ICRNL);
+		raw.c_cc[VMIN] = 0;
+		raw.c_cc[VTIME] = 0;
+		is_raw = !tcsetattr(STDIN_FILENO, TCSAFLUSH, &raw);
+	}
+	is_set_up = 1;
+	atexit(RestoreTerminal);
+	signal(SIGINT, OnSignal);
+	signal(SIGTERM, OnSignal);
+
+	// every cell differs from a NUL, so the first frame writes them all
+	memset(shown, 0, sizeof(shown));
+	for (uint8_t row = 0; row < SCREEN_ROWS; ++row) {
+		for (uint8_t col = 0; col < SCREEN_COLS; ++col) {
+			screen[row][col] = (struct Cell){' ', COLOR_DEFAULT, COLOR_DEFAULT};
+		}
+	}
+	static char const enter[] = "\x1b[?1049h\x1b[?25l\x1b[0m\x1b[2J";
+	if (write(STDOUT_FILENO, enter, sizeof(enter) - 1) < 0) {
+		return;
+	}
+}
+
+/** Returns the current time in ns. */
+static uint64_t NowNs(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/** Runs a loop of the program as main() does. */
+static void RunLoop(void)
+{
+	App_Process();
+	DelayAprox100Us(10);
+}
+
+/** Starts the program with nothing pressed. */
+static void StartApp(struct InputState const *state)
+{
+	HalSim_SetRealTime(0);
+	Hd44780_Init();
+	PmodKypd_Init();
+	HalSim_AddWriteHook(RgbHook);
+	Board_DriveInput(state);
+	App_Init();
+}
+
+/**
+ * Reads the keys typed, pressing keypad keys and buttons until release_ns and flipping
+ * switches. Returns 0 if the user quit.
+ */
+static uint8_t ReadKeys(struct InputState *state, uint64_t *release_ns)
+{
+	char keys[64];
+	ssize_t const count = read(STDIN_FILENO, keys, sizeof(keys));
+	for (ssize_t i = 0; i < count; ++i) {
+		char const c = keys[i];
+		char const *swt = strchr(swt_keys, c);
+		int8_t btn = -1;
+		if (c == 'q' || c == 3) {
+			return 0;
+		} else if (c >= '0' && c <= '9') {
+			state->key = c - '0';
+		} else if ((c | 0x20) >= 'a' && (c | 0x20) <= 'f') {
+			state->key = (c | 0x20) - 'a' + 10;
+		} else if (c && swt) {
+			state->swt ^= 1 << (swt - swt_keys);
+			continue;
+		} else if (c == '\r' || c == '\n' || c == ' ') {
+			btn = 2;
+		} else if (c == 0x1b && i + 2 < count && keys[i + 1] == '[') {
+			// arrow keys: up, down, right, left
+			char const *arrow = strchr("ABCD", keys[i + 2]);
+			static int8_t const arrow_btns[] = {0, 4, 3, 1};
+			i += 2;
+			if (!keys[i] || !arrow) {
+				continue;
+			}
+			btn = arrow_btns[arrow - "ABCD"];
+		} else {
+			continue;
+		}
+		if (btn >= 0) {
+			state->btn = 1 << btn;
+		}
+		*release_ns = HalSim_GetTimeNs() + HOLD_NS;
+	}
+	return 1;
+}
+
+/** Runs the program in step with the wall clock, as the user types. */
+static void RunInteractive(void)
+{
+	struct InputState state = {-1, 0, 0};
+	StartApp(&state);
+	SetUpTerminal();
+
+	uint64_t const start = NowNs();
+	uint64_t release_ns = 0;
+	uint64_t loops = 0;
+	for (;;) {
+		if (!ReadKeys(&state, &release_ns)) {
+			break;
+		}
+		// catch the virtual clock up with the wall clock
+		uint64_t const wall_ns = NowNs() - start;
+		while (HalSim_GetTimeNs() < wall_ns) {
+			if (release_ns && HalSim_GetTimeNs() >= release_ns) {
+				state.key = -1;
+				state.btn = 0;
+				release_ns = 0;
+			}
+			Board_DriveInput(&state);
+			RunLoop();
+			++loops;
+		}
+		Draw(&state, loops);
+		Render();
+
+		struct pollfd fd = {STDIN_FILENO, POLLIN, 0};
+		poll(&fd, 1, FRAME_MS);
+	}
+}
+
+/** Replays a recording as fast as it can, drawing every loop. Returns 0 if it can't be read. */
+static uint8_t RunPlayback(char const *path)
+{
+	static uint8_t data[RECORDER_BUFFER_SIZE];
+	FILE *file = fopen(path, "rb");
+	if (!file) {
+		printf("can't open %s\n", path);
+		return 0;
+	}
+	uint16_t const len = fread(data, 1, sizeof(data), file);
+	fclose(file);
+	if (len < RECORDER_HEADER_LEN) {
+		printf("%s is too short\n", path);
+		return 0;
+	}
+	uint32_t const samples = Recorder_GetSampleCount(data);
+
+	struct InputState state = {-1, 0, 0};
+	struct InputState next = state;
+	StartApp(&state);
+	SetUpTerminal();
+
+	uint64_t const start = NowNs();
+	uint64_t loops = 0;
+	uint16_t pos = RECORDER_HEADER_LEN;
+	uint32_t count = 0;
+	uint8_t quit = 0;
+	while (loops < samples && !quit) {
+		// the samples before a record are the same as the one before them
+		if (count == 0 && pos) {
+			pos = Recorder_ReadRecord(data, len, pos, &count, &next);
+		}
+		if (count && --count == 0) {
+			state = next;
+			Board_DriveInput(&state);
+		}
+		RunLoop();
+		++loops;
+		Draw(&state, loops);
+		Render();
+
+		char key;
+		if ((loops & 0xFF) == 0 && is_raw && read(STDIN_FILENO, &key, 1) == 1 && (key == 'q' || key == 3)) {
+			quit = 1;
+		}
+	}
+	double const wall_s = (NowNs() - start) * 1e-9;
+	RestoreTerminal();
+	printf("%llu frames in %.2f s: %.0f frames/s, %.1f s of virtual time, %.1f bytes written per frame\n",
+			(unsigned long long)loops, wall_s, loops / wall_s, HalSim_GetTimeNs() * 1e-9, (double)out_total / loops);
+	return 1;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc > 1) {
+		return RunPlayback(argv[1]) ? 0 : 1;
+	}
+	if (!isatty(STDIN_FILENO) || !isatty(STDOUT_FILENO)) {
+		printf("run in a terminal, or give a recording to replay\n");
+		return 1;
+	}
+	RunInteractive();
+	return 0;
+}
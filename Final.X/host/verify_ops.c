@@ -0,0 +1,655 @@
+/*
+ * Host differential verifier of the calculator's operators.
+ *
+ * Checks the result, overflow flag, divide by 0 error, and remainder of Calc_RunOp,
+ * the arithmetic = runs, against a separate reference model, for every operator in
+ * the integer and fixed-point division modes. Words of up to 16 bits are checked for
+ * every pair of operands. Wider words are sampled: pairs are drawn evenly from each
+ * pair of operand bit lengths, and the edge values of the word and of what fits on
+ * the LCD are paired with each other and with samples. Each row of pairs is checked
+ * in the next of the 35 bases, so every base sees pairs across the whole range.
+ *
+ * The rows are shared out between threads, each with its own calculator. A thread
+ * takes rows from the front of its own range, and once that is empty steals the back
+ * half of the largest range left. The reference is computed for a whole row at a time,
+ * in loops the compiler can vectorize. Reports pairs per second, in all and per core.
+ *
+ * Build and run from this directory, optionally with the word size, the number of threads,
+ * and the pairs sampled for each pair of bit lengths:
+ *   cc -O3 -pthread -I../code -o verify_ops verify_ops.c \
+ *     $(find ../code -name '*.c' ! -name main.c ! -name hal_pic32.c)
+ *   ./verify_ops [16 [threads [samples]]]
+ *
+ * Author: Benjamin Hall
+ * Date: 2026 October 19
+ */
+
+#include "calculator.h"
+#include "radix.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Widest word checked for every pair
+#define EXHAUSTIVE_BITS 16
+// Most pairs in a row
+#define ROW_LEN 65536
+// Default pairs sampled for each pair of bit lengths
+#define SAMPLES 4096
+// Most edge values of a format
+#define MAX_EDGES 256
+// Rows a thread takes from its own range at a time
+#define CHUNK_ROWS 4
+#define MAX_THREADS 256
+// Mismatches printed
+#define MAX_REPORTS 16
+// Seconds between progress reports
+#define PROGRESS_S 10
+
+#define BASE_COUNT (RADIX_MAX - RADIX_MIN + 1)
+// The LCD columns after the operator
+#define LCD_COLS 15
+
+/** A division mode, with the quarters of the word that are fraction bits. */
+struct Format {
+	char const *name;
+	enum DivMode div_mode;
+	uint8_t fixed_quarters;
+};
+
+static struct Format const formats[] = {
+	{"integer", DivQuot, 0},
+	{"fixed 1/4", DivFixed, 1},
+	{"fixed 2/4", DivFixed, 2},
+	{"fixed 3/4", DivFixed, 3}
+};
+#define FORMAT_COUNT (sizeof(formats) / sizeof(*formats))
+
+static enum Operator const ops[] = {
+	Add, Sub, Mult, Div, And, Or, Xor, Popcount, Clz, Clo, Ctz, Parity, BitReverse, ByteSwap
+};
+static char const *const op_names[] = {
+	"add", "sub", "mult", "div", "and", "or", "xor", "popcount", "clz", "clo", "ctz", "parity", "bit reverse", "byte swap"
+};
+#define OP_COUNT (sizeof(ops) / sizeof(*ops))
+
+/** The rows of one operator in one format. */
+struct Job {
+	uint8_t format;
+	uint8_t op;
+	uint64_t first_row;
+	uint64_t rows;
+};
+
+/** What the reference model and the rows of a format need. */
+struct FormatInfo {
+	uint8_t frac_bits;
+	// number of results that fit the word and LCD in each base, so larger ones overflow
+	uint64_t fit_count[RADIX_MAX + 1];
+	uint32_t edges[MAX_EDGES];
+	uint16_t edge_count;
+};
+
+/** A thread, its range of rows, and what it has checked. */
+struct Worker {
+	pthread_t thread;
+	pthread_mutex_t lock;
+	uint64_t next;
+	uint64_t end;
+
+	struct CalcState calc;
+	uint32_t *lhs;
+	uint32_t *rhs;
+	uint64_t *ref;
+	uint8_t *ref_err;
+
+	uint64_t pairs;
+	uint64_t mismatches;
+	uint32_t steals;
+	double cpu_s;
+	double done_s;
+};
+
+static uint8_t word_bits;
+static uint32_t word_mask;
+static uint8_t exhaustive;
+static uint32_t samples;
+static struct FormatInfo infos[FORMAT_COUNT];
+static struct Job jobs[FORMAT_COUNT * OP_COUNT];
+static uint8_t job_count;
+static uint64_t total_rows;
+
+static struct Worker workers[MAX_THREADS];
+static uint16_t worker_count;
+static atomic_uint_fast64_t rows_done;
+static pthread_mutex_t report_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t reports;
+
+/** Returns whether an operator only uses its first operand. */
+static uint8_t IsUnary(enum Operator op)
+{
+	return op >= Popcount;
+}
+
+/** Returns the next number of a splitmix64 sequence. */
+static uint64_t Next(uint64_t *seed)
+{
+	uint64_t z = (*seed += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/** Returns a random value with a bit length, 0 having length 0. */
+static uint32_t RandomOfLength(uint64_t *seed, uint8_t len)
+{
+	if (len == 0) {
+		return 0;
+	}
+	uint32_t const low = (uint32_t)1 << (len - 1);
+	return low | (Next(seed) & (low - 1));
+}
+
+/** Returns the characters of a base's prefix on the LCD. */
+static uint8_t PrefixLen(uint8_t base)
+{
+	if (base == 2) {
+		return 0;
+	} else if (base == 8 || base == 10 || base == 16) {
+		return 2;
+	}
+	return (base < 10 ? 1 : 2) + 1;
+}
+
+/** Adds an edge value to a format if it fits the word and isn't there yet. */
+static void AddEdge(struct FormatInfo *info, uint64_t value)
+{
+	if (value > word_mask || info->edge_count == MAX_EDGES) {
+		return;
+	}
+	for (uint16_t i = 0; i < info->edge_count; ++i) {
+		if (info->edges[i] == value) {
+			return;
+		}
+	}
+	info->edges[info->edge_count++] = value;
+}
+
+/**
+ * Works out, from the LCD layout, how many results fit in each base of a format, and
+ * the edge values: small values, the ends of the word, values around each power of two,
+ * and values around the largest that fits the LCD in each base.
+ */
+static void SetUpFormat(struct Format const *format, struct FormatInfo *info)
+{
+	info->frac_bits = (format->div_mode == DivFixed) ? word_bits / 4 * format->fixed_quarters : 0;
+	uint8_t const frac = info->frac_bits;
+
+	for (uint8_t base = RADIX_MIN; base <= RADIX_MAX; ++base) {
+		// enough fraction digits to tell every fraction apart, if base^digits fits 32 bits
+		uint8_t frac_digits = 0;
+		for (uint64_t scale = 1; scale < ((uint64_t)1 << frac) && scale * base <= 0xFFFFFFFF; scale *= base) {
+			++frac_digits;
+		}
+		int8_t const int_digits = LCD_COLS - PrefixLen(base) - (frac ? 1 + frac_digits : 0);
+
+		// the integer parts that fit are those below base^int_digits
+		uint64_t fit_count = 0;
+		if (int_digits >= 1) {
+			uint64_t ints = 1;
+			for (int8_t i = 0; i < int_digits && ints <= word_mask; ++i) {
+				ints *= base;
+			}
+			fit_count = ints << frac;
+		}
+		info->fit_count[base] = (fit_count > (uint64_t)word_mask + 1) ? (uint64_t)word_mask + 1 : fit_count;
+	}
+
+	info->edge_count = 0;
+	for (uint8_t i = 0; i < 4; ++i) {
+		AddEdge(info, i);
+		AddEdge(info, word_mask - i);
+	}
+	for (uint8_t bit = 1; bit < word_bits; ++bit) {
+		AddEdge(info, ((uint64_t)1 << bit) - 1);
+		AddEdge(info, (uint64_t)1 << bit);
+		AddEdge(info, ((uint64_t)1 << bit) + 1);
+	}
+	for (uint8_t base = RADIX_MIN; base <= RADIX_MAX; ++base) {
+		if (info->fit_count[base]) {
+			AddEdge(info, info->fit_count[base] - 1);
+		}
+		AddEdge(info, info->fit_count[base]);
+	}
+}
+
+/** Returns the number of rows of an operator. */
+static uint64_t CountRows(enum Operator op)
+{
+	if (exhaustive) {
+		// a row for each first operand, or rows of first operands
+		return IsUnary(op) ? ((uint64_t)word_mask + ROW_LEN) / ROW_LEN : (uint64_t)word_mask + 1;
+	}
+	// a row for each pair of bit lengths, or bit length, then the edge rows
+	uint64_t const lengths = word_bits + 1;
+	return IsUnary(op) ? lengths + 1 : lengths * lengths + MAX_EDGES;
+}
+
+/** Fills in the pairs of a row, and returns how many there are. */
+static uint32_t FillRow(struct Job const *job, uint64_t row, uint32_t *lhs, uint32_t *rhs)
+{
+	enum Operator const op = ops[job->op];
+	struct FormatInfo const *info = &infos[job->format];
+	uint8_t const lengths = word_bits + 1;
+	// the same pairs whichever thread runs the row
+	uint64_t seed = ((uint64_t)job->format << 56) ^ ((uint64_t)job->op << 48) ^ row;
+	uint32_t n = 0;
+
+	if (exhaustive && IsUnary(op)) {
+		uint64_t const first = row * ROW_LEN;
+		for (; n < ROW_LEN && first + n <= word_mask; ++n) {
+			lhs[n] = first + n;
+			rhs[n] = 0;
+		}
+	} else if (exhaustive) {
+		for (; n <= word_mask; ++n) {
+			lhs[n] = row;
+			rhs[n] = n;
+		}
+	} else if (IsUnary(op) && row < lengths) {
+		for (; n < samples; ++n) {
+			lhs[n] = RandomOfLength(&seed, row);
+			rhs[n] = 0;
+		}
+	} else if (IsUnary(op)) {
+		for (; n < info->edge_count; ++n) {
+			lhs[n] = info->edges[n];
+			rhs[n] = 0;
+		}
+	} else if (row < (uint64_t)lengths * lengths) {
+		for (; n < samples; ++n) {
+			lhs[n] = RandomOfLength(&seed, row / lengths);
+			rhs[n] = RandomOfLength(&seed, row % lengths);
+		}
+	} else if (row - lengths * lengths < info->edge_count) {
+		// an edge against every edge, and against a sample of each bit length both ways
+		uint32_t const edge = info->edges[row - lengths * lengths];
+		for (uint16_t i = 0; i < info->edge_count; ++i, ++n) {
+			lhs[n] = edge;
+			rhs[n] = info->edges[i];
+		}
+		for (uint8_t len = 0; len < lengths; ++len) {
+			for (uint8_t i = 0; i < 8; ++i, n += 2) {
+				lhs[n] = edge;
+				rhs[n] = RandomOfLength(&seed, len);
+				lhs[n + 1] = RandomOfLength(&seed, len);
+				rhs[n + 1] = edge;
+			}
+		}
+	}
+	return n;
+}
+
+/** Divides one bit at a time, as on paper. */
+static uint64_t LongDivide(uint64_t num, uint32_t den)
+{
+	uint64_t quot = 0;
+	uint64_t rem = 0;
+	for (int8_t bit = 63; bit >= 0; --bit) {
+		if (!rem && !(num >> bit)) {
+			continue;
+		}
+		rem = (rem << 1) | ((num >> bit) & 1);
+		if (rem >= den) {
+			rem -= den;
+			quot |= (uint64_t)1 << bit;
+		}
+	}
+	return quot;
+}
+
+/** Counts the set bits by clearing the lowest one at a time. */
+static uint8_t CountSetBits(uint32_t x)
+{
+	uint8_t count = 0;
+	for (; x; x &= x - 1) {
+		++count;
+	}
+	return count;
+}
+
+/** Runs the reference model on a row, setting the untruncated results and divide by 0 errors. */
+static void Reference(enum Operator op, uint8_t frac, uint32_t const *lhs, uint32_t const *rhs, uint32_t n,
+		uint64_t *ref, uint8_t *ref_err)
+{
+	memset(ref_err, 0, n);
+	switch (op) {
+		case Add:
+			for (uint32_t i = 0; i < n; ++i) {
+				ref[i] = (uint64_t)lhs[i] + rhs[i];
+			}
+			break;
+		case Sub:
+			// a borrow wraps beyond the word
+			for (uint32_t i = 0; i < n; ++i) {
+				ref[i] = (uint64_t)lhs[i] - rhs[i];
+			}
+			break;
+		case Mult:
+			for (uint32_t i = 0; i < n; ++i) {
+				ref[i] = ((uint64_t)lhs[i] * rhs[i]) >> frac;
+			}
+			break;
+		case Div:
+			for (uint32_t i = 0; i < n; ++i) {
+				ref_err[i] = !rhs[i];
+				ref[i] = rhs[i] ? LongDivide((uint64_t)lhs[i] << frac, rhs[i]) : 0;
+			}
+			break;
+		case And:
+			for (uint32_t i = 0; i < n; ++i) {
+				ref[i] = lhs[i] & rhs[i];
+			}
+			break;
+		case Or:
+			for (uint32_t i = 0; i < n; ++i) {
+				ref[i] = lhs[i] | rhs[i];
+			}
+			break;
+		case Xor:
+			for (uint32_t i = 0; i < n; ++i) {
+				ref[i] = lhs[i] ^ rhs[i];
+			}
+			break;
+		case Popcount:
+		case Parity:
+			for (uint32_t i = 0; i < n; ++i) {
+				uint8_t const count = CountSetBits(lhs[i]);
+				ref[i] = (op == Parity) ? count & 1 : count;
+			}
+			break;
+		case Clz:
+		case Clo:
+			for (uint32_t i = 0; i < n; ++i) {
+				uint8_t const leading = (op == Clo);
+				uint8_t count = 0;
+				while (count < word_bits && ((lhs[i] >> (word_bits - 1 - count)) & 1) == leading) {
+					++count;
+				}
+				ref[i] = count;
+			}
+			break;
+		case Ctz:
+			for (uint32_t i = 0; i < n; ++i) {
+				uint8_t count = 0;
+				while (count < word_bits && !((lhs[i] >> count) & 1)) {
+					++count;
+				}
+				ref[i] = count;
+			}
+			break;
+		case BitReverse:
+			for (uint32_t i = 0; i < n; ++i) {
+				uint32_t reversed = 0;
+				for (uint8_t bit = 0; bit < word_bits; ++bit) {
+					reversed |= ((lhs[i] >> bit) & 1) << (word_bits - 1 - bit);
+				}
+				ref[i] = reversed;
+			}
+			break;
+		case ByteSwap:
+			for (uint32_t i = 0; i < n; ++i) {
+				uint32_t swapped = 0;
+				for (uint8_t byte = 0; byte < word_bits; byte += 8) {
+					swapped |= ((lhs[i] >> byte) & 0xFF) << (word_bits - 8 - byte);
+				}
+				ref[i] = swapped;
+			}
+			break;
+	}
+}
+
+/** Prints a mismatch, up to a limit. */
+static void Report(struct Job const *job, uint8_t base, uint32_t lhs, uint32_t rhs, char const *what, uint64_t got,
+		uint64_t expected)
+{
+	pthread_mutex_lock(&report_lock);
+	if (reports++ < MAX_REPORTS) {
+		printf("mismatch: %s, %s, base %u, %X and %X: %s is %llX, expected %llX\n", formats[job->format].name,
+				op_names[job->op], base, lhs, rhs, what, (unsigned long long)got, (unsigned long long)expected);
+	}
+	pthread_mutex_unlock(&report_lock);
+}
+
+/** Checks a row of pairs against the reference model. */
+static void RunRow(struct Worker *self, uint64_t global_row)
+{
+	uint8_t j = 0;
+	while (j + 1 < job_count && jobs[j + 1].first_row <= global_row) {
+		++j;
+	}
+	struct Job const *job = &jobs[j];
+	uint64_t const row = global_row - job->first_row;
+	struct Format const *format = &formats[job->format];
+	struct FormatInfo const *info = &infos[job->format];
+	enum Operator const op = ops[job->op];
+	uint8_t const base = RADIX_MIN + row % BASE_COUNT;
+	uint64_t const fit_count = info->fit_count[base];
+
+	Calc_SetFormat(&self->calc, word_bits, format->div_mode, format->fixed_quarters, base);
+	uint32_t const n = FillRow(job, row, self->lhs, self->rhs);
+	Reference(op, info->frac_bits, self->lhs, self->rhs, n, self->ref, self->ref_err);
+
+	uint32_t const *lhs = self->lhs;
+	uint32_t const *rhs = self->rhs;
+	for (uint32_t i = 0; i < n; ++i) {
+		uint8_t is_ovf;
+		uint8_t div_0_err;
+		uint32_t const got = Calc_RunOp(&self->calc, op, lhs[i], rhs[i], &is_ovf, &div_0_err);
+		if (div_0_err != self->ref_err[i]) {
+			Report(job, base, lhs[i], rhs[i], "the divide by 0 error", div_0_err, self->ref_err[i]);
+			++self->mismatches;
+			continue;
+		} else if (div_0_err) {
+			continue;
+		}
+
+		uint64_t const ref = self->ref[i];
+		uint8_t const ref_ovf = ref >= fit_count;
+		if (got != (ref & word_mask)) {
+			Report(job, base, lhs[i], rhs[i], "the result", got, ref & word_mask);
+			++self->mismatches;
+		} else if (is_ovf != ref_ovf) {
+			Report(job, base, lhs[i], rhs[i], "the overflow flag", is_ovf, ref_ovf);
+			++self->mismatches;
+		} else if (op == Div && !info->frac_bits && self->calc.div_rem != lhs[i] - (uint32_t)ref * rhs[i]) {
+			Report(job, base, lhs[i], rhs[i], "the remainder", self->calc.div_rem, lhs[i] - (uint32_t)ref * rhs[i]);
+			++self->mismatches;
+		}
+	}
+	self->pairs += n;
+}
+
+/**
+ * Takes the next rows of a thread's own range, stealing the back half of the largest
+ * range left when its own is empty. Returns 0 once every row is taken.
+ */
+static uint8_t TakeRows(struct Worker *self, uint64_t *first, uint64_t *count)
+{
+	for (;;) {
+		pthread_mutex_lock(&self->lock);
+		if (self->next < self->end) {
+			*first = self->next;
+			*count = (self->end - self->next < CHUNK_ROWS) ? self->end - self->next : CHUNK_ROWS;
+			self->next += *count;
+			pthread_mutex_unlock(&self->lock);
+			return 1;
+		}
+		pthread_mutex_unlock(&self->lock);
+
+		// the sizes may change before the victim is locked again, so check again then
+		struct Worker *victim = NULL;
+		uint64_t most = 0;
+		for (uint16_t i = 0; i < worker_count; ++i) {
+			if (&workers[i] == self) {
+				continue;
+			}
+			pthread_mutex_lock(&workers[i].lock);
+			uint64_t const left = workers[i].end - workers[i].next;
+			pthread_mutex_unlock(&workers[i].lock);
+			if (left > most) {
+				most = left;
+				victim = &workers[i];
+			}
+		}
+		if (!victim) {
+			return 0;
+		}
+
+		pthread_mutex_lock(&victim->lock);
+		uint64_t const left = victim->end - victim->next;
+		if (left == 0) {
+			pthread_mutex_unlock(&victim->lock);
+			continue;
+		}
+		uint64_t const end = victim->end;
+		victim->end -= left / 2;
+		uint64_t const start = (left / 2) ? victim->end : victim->next++;
+		pthread_mutex_unlock(&victim->lock);
+
+		pthread_mutex_lock(&self->lock);
+		self->next = start;
+		self->end = (left / 2) ? end : start + 1;
+		pthread_mutex_unlock(&self->lock);
+		++self->steals;
+	}
+}
+
+/** Returns the current time in seconds. */
+static double Now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/** Runs a thread's rows, and then rows stolen from the others. */
+static void *RunWorker(void *arg)
+{
+	struct Worker *self = arg;
+	struct CalcDelta delta;
+	Calc_Init(&self->calc, &delta);
+
+	uint64_t first;
+	uint64_t count;
+	while (TakeRows(self, &first, &count)) {
+		for (uint64_t row = first; row < first + count; ++row) {
+			RunRow(self, row);
+		}
+		atomic_fetch_add(&rows_done, count);
+	}
+
+	struct timespec cpu;
+	clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu);
+	self->cpu_s = cpu.tv_sec + cpu.tv_nsec * 1e-9;
+	self->done_s = Now();
+	return NULL;
+}
+
+int main(int argc, char **argv)
+{
+	word_bits = (argc > 1) ? atoi(argv[1]) : 16;
+	long const cores = sysconf(_SC_NPROCESSORS_ONLN);
+	worker_count = (argc > 2) ? atoi(argv[2]) : (cores > 0 ? cores : 1);
+	samples = (argc > 3) ? atoi(argv[3]) : SAMPLES;
+	if (word_bits != 8 && word_bits != 16 && word_bits != 32) {
+		printf("the word size must be 8, 16, or 32 bits\n");
+		return 1;
+	} else if (worker_count < 1 || worker_count > MAX_THREADS) {
+		printf("the threads must be from 1 to %d\n", MAX_THREADS);
+		return 1;
+	} else if (samples < 1 || samples > ROW_LEN) {
+		printf("the samples must be from 1 to %d\n", ROW_LEN);
+		return 1;
+	}
+	word_mask = 0xFFFFFFFF >> (32 - word_bits);
+	exhaustive = (word_bits <= EXHAUSTIVE_BITS);
+
+	for (uint8_t f = 0; f < FORMAT_COUNT; ++f) {
+		SetUpFormat(&formats[f], &infos[f]);
+		for (uint8_t o = 0; o < OP_COUNT; ++o) {
+			struct Job *job = &jobs[job_count++];
+			job->format = f;
+			job->op = o;
+			job->first_row = total_rows;
+			job->rows = CountRows(ops[o]);
+			total_rows += job->rows;
+		}
+	}
+	printf("%u-bit words, %s, %u formats x %u operators, %u threads\n", word_bits,
+			exhaustive ? "every pair" : "sampled pairs", (unsigned)FORMAT_COUNT, (unsigned)OP_COUNT, worker_count);
+
+	// each thread starts with an even share of the rows
+	double const start = Now();
+	for (uint16_t i = 0; i < worker_count; ++i) {
+		struct Worker *worker = &workers[i];
+		pthread_mutex_init(&worker->lock, NULL);
+		worker->next = total_rows * i / worker_count;
+		worker->end = total_rows * (i + 1) / worker_count;
+		worker->lhs = malloc(ROW_LEN * sizeof(*worker->lhs));
+		worker->rhs = malloc(ROW_LEN * sizeof(*worker->rhs));
+		worker->ref = malloc(ROW_LEN * sizeof(*worker->ref));
+		worker->ref_err = malloc(ROW_LEN);
+		if (!worker->lhs || !worker->rhs || !worker->ref || !worker->ref_err) {
+			printf("out of memory\n");
+			return 1;
+		}
+	}
+	for (uint16_t i = 0; i < worker_count; ++i) {
+		pthread_create(&workers[i].thread, NULL, RunWorker, &workers[i]);
+	}
+
+	double last_report = start;
+	uint64_t done;
+	while ((done = atomic_load(&rows_done)) < total_rows) {
+		double const now = Now();
+		if (now - last_report >= PROGRESS_S) {
+			printf("%.0f%% after %.0f s\n", 100.0 * done / total_rows, now - start);
+			fflush(stdout);
+			last_report = now;
+		}
+		usleep(100000);
+	}
+	uint64_t pairs = 0;
+	uint64_t mismatches = 0;
+	uint32_t steals = 0;
+	double wall_s = 0;
+	for (uint16_t i = 0; i < worker_count; ++i) {
+		pthread_join(workers[i].thread, NULL);
+		pairs += workers[i].pairs;
+		mismatches += workers[i].mismatches;
+		steals += workers[i].steals;
+		// the last thread to finish ends the run
+		if (workers[i].done_s - start > wall_s) {
+			wall_s = workers[i].done_s - start;
+		}
+	}
+
+	printf("%llu pairs in %.1f s: %.3g pairs/s, %.3g pairs/s per core, %u steals\n", (unsigned long long)pairs, wall_s,
+			pairs / wall_s, pairs / wall_s / worker_count, steals);
+	for (uint16_t i = 0; i < worker_count; ++i) {
+		struct Worker const *worker = &workers[i];
+		printf("  thread %u: %llu pairs in %.1f s of CPU time, %.3g pairs/s\n", i, (unsigned long long)worker->pairs,
+				worker->cpu_s, worker->pairs / (worker->cpu_s > 0 ? worker->cpu_s : 1));
+	}
+	if (mismatches) {
+		printf("%llu mismatches\n", (unsigned long long)mismatches);
+		return 1;
+	}
+	printf("every pair matches\n");
+	return 0;
+}